@@ -63,4 +63,23 @@ void merge_sort(void *base, size_t nitems, size_t size, int (*compar)(const void
  */
 void quick_sort(void *base, size_t nitems, size_t size, int (*compar)(const void*, const void*));
 
+/**
+ * @brief Sorts an array using an adaptive (natural) merge sort.
+ *
+ * The array is first split into its maximal non-descending runs (strictly descending
+ * runs are reversed in place), then adjacent runs are merged pairwise until a single
+ * run is left. Two runs already in order are not merged. The sort is stable and takes
+ * linear time on sorted or reverse-sorted input, O(n log r) on input made of r runs.
+ *
+ * @param base Pointer to the array to be sorted.
+ * @param nitems Number of elements in the array.
+ * @param size Size of each element in the array.
+ * @param compar Comparison function that determines the order of the elements.
+ *               It should return a negative value if the first element is less
+ *               than the second, zero if they are equal, and a positive value
+ *               if the first element is greater than the second.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+void natural_merge_sort(void *base, size_t nitems, size_t size, int (*compar)(const void*, const void*));
+
 #endif // _ALGO_H
\ No newline at end of file
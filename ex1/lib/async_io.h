@@ -0,0 +1,115 @@
+/**
+ * @file async_io.h
+ * @brief Interface for sequential file I/O with several large requests in flight.
+ *
+ * On Linux the reader and the writer are backed by io_uring, driven through raw system
+ * calls: the reader keeps up to `queue_depth` reads of `block_size` bytes queued ahead
+ * of the parser, the writer lets up to `queue_depth` blocks be written while the next
+ * ones are being filled. When io_uring is not available (other systems, old kernels,
+ * sandboxes forbidding it) both fall back to blocking stdio on the same interface.
+ */
+
+#ifndef _ASYNC_IO_H
+#define _ASYNC_IO_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+
+#define ASYNC_IO_BLOCK_SIZE (1024 * 1024) // 1 MB
+#define ASYNC_IO_QUEUE_DEPTH 8
+
+/**
+ * @brief I/O backend actually used by an AsyncReader or an AsyncWriter.
+ */
+typedef enum _AsyncIoBackend {
+    ASYNC_IO_STDIO,
+    ASYNC_IO_URING
+
+} AsyncIoBackend;
+
+typedef struct _AsyncReader AsyncReader;
+typedef struct _AsyncWriter AsyncWriter;
+
+/**
+ * @brief Opens a file for sequential reading.
+ *
+ * @param path Path to the file to read.
+ * @param use_uring Non-zero to try the io_uring backend before falling back to stdio. Files
+ *        that are not regular files, such as pipes, are always read through stdio.
+ * @param block_size Size of each read request.
+ * @param queue_depth Maximum number of read requests in flight.
+ * @return Pointer to the reader, or NULL if the file cannot be opened.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+AsyncReader* async_reader_open(const char* path, int use_uring, size_t block_size, unsigned queue_depth);
+
+/**
+ * @brief Returns the backend used by a reader.
+ *
+ * @param reader Pointer to the reader.
+ * @return `ASYNC_IO_URING` or `ASYNC_IO_STDIO`.
+ */
+AsyncIoBackend async_reader_backend(const AsyncReader* reader);
+
+/**
+ * @brief Reads the next line of the file, with the semantics of `fgets`.
+ *
+ * At most `size - 1` characters are copied into `line`, stopping after the first newline,
+ * and the line is null-terminated.
+ *
+ * @param line Buffer receiving the line.
+ * @param size Size of the buffer.
+ * @param reader Pointer to the reader.
+ * @return `line`, or NULL at the end of the file or on a read error.
+ */
+char* async_reader_gets(char* line, int size, AsyncReader* reader);
+
+/**
+ * @brief Closes a reader, after waiting for the reads still in flight.
+ *
+ * @param reader Pointer to the reader.
+ */
+void async_reader_close(AsyncReader* reader);
+
+/**
+ * @brief Creates (or truncates) a file for sequential writing.
+ *
+ * @param path Path to the file to write.
+ * @param use_uring Non-zero to try the io_uring backend before falling back to stdio.
+ * @param block_size Size of each write request.
+ * @param queue_depth Maximum number of write requests in flight.
+ * @return Pointer to the writer, or NULL if the file cannot be created.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+AsyncWriter* async_writer_open(const char* path, int use_uring, size_t block_size, unsigned queue_depth);
+
+/**
+ * @brief Returns the backend used by a writer.
+ *
+ * @param writer Pointer to the writer.
+ * @return `ASYNC_IO_URING` or `ASYNC_IO_STDIO`.
+ */
+AsyncIoBackend async_writer_backend(const AsyncWriter* writer);
+
+/**
+ * @brief Appends data to the file.
+ *
+ * The data is copied into the current block, which is submitted as soon as it is full.
+ *
+ * @param writer Pointer to the writer.
+ * @param data Data to write.
+ * @param length Number of bytes to write.
+ * @return `length` on success, 0 if a previous or the current write failed.
+ */
+size_t async_writer_write(AsyncWriter* writer, const void* data, size_t length);
+
+/**
+ * @brief Flushes the pending data, waits for the writes in flight and closes the writer.
+ *
+ * @param writer Pointer to the writer.
+ * @return 0 if every write succeeded, -1 otherwise.
+ */
+int async_writer_close(AsyncWriter* writer);
+
+#endif // _ASYNC_IO_H
@@ -0,0 +1,104 @@
+/**
+ * @file auto_sort.h
+ * @brief Interface for choosing the sorting algorithm of a RecordBatch from a sample of its keys.
+ *
+ * A sample of evenly spaced keys is taken from the key column, in batch order. Its
+ * descent ratio (the fraction of consecutive pairs out of order) estimates how presorted
+ * the column is, and its duplicate ratio (the fraction of keys equal to another sampled
+ * key) how many repeated values it holds. The strategy is then:
+ * - nearly sorted or nearly reverse-sorted columns: natural merge sort, linear on few runs;
+ * - numeric columns (field2, field3): LSD radix sort on the key bits;
+ * - strings with many duplicates: three-way quick sort;
+ * - other strings: merge sort.
+ */
+
+#ifndef _AUTO_SORT_H
+#define _AUTO_SORT_H
+
+#include "csv.h"
+#include <stdlib.h>
+
+
+#define AUTO_SORT_SAMPLE_SIZE 1024
+#define AUTO_SORT_PRESORTED_RATIO 0.05 // descent ratio under which (or over 1 minus which) the column is presorted
+#define AUTO_SORT_DUPLICATE_RATIO 0.25 // duplicate ratio from which three-way partitioning pays off
+
+/**
+ * @brief Sorting strategies available to `auto_sort_record_batch`.
+ */
+typedef enum _SortStrategy {
+    SORT_STRATEGY_MERGE,
+    SORT_STRATEGY_QUICK,
+    SORT_STRATEGY_NATURAL_MERGE,
+    SORT_STRATEGY_RADIX
+
+} SortStrategy;
+
+/**
+ * @brief Statistics estimated on a sample of a key column.
+ */
+typedef struct _KeyProfile {
+    size_t n_sampled;       ///< Number of sampled keys.
+    double descent_ratio;   ///< Fraction of consecutive sampled keys in descending order.
+    double duplicate_ratio; ///< Fraction of sampled keys equal to the previous one once sorted.
+
+} KeyProfile;
+
+/**
+ * @brief Estimates the presortedness and the duplicate ratio of a key column.
+ *
+ * @param batch Pointer to the batch to profile.
+ * @param field Field of the key column (1 for field1, 2 for field2, 3 for field3).
+ * @param profile Pointer to the profile to fill.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+void profile_record_batch(const RecordBatch* batch, size_t field, KeyProfile* profile);
+
+/**
+ * @brief Chooses a sorting strategy for a key column from its profile.
+ *
+ * @param field Field of the key column (1 for field1, 2 for field2, 3 for field3).
+ * @param profile Pointer to the profile of the column.
+ * @return The chosen strategy.
+ */
+SortStrategy choose_sort_strategy(size_t field, const KeyProfile* profile);
+
+/**
+ * @brief Returns the name of a sorting strategy.
+ *
+ * @param strategy The strategy.
+ * @return A static string (e.g. "radix_sort").
+ */
+const char* sort_strategy_name(SortStrategy strategy);
+
+/**
+ * @brief Computes the sorted order of the records of a RecordBatch with an LSD radix sort.
+ *
+ * The keys are mapped to unsigned integers preserving their order (the sign bit of
+ * field2 is flipped; field3 is mapped from its IEEE 754 bits, with -0.0 taken as 0.0)
+ * and sorted one byte at a time, skipping the bytes shared by every key. The sort is
+ * stable, so the permutation is the same as the one of `sort_record_batch` with
+ * `merge_sort`.
+ *
+ * @param batch Pointer to the batch to sort.
+ * @param field Numeric field to be used as the key for sorting (2 for field2, 3 for field3).
+ * @return Heap-allocated permutation of `batch -> n_records` indices, in sorted order,
+ *         to be freed by the caller, or NULL if `field` is not numeric.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+size_t* radix_sort_record_batch(const RecordBatch* batch, size_t field);
+
+/**
+ * @brief Computes the sorted order of the records of a RecordBatch with the strategy fitting its keys.
+ *
+ * @param batch Pointer to the batch to sort.
+ * @param field Field to be used as the key for sorting (1 for field1, 2 for field2, 3 for field3).
+ * @param profile Pointer receiving the profile of the key column, or NULL.
+ * @param strategy Pointer receiving the chosen strategy, or NULL.
+ * @return Heap-allocated permutation of `batch -> n_records` indices, in sorted order,
+ *         to be freed by the caller.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+size_t* auto_sort_record_batch(const RecordBatch* batch, size_t field, KeyProfile* profile, SortStrategy* strategy);
+
+#endif // _AUTO_SORT_H
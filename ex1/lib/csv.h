@@ -6,6 +6,7 @@
 #ifndef _CSV_H
 #define _CSV_H
 
+#include "async_io.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -13,6 +14,36 @@
 #define MAX_LINE_SIZE 256
 #define MAX_FIELD1_SIZE 240
 
+/**
+ * Lines are read whole before being parsed: a record can be longer than MAX_LINE_SIZE
+ * when field1 uses all of its MAX_FIELD1_SIZE - 1 characters, so leave room for it.
+ */
+#define RECORD_LINE_BUFFER_SIZE (2 * MAX_LINE_SIZE)
+
+#define FIELD1_INLINE_CAPACITY 15
+#define FIELD1_HEAP_TAG 1
+
+/**
+ * @brief Small-string-optimized storage for the field1 string.
+ *
+ * Strings of at most `FIELD1_INLINE_CAPACITY` characters are stored inline,
+ * zero-padded up to the last byte, which is then always `'\0'`. Longer strings
+ * are spilled to the heap: the pointer is stored in `heap.data` and the last
+ * byte is set to `FIELD1_HEAP_TAG` to tell the two representations apart.
+ *
+ * Because inline strings are zero-padded, two inline values are ordered by a
+ * plain `memcmp` of their bytes, without following any pointer.
+ */
+typedef union _Field1 {
+    char inline_data[FIELD1_INLINE_CAPACITY + 1];
+    struct {
+        char* data;
+        char reserved[FIELD1_INLINE_CAPACITY - sizeof(char*)];
+        char tag;
+    } heap;
+
+} Field1;
+
 /**
  * @brief Structure representing a record with four fields.
  * 
@@ -29,7 +60,7 @@
  */
 typedef struct _Record {
     int id;
-    char* field1;
+    Field1 field1;
     int field2;
     double field3;
 
@@ -37,6 +68,74 @@ typedef struct _Record {
 
 #define N_FIELDS_IN_RECORD 4
 
+/**
+ * @brief Columnar (struct-of-arrays) representation of a set of records.
+ *
+ * Every field of the records is stored in its own contiguous array, so that the
+ * i-th record is made of `id[i]`, `field1[i]`, `field2[i]` and `field3[i]`.
+ * Sorting a batch only touches the key column: the records themselves are never
+ * moved, a permutation of their indices is sorted instead and the columns are
+ * gathered in that order only when the batch is written out.
+ */
+typedef struct _RecordBatch {
+    size_t n_records;
+    size_t capacity;
+    int* id;
+    Field1* field1;
+    int* field2;
+    double* field3;
+
+} RecordBatch, *RecordBatchPtr;
+
+/**
+ * @brief Sort key on field1 paired with the index of its record in a RecordBatch.
+ *
+ * The key is a shallow copy of the Field1 value: short strings travel with the key,
+ * long ones still point to the string owned by the batch.
+ */
+typedef struct _Field1Key {
+    Field1 key;
+    size_t index;
+
+} Field1Key;
+
+/**
+ * @brief Sort key on field2 paired with the index of its record in a RecordBatch.
+ */
+typedef struct _Field2Key {
+    int key;
+    size_t index;
+
+} Field2Key;
+
+/**
+ * @brief Sort key on field3 paired with the index of its record in a RecordBatch.
+ */
+typedef struct _Field3Key {
+    double key;
+    size_t index;
+
+} Field3Key;
+
+/**
+ * @brief Predicates applied to the records while they are parsed.
+ *
+ * A record is kept only if it satisfies every enabled predicate. The predicates are
+ * evaluated on the raw line, before field1 is copied and before the fields that are
+ * not needed to reject the line are converted. A zero-initialized RecordFilter
+ * accepts every record.
+ */
+typedef struct _RecordFilter {
+    const char* field1_prefix; ///< Required prefix of field1, or NULL.
+    int has_field2_range;      ///< Non-zero if field2 must lie in [field2_min, field2_max].
+    int field2_min;
+    int field2_max;
+    int has_field3_range;      ///< Non-zero if field3 must lie in [field3_min, field3_max].
+    double field3_min;
+    double field3_max;
+
+} RecordFilter;
+
 /**
  * @brief Format string for reading a record from a CSV file.
  * 
@@ -56,6 +155,44 @@ extern const char* recordWriteFmt;
 #define READING_BUFFER_SIZE (64 * 1024) // 64 KB
 #define WRITING_BUFFER_SIZE (64 * 1024) // 64 KB
 
+#define PARALLEL_WRITE_CHUNK_SIZE (64 * 1024) // records formatted by a worker at a time
+
+/**
+ * @brief Stores a string into a Field1, inline or on the heap depending on its length.
+ *
+ * @param field1 Pointer to the Field1 to fill.
+ * @param str The string to store.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+void field1_set(Field1* field1, const char* str);
+
+/**
+ * @brief Returns the string stored in a Field1.
+ *
+ * @param field1 Pointer to the Field1.
+ * @return Pointer to the null-terminated string.
+ */
+const char* field1_str(const Field1* field1);
+
+/**
+ * @brief Frees the heap storage of a Field1, if any.
+ *
+ * @param field1 Pointer to the Field1.
+ */
+void field1_free(Field1* field1);
+
+/**
+ * @brief Compares the strings stored in two Field1 values.
+ *
+ * When both strings are stored inline they are compared with `memcmp` on the
+ * inline bytes, otherwise the comparison falls back to `strcmp`.
+ *
+ * @param a Pointer to the first Field1.
+ * @param b Pointer to the second Field1.
+ * @return A negative value, zero or a positive value as `strcmp` does.
+ */
+int field1_compare(const Field1* a, const Field1* b);
+
 /**
  * @brief Compares two records based on the field1 field.
  *
@@ -101,6 +238,16 @@ int compare_field2(const void* a, const void* b);
  */
 int compare_field3(const void* a, const void* b);
 
+/**
+ * @brief Compares two records based on the id field.
+ *
+ * @param a Pointer to the first record.
+ * @param b Pointer to the second record.
+ * @return A negative value if the first record is less than the second, zero if they are equal,
+ *         and a positive value if the first record is greater than the second.
+ */
+int compare_id(const void* a, const void* b);
+
 
 /**
  * @brief Counts the number of lines in a file.
@@ -110,6 +257,44 @@ int compare_field3(const void* a, const void* b);
  */
 size_t count_lines(FILE* file);
 
+/**
+ * @brief Converts the decimal integer starting at a given position.
+ *
+ * Unlike a bare `strtol`, the values out of the range of an int are rejected instead of
+ * being truncated.
+ *
+ * @param start The first character of the integer, leading whitespace allowed.
+ * @param end Pointer where the position following the integer is stored.
+ * @param value Pointer where the integer is stored, only on success.
+ * @return 0 on success, -1 if no digits were found or the value does not fit in an int.
+ */
+int parse_int(const char* start, char** end, int* value);
+
+/**
+ * @brief Parses a CSV line into the fields of a record, evaluating the filter while parsing.
+ *
+ * The predicates are checked in order of cost: the field1 prefix is matched on the raw
+ * bytes of the line, then field2 and field3 are converted only if the line is still a
+ * candidate. The id is converted last, only for matching lines. The line is modified in
+ * place: field1 is terminated at its delimiter and returned as a pointer into the line.
+ *
+ * @param line The line to parse, including its trailing newline.
+ * @param filter The predicates the record must satisfy, or NULL to accept every record.
+ * @param id Pointer where the id of the record is stored.
+ * @param field1 Pointer where the start of field1 within the line is stored.
+ * @param field2 Pointer where field2 is stored.
+ * @param field3 Pointer where field3 is stored.
+ * @return 1 if the record matches the filter, 0 if it was skipped, -1 if the line is malformed.
+ */
+int parse_record_line(
+    char* line,
+    const RecordFilter* filter,
+    int* id,
+    char** field1,
+    int* field2,
+    double* field3
+);
+
 /**
  * @brief Reads records from a file and stores them in an array of RecordPtr.
  *
@@ -124,13 +309,17 @@ size_t count_lines(FILE* file);
  * 
  * - The CSV file must have a trailing newline at the end.
  *
+ * Lines that do not satisfy `filter` are skipped without allocating their field1,
+ * and do not count towards `n_records`. Reading stops at the first malformed line.
+ *
  * @param infile A pointer to the input file from which records are to be read.
  * @param records A pointer to an array of RecordPtr where the read records will be stored.
  * @param n_records The number of records to read from the file.
+ * @param filter The predicates the records must satisfy, or NULL to read every record.
  * @return The number of records successfully read from the file.
  * @throw `EXIT_FAILURE` if an error occurs while reading the records.
  */
-size_t read_records(FILE* infile, RecordPtr records, size_t n_records);
+size_t read_records(FILE* infile, RecordPtr records, size_t n_records, const RecordFilter* filter);
 
 /**
  * @brief Writes records to a file.
@@ -145,4 +334,156 @@ size_t read_records(FILE* infile, RecordPtr records, size_t n_records);
  */
 size_t write_records(FILE* outfile, RecordPtr records, size_t n_records);
 
+/**
+ * @brief Compares two Field1Key entries by their key.
+ *
+ * @param a Pointer to the first Field1Key.
+ * @param b Pointer to the second Field1Key.
+ * @return A negative value if the first key is less than the second, zero if they are equal,
+ *         and a positive value if the first key is greater than the second.
+ */
+int compare_field1_key(const void* a, const void* b);
+
+/**
+ * @brief Compares two Field2Key entries by their key.
+ *
+ * @param a Pointer to the first Field2Key.
+ * @param b Pointer to the second Field2Key.
+ * @return A negative value if the first key is less than the second, zero if they are equal,
+ *         and a positive value if the first key is greater than the second.
+ */
+int compare_field2_key(const void* a, const void* b);
+
+/**
+ * @brief Compares two Field3Key entries by their key.
+ *
+ * @param a Pointer to the first Field3Key.
+ * @param b Pointer to the second Field3Key.
+ * @return A negative value if the first key is less than the second, zero if they are equal,
+ *         and a positive value if the first key is greater than the second.
+ */
+int compare_field3_key(const void* a, const void* b);
+
+/**
+ * @brief Allocates the columns of a RecordBatch.
+ *
+ * @param batch Pointer to the batch to initialize.
+ * @param capacity Number of records the batch must be able to hold.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+void record_batch_init(RecordBatchPtr batch, size_t capacity);
+
+/**
+ * @brief Frees the columns of a RecordBatch and the field1 strings it owns.
+ *
+ * @param batch Pointer to the batch to free.
+ */
+void record_batch_free(RecordBatchPtr batch);
+
+/**
+ * @brief Reads records from a file into the columns of a RecordBatch.
+ *
+ * Same assumptions and filtering of `read_records`. The records are appended to the
+ * batch, whose columns are grown when its capacity is exhausted, so that a filtered
+ * read only holds the matching records.
+ *
+ * @param infile A pointer to the input file from which records are to be read.
+ * @param batch Pointer to an initialized RecordBatch.
+ * @param n_records The maximum number of records to read from the file.
+ * @param filter The predicates the records must satisfy, or NULL to read every record.
+ * @return The number of records successfully read from the file.
+ * @throw `EXIT_FAILURE` if an error occurs while reading the records.
+ */
+size_t read_record_batch(FILE* infile, RecordBatchPtr batch, size_t n_records, const RecordFilter* filter);
+
+/**
+ * @brief Same as `read_record_batch`, reading the lines from an AsyncReader.
+ *
+ * @param reader Pointer to the reader.
+ * @param batch Pointer to the batch receiving the records.
+ * @param n_records Maximum number of records to read.
+ * @param filter The predicates the records must satisfy, or NULL to read every record.
+ * @return The number of records successfully read from the file.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+size_t read_record_batch_async(AsyncReader* reader, RecordBatchPtr batch, size_t n_records, const RecordFilter* filter);
+
+/**
+ * @brief Computes the sorted order of the records of a RecordBatch.
+ *
+ * Only the key column of `field` is copied, paired with the record indices, and
+ * sorted with the given sorting algorithm. The batch itself is left untouched.
+ *
+ * @param batch Pointer to the batch to sort.
+ * @param field Field to be used as the key for sorting (1 for field1, 2 for field2, 3 for field3).
+ * @param sort Sorting algorithm to use (e.g. `merge_sort` or `quick_sort`).
+ * @return Heap-allocated permutation of `batch -> n_records` indices, in sorted order,
+ *         to be freed by the caller.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+size_t* sort_record_batch(
+    const RecordBatch* batch,
+    size_t field,
+    void (*sort)(void*, size_t, size_t, int (*)(const void*, const void*))
+);
+
+/**
+ * @brief Writes the records of a RecordBatch to a file.
+ *
+ * The columns are gathered one record at a time following `permutation`, so the
+ * output is the same as writing the equivalent array of Record in that order.
+ *
+ * @param outfile Pointer to the output file.
+ * @param batch Pointer to the batch to write.
+ * @param permutation Order in which the records are written, or NULL for the batch order.
+ * @param n_records Number of records to write.
+ * @return The number of records successfully written to the file.
+ */
+size_t write_record_batch(FILE* outfile, const RecordBatch* batch, const size_t* permutation, size_t n_records);
+
+/**
+ * @brief Writes the records of a RecordBatch to a file, formatting them on several threads.
+ *
+ * The records are split into consecutive chunks of at most `PARALLEL_WRITE_CHUNK_SIZE`
+ * records. Each worker thread formats its chunk into a private buffer, then the calling
+ * thread writes the buffers sequentially in chunk order, so the output is byte-identical
+ * to the one of `write_record_batch`.
+ *
+ * @param outfile Pointer to the output file.
+ * @param batch Pointer to the batch to write.
+ * @param permutation Order in which the records are written, or NULL for the batch order.
+ * @param n_records Number of records to write.
+ * @param n_threads Number of worker threads (1 falls back to `write_record_batch`).
+ * @return The number of records successfully written to the file.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation or thread creation.
+ */
+size_t write_record_batch_parallel(
+    FILE* outfile,
+    const RecordBatch* batch,
+    const size_t* permutation,
+    size_t n_records,
+    size_t n_threads
+);
+
+/**
+ * @brief Same as `write_record_batch_parallel`, writing the chunks to an AsyncWriter.
+ *
+ * With a single thread the chunks are formatted by the calling thread.
+ *
+ * @param writer Pointer to the writer.
+ * @param batch Pointer to the batch to write.
+ * @param permutation Order in which the records are written, or NULL for the batch order.
+ * @param n_records Number of records to write.
+ * @param n_threads Number of formatting threads.
+ * @return The number of records successfully handed to the writer.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation or thread creation.
+ */
+size_t write_record_batch_async(
+    AsyncWriter* writer,
+    const RecordBatch* batch,
+    const size_t* permutation,
+    size_t n_records,
+    size_t n_threads
+);
+
 #endif // _CSV_H
\ No newline at end of file
@@ -0,0 +1,60 @@
+/**
+ * @file group_by.h
+ * @brief Interface for the sort-based group-by aggregation of records.
+ *
+ * Records sorted by a field are aggregated in a single streaming pass: consecutive
+ * records sharing the same key form a group, which is written as one line as soon as
+ * the next key starts. Each output line has the form
+ * `<key>,<count>,<field2 sum>,<field2 average>,<field3 sum>,<field3 average>`.
+ *
+ * The input can be a sorted RecordBatch (through the permutation returned by one of
+ * the sort functions) or a CSV file already sorted by the key, which is read line by
+ * line without being loaded in memory.
+ */
+
+#ifndef _GROUP_BY_H
+#define _GROUP_BY_H
+
+#include "csv.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+
+/**
+ * @brief Running aggregates of the current group.
+ */
+typedef struct _GroupAggregate {
+    size_t count;
+    long long field2_sum;
+    double field3_sum;
+
+} GroupAggregate;
+
+/**
+ * @brief Writes the aggregates of every group of a sorted RecordBatch.
+ *
+ * @param outfile Pointer to the output file.
+ * @param batch Pointer to the batch.
+ * @param permutation Sorted order of the records, as returned by `sort_record_batch`.
+ * @param field Field the records are grouped by (1 for field1, 2 for field2, 3 for field3).
+ * @return The number of groups written.
+ */
+size_t write_record_groups(FILE* outfile, const RecordBatch* batch, const size_t* permutation, size_t field);
+
+/**
+ * @brief Writes the aggregates of every group of a CSV file sorted by the grouping field.
+ *
+ * The file is read one line at a time, so its size is not limited by memory. Each key is
+ * compared with the previous one: reading stops at the first malformed line or key smaller
+ * than the previous one, which would otherwise split a group, and the file is rejected:
+ * only the groups completed before that line are written.
+ *
+ * @param sorted_csv The CSV file, sorted by `field`.
+ * @param outfile Pointer to the output file.
+ * @param field Field the records are grouped by (1 for field1, 2 for field2, 3 for field3).
+ * @param n_groups Pointer where the number of groups written is stored.
+ * @return 1 if the whole file was grouped, 0 if a line is malformed or out of order.
+ */
+int group_sorted_records(FILE* sorted_csv, FILE* outfile, size_t field, size_t* n_groups);
+
+#endif // _GROUP_BY_H
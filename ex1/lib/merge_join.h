@@ -0,0 +1,68 @@
+/**
+ * @file merge_join.h
+ * @brief Interface for the streaming merge-join of two CSV files sorted by the same key.
+ *
+ * Both files are read sequentially, one line at a time. Only the records of the right
+ * file sharing the current key are buffered, so the memory used is bounded by the largest
+ * group of duplicate keys of the right file, whatever the size of the files.
+ *
+ * Every output line is the concatenation of a left record and a right record:
+ * `<left id>,<left field1>,<left field2>,<left field3>,<right id>,<right field1>,<right field2>,<right field3>`.
+ * In a left join, a left record without match is followed by four empty fields.
+ */
+
+#ifndef _MERGE_JOIN_H
+#define _MERGE_JOIN_H
+
+#include "csv.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+
+/**
+ * @brief Kinds of join supported by `merge_join`.
+ */
+typedef enum _JoinType {
+    JOIN_INNER, ///< Only the pairs of records with equal keys.
+    JOIN_LEFT   ///< Also the left records without match, once each.
+
+} JoinType;
+
+/**
+ * @brief Counters of a merge-join.
+ */
+typedef struct _JoinStats {
+    size_t n_left;      ///< Records read from the left file.
+    size_t n_right;     ///< Records read from the right file.
+    size_t n_rows;      ///< Lines written.
+    size_t max_group;   ///< Largest group of right records buffered at once.
+
+} JoinStats;
+
+/**
+ * @brief Returns the comparison function of a join key.
+ *
+ * @param key Join key (0 for id, 1 for field1, 2 for field2, 3 for field3).
+ * @return One of `compare_id`, `compare_field1`, `compare_field2`, `compare_field3`, or NULL
+ *         if the key is invalid.
+ */
+int (*join_key_compare(size_t key))(const void*, const void*);
+
+/**
+ * @brief Joins two CSV files sorted by the same key.
+ *
+ * Reading a file stops at its first malformed line. A file found not to be sorted by
+ * the key stops the join. The right file is read only as far as the left keys require.
+ *
+ * @param left The left CSV file, sorted by `key`.
+ * @param right The right CSV file, sorted by `key`.
+ * @param outfile Pointer to the output file.
+ * @param key Join key (0 for id, 1 for field1, 2 for field2, 3 for field3).
+ * @param type Kind of join.
+ * @param stats Pointer receiving the counters of the join, or NULL.
+ * @return 1 if the join completed, 0 if the key is invalid or a file is not sorted by it.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+int merge_join(FILE* left, FILE* right, FILE* outfile, size_t key, JoinType type, JoinStats* stats);
+
+#endif // _MERGE_JOIN_H
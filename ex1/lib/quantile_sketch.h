@@ -0,0 +1,106 @@
+/**
+ * @file quantile_sketch.h
+ * @brief Interface for KLL quantile sketches of the numeric fields of a CSV file.
+ *
+ * A KLL sketch summarizes a stream of values in O(k log(n / k)) memory. Values are
+ * appended to level 0; when the sketch exceeds its capacity, the lowest full level is
+ * sorted and compacted: every other value, starting at a random offset, is promoted to
+ * the next level, where it stands for twice as many values. With k = 200 the rank of
+ * a reported quantile is within about 1% of n of the requested one.
+ *
+ * Sketches are mergeable, so a file is sketched by several threads, each reading its
+ * own byte range, and the per-thread sketches are merged at the end.
+ */
+
+#ifndef _QUANTILE_SKETCH_H
+#define _QUANTILE_SKETCH_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+#define KLL_DEFAULT_K 200
+#define KLL_MIN_LEVEL_CAPACITY 8
+
+/**
+ * @brief KLL sketch of a stream of doubles.
+ */
+typedef struct _KllSketch {
+    size_t k;            ///< Capacity of the top level; larger means more accurate.
+    uint64_t n;          ///< Number of values seen.
+    size_t n_levels;
+    double** levels;     ///< levels[h] holds values of weight 2^h.
+    size_t* sizes;
+    size_t* capacities;  ///< Allocated size of each level buffer.
+    size_t n_retained;   ///< Total number of values held by the levels.
+    size_t capacity;     ///< Sum of the capacities of the levels, above which the sketch is compacted.
+    double min;
+    double max;
+    uint64_t random_state;
+
+} KllSketch, *KllSketchPtr;
+
+/**
+ * @brief Initializes an empty sketch.
+ *
+ * @param sketch Pointer to the sketch.
+ * @param k Accuracy parameter (at least `KLL_MIN_LEVEL_CAPACITY`).
+ * @param seed Seed of the random offsets of the compactions.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+void kll_init(KllSketchPtr sketch, size_t k, uint64_t seed);
+
+/**
+ * @brief Frees the memory held by a sketch.
+ *
+ * @param sketch Pointer to the sketch.
+ */
+void kll_free(KllSketchPtr sketch);
+
+/**
+ * @brief Adds a value to a sketch.
+ *
+ * @param sketch Pointer to the sketch.
+ * @param value The value.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+void kll_update(KllSketchPtr sketch, double value);
+
+/**
+ * @brief Merges a sketch into another.
+ *
+ * @param sketch Pointer to the sketch receiving the values.
+ * @param other Pointer to the sketch to merge, left unchanged.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+void kll_merge(KllSketchPtr sketch, const KllSketch* other);
+
+/**
+ * @brief Estimates a quantile of the values of a sketch.
+ *
+ * @param sketch Pointer to the sketch.
+ * @param q Requested quantile, between 0 and 1 (0 gives the minimum, 1 the maximum).
+ * @return A retained value whose estimated rank is the smallest not below `q * n`,
+ *         or NaN if the sketch is empty.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+double kll_quantile(const KllSketch* sketch, double q);
+
+/**
+ * @brief Sketches field2 and field3 of a CSV file with several threads.
+ *
+ * The file is split into `n_threads` byte ranges; every thread skips the partial line
+ * at the start of its range, sketches the lines starting inside it, and the per-thread
+ * sketches are merged. Each thread stops at the first malformed line of its range.
+ *
+ * @param path Path to the CSV file.
+ * @param n_threads Number of threads.
+ * @param k Accuracy parameter of the sketches.
+ * @param field2 Pointer to the sketch receiving field2, initialized by the function.
+ * @param field3 Pointer to the sketch receiving field3, initialized by the function.
+ * @return 1 if the file was sketched, 0 if it cannot be opened.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation or thread creation.
+ */
+int sketch_csv_file(const char* path, size_t n_threads, size_t k, KllSketchPtr field2, KllSketchPtr field3);
+
+#endif // _QUANTILE_SKETCH_H
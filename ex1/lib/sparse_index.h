@@ -0,0 +1,110 @@
+/**
+ * @file sparse_index.h
+ * @brief Interface for sparse index sidecars of sorted CSV files.
+ *
+ * A sparse index stores, for every block of `block_size` consecutive lines of a CSV
+ * file sorted by one field, the byte offset of the first line of the block and its
+ * key. A range lookup binary-searches the index and reads only the blocks that may
+ * contain matching records.
+ *
+ * The sidecar is a text file: the first line is `<field>,<block_size>`, followed by
+ * one `<offset>,<key>` line per block.
+ */
+
+#ifndef _SPARSE_INDEX_H
+#define _SPARSE_INDEX_H
+
+#include "csv.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+
+#define DEFAULT_INDEX_BLOCK_SIZE 1024
+
+/**
+ * @brief In-memory representation of a sparse index.
+ *
+ * `keys[i]` holds, in the field the file is sorted by, the key of the first record
+ * of the i-th block, which starts at byte `offsets[i]` of the sorted file.
+ */
+typedef struct _SparseIndex {
+    size_t field;
+    size_t block_size;
+    size_t n_entries;
+    long* offsets;
+    Record* keys;
+
+} SparseIndex, *SparseIndexPtr;
+
+/**
+ * @brief Parses a key of the given field into a Record.
+ *
+ * Only the member of `key` corresponding to `field` is set, so that the record can be
+ * compared with `compare_field1`, `compare_field2` or `compare_field3`.
+ *
+ * @param field Field the key belongs to (1 for field1, 2 for field2, 3 for field3).
+ * @param text The key to parse.
+ * @param key Pointer to the record receiving the key (its field1 must be released with `field1_free`).
+ * @return 1 if the key is valid, 0 otherwise.
+ */
+int parse_index_key(size_t field, const char* text, Record* key);
+
+/**
+ * @brief Compares two keys of the given field, without overflowing on distant integers.
+ *
+ * @param field Field the keys belong to (1 for field1, 2 for field2, 3 for field3).
+ * @param a The first key.
+ * @param b The second key.
+ * @return A negative value, zero or a positive value if `a` is respectively less than,
+ *         equal to or greater than `b`.
+ */
+int compare_index_keys(size_t field, const Record* a, const Record* b);
+
+/**
+ * @brief Builds the sparse index of a sorted CSV file.
+ *
+ * The CSV file is read sequentially from its beginning; the offset and key of the first
+ * line of every block of `block_size` lines are written to `index_file`.
+ *
+ * @param sorted_csv The CSV file, sorted by `field`.
+ * @param index_file The file receiving the index.
+ * @param field Field the CSV file is sorted by (1 for field1, 2 for field2, 3 for field3).
+ * @param block_size Number of lines per block.
+ * @return The number of entries written to the index.
+ */
+size_t build_sparse_index(FILE* sorted_csv, FILE* index_file, size_t field, size_t block_size);
+
+/**
+ * @brief Loads a sparse index from its sidecar file.
+ *
+ * @param index_file The file containing the index.
+ * @param index Pointer to the index to fill.
+ * @return 1 if the index was loaded, 0 if the file is not a valid index.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+int load_sparse_index(FILE* index_file, SparseIndexPtr index);
+
+/**
+ * @brief Frees the memory held by a sparse index.
+ *
+ * @param index Pointer to the index to free.
+ */
+void sparse_index_free(SparseIndexPtr index);
+
+/**
+ * @brief Writes the records of a sorted CSV file whose key lies in [low, high].
+ *
+ * The index is binary-searched for the last block starting before `low`; the file is
+ * read from there and the scan stops at the first record whose key exceeds `high`.
+ * An inverted range, `low` greater than `high`, is rejected without reading the file.
+ *
+ * @param sorted_csv The CSV file the index was built from.
+ * @param index Pointer to the loaded index.
+ * @param low Lower bound of the key range, parsed with `parse_index_key`.
+ * @param high Upper bound of the key range, parsed with `parse_index_key`.
+ * @param outfile The file receiving the matching lines, unchanged.
+ * @return The number of matching records, 0 for an inverted range.
+ */
+size_t sparse_index_lookup(FILE* sorted_csv, const SparseIndex* index, const Record* low, const Record* high, FILE* outfile);
+
+#endif // _SPARSE_INDEX_H
@@ -1,6 +1,6 @@
 /**
  * @file algo.c
- * @brief Implementation file for the merge_sort and the quick_sort functions.
+ * @brief Implementation file for the merge_sort, quick_sort and natural_merge_sort functions.
  */
 
 #include "algo.h"
@@ -198,4 +198,71 @@ void quick_sort(void *base, size_t n_items, size_t size, int (*compar)(const voi
 
     quick_sort_recursive(base, n_items, size, compar, temp);
     free(temp);
-}
\ No newline at end of file
+}
+
+// Helper function that reverses base[left ... right]
+void reverse_range(void *base, size_t left, size_t right, size_t size, void *temp) {
+    while (left < right) {
+        swap((uint8_t *)base + left * size, (uint8_t *)base + right * size, size, temp);
+        left++;
+        right--;
+    }
+}
+
+// Natural merge sort: merges the runs already present in the input
+void natural_merge_sort(void *base, size_t n_items, size_t size, int (*compar)(const void*, const void*)) {
+    if (base == NULL || n_items == 0 || size == 0 || compar == NULL)
+        return;
+
+    // runs[k] is the index of the first element of the k-th run, runs[n_runs] = n_items
+    size_t *runs = malloc((n_items + 1) * sizeof(size_t));
+    void *temp = malloc(n_items * size);
+    if (runs == NULL || temp == NULL) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t n_runs = 0;
+    for (size_t i = 0; i < n_items;) {
+        size_t j = i + 1;
+
+        if (j < n_items && compar((uint8_t *)base + (j - 1) * size, (uint8_t *)base + j * size) > 0) {
+            // Only strictly descending runs are reversed, so equal elements keep their order
+            while (j < n_items && compar((uint8_t *)base + (j - 1) * size, (uint8_t *)base + j * size) > 0)
+                j++;
+
+            reverse_range(base, i, j - 1, size, temp);
+        }
+        else
+            while (j < n_items && compar((uint8_t *)base + (j - 1) * size, (uint8_t *)base + j * size) <= 0)
+                j++;
+
+        runs[n_runs++] = i;
+        i = j;
+    }
+    runs[n_runs] = n_items;
+
+    // Merge adjacent pairs of runs until a single run is left
+    while (n_runs > 1) {
+        size_t n_merged = 0;
+
+        for (size_t k = 0; k < n_runs; k += 2) {
+            runs[n_merged++] = runs[k];
+
+            if (k + 1 == n_runs)
+                break;
+
+            size_t mid = runs[k + 1] - 1;
+            size_t right = runs[k + 2] - 1;
+
+            if (compar((uint8_t *)base + mid * size, (uint8_t *)base + (mid + 1) * size) > 0)
+                merge(base, runs[k], mid, right, size, compar, temp);
+        }
+
+        runs[n_merged] = n_items;
+        n_runs = n_merged;
+    }
+
+    free(temp);
+    free(runs);
+}
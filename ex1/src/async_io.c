@@ -0,0 +1,672 @@
+/**
+ * @file async_io.c
+ * @brief Implementation of the io_uring-backed sequential reader and writer, with stdio fallback.
+ *
+ * The io_uring instance is driven through raw system calls, so no external library is
+ * needed. Every request uses a slot, made of a buffer of `block_size` bytes: the reader
+ * cycles through the slots in file order, resubmitting a slot for the next unread block
+ * as soon as the parser is done with it; the writer fills the slots in turn and waits
+ * for a slot's previous write only when it needs to fill it again.
+ */
+
+#include "async_io.h"
+#include "error_logger.h"
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define ASYNC_IO_HAS_URING
+#endif
+#endif
+
+#ifdef ASYNC_IO_HAS_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+/**
+ * @brief State of a slot: free, with a request in flight, or holding completed data.
+ */
+typedef enum _SlotState {
+    SLOT_IDLE,
+    SLOT_IN_FLIGHT,
+    SLOT_DONE
+
+} SlotState;
+
+/**
+ * @brief Buffer used by a single request.
+ */
+typedef struct _AsyncSlot {
+    char* buffer;
+    size_t length;    ///< Bytes requested, then bytes available once the request is done.
+    long long offset; ///< Offset of the buffer in the file.
+    SlotState state;
+
+} AsyncSlot;
+
+#ifdef ASYNC_IO_HAS_URING
+
+/**
+ * @brief Submission and completion rings of an io_uring instance, mapped in memory.
+ */
+typedef struct _Uring {
+    int fd;
+    unsigned* sq_tail;
+    unsigned sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned cq_mask;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    void* sq_ring;
+    size_t sq_ring_size;
+    void* cq_ring;
+    size_t cq_ring_size;
+    size_t sqes_size;
+
+} Uring;
+
+// Sets up an io_uring instance with room for `entries` requests and maps its rings
+static int uring_init(Uring* ring, unsigned entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    ring -> fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring -> fd < 0)
+        return 0;
+
+    ring -> sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring -> cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+    int single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        if (ring -> cq_ring_size > ring -> sq_ring_size)
+            ring -> sq_ring_size = ring -> cq_ring_size;
+
+        ring -> cq_ring_size = ring -> sq_ring_size;
+    }
+
+    ring -> sq_ring = mmap(NULL, ring -> sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring -> fd, IORING_OFF_SQ_RING);
+    if (ring -> sq_ring == MAP_FAILED) {
+        close(ring -> fd);
+        return 0;
+    }
+
+    ring -> cq_ring = single_mmap
+        ? ring -> sq_ring
+        : mmap(NULL, ring -> cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring -> fd, IORING_OFF_CQ_RING);
+    if (ring -> cq_ring == MAP_FAILED) {
+        munmap(ring -> sq_ring, ring -> sq_ring_size);
+        close(ring -> fd);
+        return 0;
+    }
+
+    ring -> sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring -> sqes = mmap(NULL, ring -> sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring -> fd, IORING_OFF_SQES);
+    if (ring -> sqes == MAP_FAILED) {
+        if (!single_mmap)
+            munmap(ring -> cq_ring, ring -> cq_ring_size);
+
+        munmap(ring -> sq_ring, ring -> sq_ring_size);
+        close(ring -> fd);
+        return 0;
+    }
+
+    uint8_t* sq = ring -> sq_ring;
+    uint8_t* cq = ring -> cq_ring;
+
+    ring -> sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring -> sq_mask = *(unsigned*)(sq + params.sq_off.ring_mask);
+    ring -> sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring -> cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring -> cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring -> cq_mask = *(unsigned*)(cq + params.cq_off.ring_mask);
+    ring -> cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+
+    return 1;
+}
+
+// Unmaps the rings and closes the io_uring instance
+static void uring_exit(Uring* ring) {
+    munmap(ring -> sqes, ring -> sqes_size);
+
+    if (ring -> cq_ring != ring -> sq_ring)
+        munmap(ring -> cq_ring, ring -> cq_ring_size);
+
+    munmap(ring -> sq_ring, ring -> sq_ring_size);
+    close(ring -> fd);
+}
+
+// Queues a single-buffer read or write of a slot and submits it to the kernel
+static int uring_submit(Uring* ring, int opcode, int fd, AsyncSlot* slot, unsigned slot_index, struct iovec* iov) {
+    unsigned tail = *ring -> sq_tail;
+    unsigned index = tail & ring -> sq_mask;
+    struct io_uring_sqe* sqe = &ring -> sqes[index];
+
+    iov -> iov_base = slot -> buffer;
+    iov -> iov_len = slot -> length;
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe -> opcode = (uint8_t)opcode;
+    sqe -> fd = fd;
+    sqe -> addr = (uint64_t)(uintptr_t)iov;
+    sqe -> len = 1;
+    sqe -> off = (uint64_t)slot -> offset;
+    sqe -> user_data = slot_index;
+
+    ring -> sq_array[index] = index;
+    __atomic_store_n(ring -> sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    for (;;) {
+        long submitted = syscall(__NR_io_uring_enter, ring -> fd, 1, 0, 0, NULL, 0);
+        if (submitted >= 0)
+            return submitted == 1;
+
+        if (errno != EINTR)
+            return 0;
+    }
+}
+
+// Waits for the next completion and returns its slot index and result
+static int uring_wait(Uring* ring, unsigned* slot_index, int* result) {
+    for (;;) {
+        unsigned head = *ring -> cq_head;
+
+        if (head != __atomic_load_n(ring -> cq_tail, __ATOMIC_ACQUIRE)) {
+            struct io_uring_cqe* cqe = &ring -> cqes[head & ring -> cq_mask];
+
+            *slot_index = (unsigned)cqe -> user_data;
+            *result = cqe -> res;
+
+            __atomic_store_n(ring -> cq_head, head + 1, __ATOMIC_RELEASE);
+            return 1;
+        }
+
+        if (syscall(__NR_io_uring_enter, ring -> fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 && errno != EINTR)
+            return 0;
+    }
+}
+
+#endif // ASYNC_IO_HAS_URING
+
+struct _AsyncReader {
+    AsyncIoBackend backend;
+    FILE* fp;
+    size_t block_size;
+    unsigned n_slots;
+    AsyncSlot* slots;
+    unsigned current;       ///< Slot holding the block being consumed.
+    int has_block;          ///< Non-zero once the first block has been fetched.
+    const char* block;      ///< Data of the block being consumed.
+    size_t block_length;
+    size_t position;        ///< Position of the next unread byte in the block.
+    int error;
+#ifdef ASYNC_IO_HAS_URING
+    Uring ring;
+    int fd;
+    struct iovec* iovs;
+    long long file_size;
+    long long next_offset;  ///< Offset of the next block to submit.
+#endif
+};
+
+struct _AsyncWriter {
+    AsyncIoBackend backend;
+    FILE* fp;
+    size_t block_size;
+    unsigned n_slots;
+    AsyncSlot* slots;
+    unsigned current;       ///< Slot being filled.
+    int error;
+#ifdef ASYNC_IO_HAS_URING
+    Uring ring;
+    int fd;
+    struct iovec* iovs;
+    long long next_offset;  ///< Offset of the next block to submit.
+#endif
+};
+
+// Allocates `n_slots` slots with a buffer of `block_size` bytes each
+static AsyncSlot* slots_create(unsigned n_slots, size_t block_size) {
+    AsyncSlot* slots = calloc(n_slots, sizeof(AsyncSlot));
+    if (!slots) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned i = 0; i < n_slots; i++) {
+        slots[i].buffer = malloc(block_size);
+        if (!slots[i].buffer) {
+            print_error("Memory allocation failed");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return slots;
+}
+
+// Frees the slots and their buffers
+static void slots_free(AsyncSlot* slots, unsigned n_slots) {
+    if (!slots)
+        return;
+
+    for (unsigned i = 0; i < n_slots; i++)
+        free(slots[i].buffer);
+
+    free(slots);
+}
+
+#ifdef ASYNC_IO_HAS_URING
+
+// Submits the read of the next block of the file into a slot
+static int reader_submit(AsyncReader* reader, unsigned slot_index) {
+    AsyncSlot* slot = &reader -> slots[slot_index];
+    long long remaining = reader -> file_size - reader -> next_offset;
+
+    if (remaining <= 0) {
+        slot -> state = SLOT_IDLE;
+        return 1;
+    }
+
+    slot -> offset = reader -> next_offset;
+    slot -> length = remaining < (long long)reader -> block_size ? (size_t)remaining : reader -> block_size;
+    slot -> state = SLOT_IN_FLIGHT;
+    reader -> next_offset += slot -> length;
+
+    if (!uring_submit(&reader -> ring, IORING_OP_READV, reader -> fd, slot, slot_index, &reader -> iovs[slot_index])) {
+        slot -> state = SLOT_IDLE;
+        return 0;
+    }
+
+    return 1;
+}
+
+// Waits for one read to complete, finishing short reads synchronously
+static int reader_reap(AsyncReader* reader) {
+    unsigned slot_index;
+    int result;
+
+    if (!uring_wait(&reader -> ring, &slot_index, &result) || result < 0 || slot_index >= reader -> n_slots)
+        return 0;
+
+    AsyncSlot* slot = &reader -> slots[slot_index];
+    size_t done = (size_t)result;
+
+    while (done < slot -> length) {
+        ssize_t n = pread(reader -> fd, slot -> buffer + done, slot -> length - done, slot -> offset + done);
+        if (n <= 0)
+            break;
+
+        done += (size_t)n;
+    }
+
+    slot -> length = done;
+    slot -> state = SLOT_DONE;
+
+    return 1;
+}
+
+#endif // ASYNC_IO_HAS_URING
+
+// Makes the next block of the file current; returns 0 at the end of the file or on error
+static int reader_next_block(AsyncReader* reader) {
+    if (reader -> error)
+        return 0;
+
+    if (reader -> backend == ASYNC_IO_STDIO) {
+        reader -> block = reader -> slots[0].buffer;
+        reader -> block_length = fread(reader -> slots[0].buffer, 1, reader -> block_size, reader -> fp);
+        reader -> position = 0;
+        reader -> error = ferror(reader -> fp);
+
+        return reader -> block_length > 0;
+    }
+
+#ifdef ASYNC_IO_HAS_URING
+    // The slot of the block just consumed is reused for the first block not yet requested
+    if (reader -> has_block) {
+        if (!reader_submit(reader, reader -> current)) {
+            reader -> error = 1;
+            return 0;
+        }
+
+        reader -> current = (reader -> current + 1) % reader -> n_slots;
+    }
+
+    reader -> has_block = 1;
+
+    AsyncSlot* slot = &reader -> slots[reader -> current];
+    if (slot -> state == SLOT_IDLE)
+        return 0;
+
+    while (slot -> state != SLOT_DONE)
+        if (!reader_reap(reader)) {
+            reader -> error = 1;
+            return 0;
+        }
+
+    reader -> block = slot -> buffer;
+    reader -> block_length = slot -> length;
+    reader -> position = 0;
+
+    return reader -> block_length > 0;
+#else
+    return 0;
+#endif
+}
+
+AsyncReader* async_reader_open(const char* path, int use_uring, size_t block_size, unsigned queue_depth) {
+    AsyncReader* reader = calloc(1, sizeof(AsyncReader));
+    if (!reader) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    reader -> block_size = block_size ? block_size : ASYNC_IO_BLOCK_SIZE;
+    reader -> n_slots = queue_depth ? queue_depth : 1;
+
+#ifdef ASYNC_IO_HAS_URING
+    if (use_uring) {
+        struct stat info;
+
+        reader -> fd = open(path, O_RDONLY);
+        if (reader -> fd < 0) {
+            free(reader);
+            return NULL;
+        }
+
+        // The reads are sized from the length of the file, unknown for a pipe or a device
+        if (fstat(reader -> fd, &info) == 0 && S_ISREG(info.st_mode) && uring_init(&reader -> ring, reader -> n_slots)) {
+            reader -> backend = ASYNC_IO_URING;
+            reader -> file_size = info.st_size;
+            reader -> slots = slots_create(reader -> n_slots, reader -> block_size);
+            reader -> iovs = calloc(reader -> n_slots, sizeof(struct iovec));
+            if (!reader -> iovs) {
+                print_error("Memory allocation failed");
+                exit(EXIT_FAILURE);
+            }
+
+            unsigned submitted = 0;
+            while (submitted < reader -> n_slots && reader_submit(reader, submitted))
+                submitted++;
+
+            if (submitted == reader -> n_slots)
+                return reader;
+
+            // The ring cannot take the first reads: wait for the ones queued and fall back to stdio
+            for (unsigned i = 0; i < submitted; i++)
+                while (reader -> slots[i].state == SLOT_IN_FLIGHT)
+                    if (!reader_reap(reader))
+                        break;
+
+            uring_exit(&reader -> ring);
+            free(reader -> iovs);
+            slots_free(reader -> slots, reader -> n_slots);
+            reader -> slots = NULL;
+        }
+
+        close(reader -> fd);
+    }
+#endif
+
+    reader -> backend = ASYNC_IO_STDIO;
+    reader -> n_slots = 1;
+    reader -> fp = fopen(path, "r");
+    if (!reader -> fp) {
+        free(reader);
+        return NULL;
+    }
+
+    reader -> slots = slots_create(1, reader -> block_size);
+
+    return reader;
+}
+
+AsyncIoBackend async_reader_backend(const AsyncReader* reader) {
+    return reader -> backend;
+}
+
+char* async_reader_gets(char* line, int size, AsyncReader* reader) {
+    size_t copied = 0;
+
+    if (size < 2)
+        return NULL;
+
+    while (copied < (size_t)size - 1) {
+        if (reader -> position == reader -> block_length && !reader_next_block(reader))
+            break;
+
+        const char* start = reader -> block + reader -> position;
+        size_t available = reader -> block_length - reader -> position;
+        if (available > (size_t)size - 1 - copied)
+            available = (size_t)size - 1 - copied;
+
+        const char* newline = memchr(start, '\n', available);
+        size_t count = newline ? (size_t)(newline - start) + 1 : available;
+
+        memcpy(line + copied, start, count);
+        copied += count;
+        reader -> position += count;
+
+        if (newline)
+            break;
+    }
+
+    if (copied == 0)
+        return NULL;
+
+    line[copied] = '\0';
+
+    return line;
+}
+
+void async_reader_close(AsyncReader* reader) {
+    if (!reader)
+        return;
+
+#ifdef ASYNC_IO_HAS_URING
+    if (reader -> backend == ASYNC_IO_URING) {
+        // Buffers cannot be released while the kernel may still write into them
+        for (unsigned i = 0; i < reader -> n_slots; i++)
+            while (reader -> slots[i].state == SLOT_IN_FLIGHT)
+                if (!reader_reap(reader))
+                    break;
+
+        uring_exit(&reader -> ring);
+        close(reader -> fd);
+        free(reader -> iovs);
+    }
+#endif
+
+    if (reader -> fp)
+        fclose(reader -> fp);
+
+    slots_free(reader -> slots, reader -> n_slots);
+    free(reader);
+}
+
+#ifdef ASYNC_IO_HAS_URING
+
+// Waits for one write to complete, finishing short writes synchronously
+static int writer_reap(AsyncWriter* writer) {
+    unsigned slot_index;
+    int result;
+
+    if (!uring_wait(&writer -> ring, &slot_index, &result) || slot_index >= writer -> n_slots)
+        return 0;
+
+    AsyncSlot* slot = &writer -> slots[slot_index];
+    size_t done = result < 0 ? 0 : (size_t)result;
+
+    if (result < 0)
+        writer -> error = 1;
+
+    while (!writer -> error && done < slot -> length) {
+        ssize_t n = pwrite(writer -> fd, slot -> buffer + done, slot -> length - done, slot -> offset + done);
+        if (n <= 0)
+            writer -> error = 1;
+        else
+            done += (size_t)n;
+    }
+
+    slot -> length = 0;
+    slot -> state = SLOT_IDLE;
+
+    return 1;
+}
+
+// Submits the write of the slot being filled and moves on to the next free slot
+static void writer_flush_current(AsyncWriter* writer) {
+    AsyncSlot* slot = &writer -> slots[writer -> current];
+
+    if (slot -> length == 0)
+        return;
+
+    slot -> offset = writer -> next_offset;
+    slot -> state = SLOT_IN_FLIGHT;
+    writer -> next_offset += slot -> length;
+
+    if (!uring_submit(&writer -> ring, IORING_OP_WRITEV, writer -> fd, slot, writer -> current, &writer -> iovs[writer -> current])) {
+        writer -> error = 1;
+        slot -> state = SLOT_IDLE;
+        return;
+    }
+
+    writer -> current = (writer -> current + 1) % writer -> n_slots;
+
+    while (writer -> slots[writer -> current].state == SLOT_IN_FLIGHT)
+        if (!writer_reap(writer)) {
+            writer -> error = 1;
+            return;
+        }
+}
+
+#endif // ASYNC_IO_HAS_URING
+
+AsyncWriter* async_writer_open(const char* path, int use_uring, size_t block_size, unsigned queue_depth) {
+    AsyncWriter* writer = calloc(1, sizeof(AsyncWriter));
+    if (!writer) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    writer -> block_size = block_size ? block_size : ASYNC_IO_BLOCK_SIZE;
+    writer -> n_slots = queue_depth ? queue_depth : 1;
+
+#ifdef ASYNC_IO_HAS_URING
+    if (use_uring) {
+        writer -> fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (writer -> fd < 0) {
+            free(writer);
+            return NULL;
+        }
+
+        if (uring_init(&writer -> ring, writer -> n_slots)) {
+            writer -> backend = ASYNC_IO_URING;
+            writer -> slots = slots_create(writer -> n_slots, writer -> block_size);
+            writer -> iovs = calloc(writer -> n_slots, sizeof(struct iovec));
+            if (!writer -> iovs) {
+                print_error("Memory allocation failed");
+                exit(EXIT_FAILURE);
+            }
+
+            return writer;
+        }
+
+        close(writer -> fd);
+    }
+#endif
+
+    writer -> backend = ASYNC_IO_STDIO;
+    writer -> n_slots = 0;
+    writer -> fp = fopen(path, "w");
+    if (!writer -> fp) {
+        free(writer);
+        return NULL;
+    }
+
+    return writer;
+}
+
+AsyncIoBackend async_writer_backend(const AsyncWriter* writer) {
+    return writer -> backend;
+}
+
+size_t async_writer_write(AsyncWriter* writer, const void* data, size_t length) {
+    if (writer -> error)
+        return 0;
+
+    if (writer -> backend == ASYNC_IO_STDIO) {
+        if (fwrite(data, 1, length, writer -> fp) != length)
+            writer -> error = 1;
+
+        return writer -> error ? 0 : length;
+    }
+
+#ifdef ASYNC_IO_HAS_URING
+    const char* bytes = data;
+    size_t remaining = length;
+
+    while (remaining > 0 && !writer -> error) {
+        AsyncSlot* slot = &writer -> slots[writer -> current];
+        size_t count = writer -> block_size - slot -> length;
+        if (count > remaining)
+            count = remaining;
+
+        memcpy(slot -> buffer + slot -> length, bytes, count);
+        slot -> length += count;
+        bytes += count;
+        remaining -= count;
+
+        if (slot -> length == writer -> block_size)
+            writer_flush_current(writer);
+    }
+#endif
+
+    return writer -> error ? 0 : length;
+}
+
+int async_writer_close(AsyncWriter* writer) {
+    if (!writer)
+        return -1;
+
+#ifdef ASYNC_IO_HAS_URING
+    if (writer -> backend == ASYNC_IO_URING) {
+        if (!writer -> error)
+            writer_flush_current(writer);
+
+        for (unsigned i = 0; i < writer -> n_slots; i++)
+            while (writer -> slots[i].state == SLOT_IN_FLIGHT)
+                if (!writer_reap(writer)) {
+                    writer -> error = 1;
+                    break;
+                }
+
+        uring_exit(&writer -> ring);
+        if (close(writer -> fd) != 0)
+            writer -> error = 1;
+
+        free(writer -> iovs);
+    }
+#endif
+
+    if (writer -> fp && fclose(writer -> fp) != 0)
+        writer -> error = 1;
+
+    int result = writer -> error ? -1 : 0;
+
+    slots_free(writer -> slots, writer -> n_slots);
+    free(writer);
+
+    return result;
+}
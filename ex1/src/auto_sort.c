@@ -0,0 +1,218 @@
+/**
+ * @file auto_sort.c
+ * @brief Implementation of the automatic choice of the sorting algorithm of a RecordBatch.
+ */
+
+#include "auto_sort.h"
+#include "algo.h"
+#include "error_logger.h"
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+// Returns the size and the comparison function of the key entries of a field
+static size_t key_entry(size_t field, int (**compare)(const void*, const void*)) {
+    switch (field) {
+        case 1:
+            *compare = compare_field1_key;
+            return sizeof(Field1Key);
+
+        case 2:
+            *compare = compare_field2_key;
+            return sizeof(Field2Key);
+
+        default:
+            *compare = compare_field3_key;
+            return sizeof(Field3Key);
+    }
+}
+
+// Stores in `entry` the key of record i of the batch, paired with its index
+static void key_at(const RecordBatch* batch, size_t field, size_t i, void* entry) {
+    switch (field) {
+        case 1:
+            *(Field1Key*)entry = (Field1Key){ batch -> field1[i], i };
+            break;
+
+        case 2:
+            *(Field2Key*)entry = (Field2Key){ batch -> field2[i], i };
+            break;
+
+        default:
+            *(Field3Key*)entry = (Field3Key){ batch -> field3[i], i };
+            break;
+    }
+}
+
+void profile_record_batch(const RecordBatch* batch, size_t field, KeyProfile* profile) {
+    size_t n = batch -> n_records;
+    size_t k = n < AUTO_SORT_SAMPLE_SIZE ? n : AUTO_SORT_SAMPLE_SIZE;
+
+    memset(profile, 0, sizeof(KeyProfile));
+    profile -> n_sampled = k;
+
+    if (k < 2)
+        return;
+
+    int (*compare)(const void*, const void*);
+    size_t size = key_entry(field, &compare);
+
+    uint8_t* sample = malloc(k * size);
+    if (!sample) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    // Evenly spaced keys, in batch order; field1 entries share the batch's storage
+    for (size_t s = 0; s < k; s++)
+        key_at(batch, field, (size_t)((double)s * n / k), sample + s * size);
+
+    size_t n_descents = 0;
+    for (size_t s = 1; s < k; s++)
+        if (compare(sample + (s - 1) * size, sample + s * size) > 0)
+            n_descents++;
+
+    merge_sort(sample, k, size, compare);
+
+    size_t n_duplicates = 0;
+    for (size_t s = 1; s < k; s++)
+        if (compare(sample + (s - 1) * size, sample + s * size) == 0)
+            n_duplicates++;
+
+    profile -> descent_ratio = (double)n_descents / (k - 1);
+    profile -> duplicate_ratio = (double)n_duplicates / k;
+
+    free(sample);
+}
+
+SortStrategy choose_sort_strategy(size_t field, const KeyProfile* profile) {
+    if (profile -> descent_ratio <= AUTO_SORT_PRESORTED_RATIO || profile -> descent_ratio >= 1 - AUTO_SORT_PRESORTED_RATIO)
+        return SORT_STRATEGY_NATURAL_MERGE;
+
+    if (field == 2 || field == 3)
+        return SORT_STRATEGY_RADIX;
+
+    if (profile -> duplicate_ratio >= AUTO_SORT_DUPLICATE_RATIO)
+        return SORT_STRATEGY_QUICK;
+
+    return SORT_STRATEGY_MERGE;
+}
+
+const char* sort_strategy_name(SortStrategy strategy) {
+    switch (strategy) {
+        case SORT_STRATEGY_QUICK:
+            return "quick_sort";
+
+        case SORT_STRATEGY_NATURAL_MERGE:
+            return "natural_merge_sort";
+
+        case SORT_STRATEGY_RADIX:
+            return "radix_sort";
+
+        default:
+            return "merge_sort";
+    }
+}
+
+// Maps a double to an unsigned integer with the same order
+static uint64_t double_radix_key(double value) {
+    uint64_t bits;
+
+    if (value == 0.0)
+        value = 0.0; // -0.0 compares equal to 0.0
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    return (bits & UINT64_C(0x8000000000000000)) ? ~bits : bits | UINT64_C(0x8000000000000000);
+}
+
+size_t* radix_sort_record_batch(const RecordBatch* batch, size_t field) {
+    if (field != 2 && field != 3)
+        return NULL;
+
+    size_t n = batch -> n_records;
+    size_t n_bytes = field == 2 ? sizeof(uint32_t) : sizeof(uint64_t);
+
+    size_t* indices = malloc((n ? n : 1) * sizeof(size_t));
+    size_t* indices_tmp = malloc((n ? n : 1) * sizeof(size_t));
+    uint64_t* keys = malloc((n ? n : 1) * sizeof(uint64_t));
+    uint64_t* keys_tmp = malloc((n ? n : 1) * sizeof(uint64_t));
+    size_t (*counts)[256] = calloc(n_bytes, sizeof(*counts));
+    if (!indices || !indices_tmp || !keys || !keys_tmp || !counts) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    // One pass builds the keys and the histograms of all of their bytes
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = field == 2
+            ? (uint32_t)batch -> field2[i] ^ UINT32_C(0x80000000)
+            : double_radix_key(batch -> field3[i]);
+        indices[i] = i;
+
+        for (size_t b = 0; b < n_bytes; b++)
+            counts[b][(keys[i] >> (8 * b)) & 0xFF]++;
+    }
+
+    for (size_t b = 0; b < n_bytes; b++) {
+        // A byte shared by every key does not change the order
+        if (n == 0 || counts[b][(keys[0] >> (8 * b)) & 0xFF] == n)
+            continue;
+
+        size_t offset = 0;
+        for (size_t d = 0; d < 256; d++) {
+            size_t count = counts[b][d];
+            counts[b][d] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            size_t position = counts[b][(keys[i] >> (8 * b)) & 0xFF]++;
+            keys_tmp[position] = keys[i];
+            indices_tmp[position] = indices[i];
+        }
+
+        uint64_t* swap_keys = keys;
+        keys = keys_tmp;
+        keys_tmp = swap_keys;
+
+        size_t* swap_indices = indices;
+        indices = indices_tmp;
+        indices_tmp = swap_indices;
+    }
+
+    free(indices_tmp);
+    free(keys);
+    free(keys_tmp);
+    free(counts);
+
+    return indices;
+}
+
+size_t* auto_sort_record_batch(const RecordBatch* batch, size_t field, KeyProfile* profile, SortStrategy* strategy) {
+    KeyProfile sampled;
+    profile_record_batch(batch, field, &sampled);
+
+    SortStrategy chosen = choose_sort_strategy(field, &sampled);
+
+    if (profile)
+        *profile = sampled;
+
+    if (strategy)
+        *strategy = chosen;
+
+    switch (chosen) {
+        case SORT_STRATEGY_RADIX:
+            return radix_sort_record_batch(batch, field);
+
+        case SORT_STRATEGY_NATURAL_MERGE:
+            return sort_record_batch(batch, field, natural_merge_sort);
+
+        case SORT_STRATEGY_QUICK:
+            return sort_record_batch(batch, field, quick_sort);
+
+        default:
+            return sort_record_batch(batch, field, merge_sort);
+    }
+}
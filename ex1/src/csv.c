@@ -9,27 +9,67 @@
 #include "csv.h"
 #include "error_logger.h"
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <pthread.h>
 
 
 const char* recordReadFmt = "%d,%239[^,],%d,%lf\n";
 const char* recordWriteFmt = "%d,%s,%d,%lf\n";
 
+void field1_set(Field1* field1, const char* str) {
+    size_t len = strlen(str);
+
+    memset(field1, 0, sizeof(Field1));
+
+    if (len <= FIELD1_INLINE_CAPACITY) {
+        memcpy(field1 -> inline_data, str, len);
+        return;
+    }
+
+    field1 -> heap.data = malloc(len + 1);
+    if (field1 -> heap.data == NULL){
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(field1 -> heap.data, str, len + 1);
+    field1 -> heap.tag = FIELD1_HEAP_TAG;
+}
+
+const char* field1_str(const Field1* field1) {
+    return field1 -> heap.tag == FIELD1_HEAP_TAG ? field1 -> heap.data : field1 -> inline_data;
+}
+
+void field1_free(Field1* field1) {
+    if (field1 -> heap.tag == FIELD1_HEAP_TAG)
+        free(field1 -> heap.data);
+
+    memset(field1, 0, sizeof(Field1));
+}
+
+int field1_compare(const Field1* a, const Field1* b) {
+    if (a -> heap.tag != FIELD1_HEAP_TAG && b -> heap.tag != FIELD1_HEAP_TAG)
+        return memcmp(a -> inline_data, b -> inline_data, sizeof(Field1));
+
+    return strcmp(field1_str(a), field1_str(b));
+}
+
 int compare_field1(const void* a, const void* b) {
     const Record* recordA = (const Record*)a;
     const Record* recordB = (const Record*)b;
     
-    return strcmp(recordA -> field1, recordB -> field1);
+    return field1_compare(&recordA -> field1, &recordB -> field1);
 }
 
 int compare_field2(const void* a, const void* b) {
-    const Record* recordA = (const Record*)a;
-    const Record* recordB = (const Record*)b;
+    int field2A = ((const Record*)a) -> field2;
+    int field2B = ((const Record*)b) -> field2;
 
-    return recordA -> field2 - recordB -> field2;
+    return (field2A > field2B) - (field2A < field2B);
 }
 
 int compare_field3(const void* a, const void* b) {
@@ -48,6 +88,13 @@ int compare_field3(const void* a, const void* b) {
         return 0;
 }
 
+int compare_id(const void* a, const void* b) {
+    int idA = ((const Record*)a) -> id;
+    int idB = ((const Record*)b) -> id;
+
+    return (idA > idB) - (idA < idB);
+}
+
 size_t count_lines(FILE* file) {
     size_t n_lines = 0;
     char buffer[MAX_LINE_SIZE];
@@ -60,36 +107,141 @@ size_t count_lines(FILE* file) {
     return n_lines;
 }
 
-size_t read_records(FILE* infile, RecordPtr records, size_t n_records) {
-    size_t read_count = 0;
-    char* temp_buffer = malloc(MAX_FIELD1_SIZE);
-    if (temp_buffer == NULL){
-        print_error("Memory allocation failed");
-        exit(EXIT_FAILURE);
+int parse_int(const char* start, char** end, int* value) {
+    errno = 0;
+    long parsed = strtol(start, end, 10);
+
+    if (*end == start || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX)
+        return -1;
+
+    *value = (int)parsed;
+
+    return 0;
+}
+
+int parse_record_line(
+    char* line,
+    const RecordFilter* filter,
+    int* id,
+    char** field1,
+    int* field2,
+    double* field3
+) {
+    char* first_comma = strchr(line, ',');
+    if (first_comma == NULL)
+        return -1;
+
+    char* field1_start = first_comma + 1;
+    char* second_comma = strchr(field1_start, ',');
+    if (second_comma == NULL || second_comma == field1_start || second_comma - field1_start >= MAX_FIELD1_SIZE)
+        return -1;
+
+    // The prefix is matched within field1 only, which is not terminated yet
+    if (filter != NULL && filter -> field1_prefix != NULL) {
+        size_t prefix_length = strlen(filter -> field1_prefix);
+
+        if (prefix_length > (size_t)(second_comma - field1_start) || strncmp(field1_start, filter -> field1_prefix, prefix_length) != 0)
+            return 0;
     }
 
+    char* end;
+    if (parse_int(second_comma + 1, &end, field2) != 0 || *end != ',')
+        return -1;
+
+    if (filter != NULL && filter -> has_field2_range && (*field2 < filter -> field2_min || *field2 > filter -> field2_max))
+        return 0;
+
+    char* field3_start = end + 1;
+    *field3 = strtod(field3_start, &end);
+    if (end == field3_start)
+        return -1;
+
+    if (filter != NULL && filter -> has_field3_range && (*field3 < filter -> field3_min || *field3 > filter -> field3_max))
+        return 0;
+
+    if (parse_int(line, &end, id) != 0 || end != first_comma)
+        return -1;
+
+    *second_comma = '\0';
+    *field1 = field1_start;
+
+    return 1;
+}
+
+/**
+ * @brief Source of lines: a function with the semantics of `fgets` and the stream it reads.
+ */
+typedef struct _LineSource {
+    char* (*gets)(char*, int, void*);
+    void* stream;
+
+} LineSource;
+
+// Adapts fgets to the LineSource signature
+static char* file_gets(char* line, int size, void* stream) {
+    return fgets(line, size, (FILE*)stream);
+}
+
+// Adapts async_reader_gets to the LineSource signature
+static char* async_gets(char* line, int size, void* stream) {
+    return async_reader_gets(line, size, (AsyncReader*)stream);
+}
+
+/**
+ * @brief Reads the next line of a source that matches a filter.
+ *
+ * @param source The source to read from.
+ * @param line Buffer of `RECORD_LINE_BUFFER_SIZE` bytes receiving the line.
+ * @param filter The predicates the record must satisfy, or NULL to accept every record.
+ * @param id Pointer where the id of the record is stored.
+ * @param field1 Pointer where the start of field1 within `line` is stored.
+ * @param field2 Pointer where field2 is stored.
+ * @param field3 Pointer where field3 is stored.
+ * @return 1 if a matching record was read, 0 at the end of the file or on a malformed line.
+ */
+static int read_next_record(
+    const LineSource* source,
+    char* line,
+    const RecordFilter* filter,
+    int* id,
+    char** field1,
+    int* field2,
+    double* field3
+) {
+    while (source -> gets(line, RECORD_LINE_BUFFER_SIZE, source -> stream)) {
+        int outcome = parse_record_line(line, filter, id, field1, field2, field3);
+
+        if (outcome == 1)
+            return 1;
+
+        if (outcome < 0)
+            return 0;
+    }
+
+    return 0;
+}
+
+size_t read_records(FILE* infile, RecordPtr records, size_t n_records, const RecordFilter* filter) {
+    size_t read_count = 0;
+    char line[RECORD_LINE_BUFFER_SIZE];
+    char* field1;
+    LineSource source = { file_gets, infile };
+
     for (; read_count < n_records; read_count++) {
-        if (fscanf(
-            infile, 
-            recordReadFmt, 
-            &records[read_count].id, 
-            temp_buffer, 
-            &records[read_count].field2, 
+        if (!read_next_record(
+            &source,
+            line,
+            filter,
+            &records[read_count].id,
+            &field1,
+            &records[read_count].field2,
             &records[read_count].field3
-        ) != N_FIELDS_IN_RECORD)
+        ))
             break;
 
-        records[read_count].field1 = malloc(strlen(temp_buffer) + 1);
-        if (records[read_count].field1 == NULL){
-            print_error("Memory allocation failed");
-            exit(EXIT_FAILURE);
-        }
-
-        strcpy(records[read_count].field1, temp_buffer);
+        field1_set(&records[read_count].field1, field1);
     }
 
-    free(temp_buffer);
-
     return read_count;
 }
 
@@ -102,7 +254,7 @@ size_t write_records(FILE* outfile, RecordPtr records, size_t n_records) {
                 outfile, 
                 recordWriteFmt,
                 records[n_wrote_records].id,
-                records[n_wrote_records].field1,
+                field1_str(&records[n_wrote_records].field1),
                 records[n_wrote_records].field2,
                 records[n_wrote_records].field3
             ) == 0
@@ -111,3 +263,413 @@ size_t write_records(FILE* outfile, RecordPtr records, size_t n_records) {
 
     return n_wrote_records;
 }
+
+int compare_field1_key(const void* a, const void* b) {
+    return field1_compare(&((const Field1Key*)a) -> key, &((const Field1Key*)b) -> key);
+}
+
+int compare_field2_key(const void* a, const void* b) {
+    int keyA = ((const Field2Key*)a) -> key;
+    int keyB = ((const Field2Key*)b) -> key;
+
+    return (keyA > keyB) - (keyA < keyB);
+}
+
+int compare_field3_key(const void* a, const void* b) {
+    double keyA = ((const Field3Key*)a) -> key;
+    double keyB = ((const Field3Key*)b) -> key;
+
+    return (keyA > keyB) - (keyA < keyB);
+}
+
+void record_batch_init(RecordBatchPtr batch, size_t capacity) {
+    batch -> n_records = 0;
+    batch -> capacity = capacity;
+
+    // malloc(0) may return NULL, which must not be mistaken for a failure
+    size_t n_slots = capacity ? capacity : 1;
+    batch -> id = malloc(n_slots * sizeof(int));
+    batch -> field1 = malloc(n_slots * sizeof(Field1));
+    batch -> field2 = malloc(n_slots * sizeof(int));
+    batch -> field3 = malloc(n_slots * sizeof(double));
+
+    if (!batch -> id || !batch -> field1 || !batch -> field2 || !batch -> field3) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+}
+
+void record_batch_free(RecordBatchPtr batch) {
+    for (size_t i = 0; i < batch -> n_records; i++)
+        field1_free(&batch -> field1[i]);
+
+    free(batch -> id);
+    free(batch -> field1);
+    free(batch -> field2);
+    free(batch -> field3);
+
+    batch -> n_records = 0;
+    batch -> capacity = 0;
+}
+
+/**
+ * @brief Doubles the capacity of a RecordBatch.
+ *
+ * @param batch Pointer to the batch to grow.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+static void record_batch_grow(RecordBatchPtr batch) {
+    size_t capacity = batch -> capacity ? batch -> capacity * 2 : 1024;
+
+    int* id = realloc(batch -> id, capacity * sizeof(int));
+    if (id) batch -> id = id;
+
+    Field1* field1 = realloc(batch -> field1, capacity * sizeof(Field1));
+    if (field1) batch -> field1 = field1;
+
+    int* field2 = realloc(batch -> field2, capacity * sizeof(int));
+    if (field2) batch -> field2 = field2;
+
+    double* field3 = realloc(batch -> field3, capacity * sizeof(double));
+    if (field3) batch -> field3 = field3;
+
+    if (!id || !field1 || !field2 || !field3) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    batch -> capacity = capacity;
+}
+
+// Appends up to n_records matching records of a source to a batch
+static size_t read_record_batch_from(const LineSource* source, RecordBatchPtr batch, size_t n_records, const RecordFilter* filter) {
+    size_t read_count = 0;
+    char line[RECORD_LINE_BUFFER_SIZE];
+    char* field1;
+    int id;
+    int field2;
+    double field3;
+
+    for (; read_count < n_records; read_count++) {
+        if (!read_next_record(source, line, filter, &id, &field1, &field2, &field3))
+            break;
+
+        if (batch -> n_records == batch -> capacity)
+            record_batch_grow(batch);
+
+        size_t i = batch -> n_records++;
+        batch -> id[i] = id;
+        field1_set(&batch -> field1[i], field1);
+        batch -> field2[i] = field2;
+        batch -> field3[i] = field3;
+    }
+
+    return read_count;
+}
+
+size_t read_record_batch(FILE* infile, RecordBatchPtr batch, size_t n_records, const RecordFilter* filter) {
+    LineSource source = { file_gets, infile };
+
+    return read_record_batch_from(&source, batch, n_records, filter);
+}
+
+size_t read_record_batch_async(AsyncReader* reader, RecordBatchPtr batch, size_t n_records, const RecordFilter* filter) {
+    LineSource source = { async_gets, reader };
+
+    return read_record_batch_from(&source, batch, n_records, filter);
+}
+
+size_t* sort_record_batch(
+    const RecordBatch* batch,
+    size_t field,
+    void (*sort)(void*, size_t, size_t, int (*)(const void*, const void*))
+) {
+    size_t n = batch -> n_records;
+    size_t* permutation = malloc((n ? n : 1) * sizeof(size_t));
+    if (!permutation) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    switch (field) {
+        case 1: {
+            Field1Key* keys = malloc((n ? n : 1) * sizeof(Field1Key));
+            if (!keys) {
+                print_error("Memory allocation failed");
+                exit(EXIT_FAILURE);
+            }
+
+            for (size_t i = 0; i < n; i++)
+                keys[i] = (Field1Key){ batch -> field1[i], i };
+
+            sort(keys, n, sizeof(Field1Key), compare_field1_key);
+
+            for (size_t i = 0; i < n; i++)
+                permutation[i] = keys[i].index;
+
+            free(keys);
+            break;
+        }
+
+        case 2: {
+            Field2Key* keys = malloc((n ? n : 1) * sizeof(Field2Key));
+            if (!keys) {
+                print_error("Memory allocation failed");
+                exit(EXIT_FAILURE);
+            }
+
+            for (size_t i = 0; i < n; i++)
+                keys[i] = (Field2Key){ batch -> field2[i], i };
+
+            sort(keys, n, sizeof(Field2Key), compare_field2_key);
+
+            for (size_t i = 0; i < n; i++)
+                permutation[i] = keys[i].index;
+
+            free(keys);
+            break;
+        }
+
+        case 3: {
+            Field3Key* keys = malloc((n ? n : 1) * sizeof(Field3Key));
+            if (!keys) {
+                print_error("Memory allocation failed");
+                exit(EXIT_FAILURE);
+            }
+
+            for (size_t i = 0; i < n; i++)
+                keys[i] = (Field3Key){ batch -> field3[i], i };
+
+            sort(keys, n, sizeof(Field3Key), compare_field3_key);
+
+            for (size_t i = 0; i < n; i++)
+                permutation[i] = keys[i].index;
+
+            free(keys);
+            break;
+        }
+
+        default:
+            for (size_t i = 0; i < n; i++)
+                permutation[i] = i;
+
+            break;
+    }
+
+    return permutation;
+}
+
+size_t write_record_batch(FILE* outfile, const RecordBatch* batch, const size_t* permutation, size_t n_records) {
+    size_t n_wrote_records = 0;
+
+    if (n_records > batch -> n_records)
+        n_records = batch -> n_records;
+
+    for (; n_wrote_records < n_records; n_wrote_records++) {
+        size_t i = permutation ? permutation[n_wrote_records] : n_wrote_records;
+
+        if (
+            fprintf(
+                outfile,
+                recordWriteFmt,
+                batch -> id[i],
+                field1_str(&batch -> field1[i]),
+                batch -> field2[i],
+                batch -> field3[i]
+            ) == 0
+        )
+            break;
+    }
+
+    return n_wrote_records;
+}
+
+/**
+ * @brief Chunk of a RecordBatch formatted by a single worker thread.
+ */
+typedef struct _FormatTask {
+    const RecordBatch* batch;
+    const size_t* permutation;
+    size_t begin;
+    size_t end;
+    char* buffer;
+    size_t capacity;
+    size_t length;
+
+} FormatTask;
+
+// Worker that formats the records [begin, end) of the task into its buffer
+static void* format_task_run(void* arg) {
+    FormatTask* task = (FormatTask*)arg;
+    const RecordBatch* batch = task -> batch;
+
+    task -> length = 0;
+
+    for (size_t k = task -> begin; k < task -> end; k++) {
+        size_t i = task -> permutation ? task -> permutation[k] : k;
+
+        for (;;) {
+            size_t available = task -> capacity - task -> length;
+            int written = snprintf(
+                task -> buffer + task -> length,
+                available,
+                recordWriteFmt,
+                batch -> id[i],
+                field1_str(&batch -> field1[i]),
+                batch -> field2[i],
+                batch -> field3[i]
+            );
+
+            if (written < 0) {
+                print_error("Record formatting failed");
+                exit(EXIT_FAILURE);
+            }
+
+            if ((size_t)written < available) {
+                task -> length += written;
+                break;
+            }
+
+            size_t new_capacity = task -> capacity * 2 + written + 1;
+            char* new_buffer = realloc(task -> buffer, new_capacity);
+            if (new_buffer == NULL) {
+                print_error("Memory allocation failed");
+                exit(EXIT_FAILURE);
+            }
+
+            task -> buffer = new_buffer;
+            task -> capacity = new_capacity;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Destination of bytes: a function with the semantics of `fwrite` and the stream it writes.
+ */
+typedef struct _ByteSink {
+    size_t (*write)(const void*, size_t, void*);
+    void* stream;
+
+} ByteSink;
+
+// Adapts fwrite to the ByteSink signature
+static size_t file_write(const void* data, size_t length, void* stream) {
+    return fwrite(data, 1, length, (FILE*)stream);
+}
+
+// Adapts async_writer_write to the ByteSink signature
+static size_t async_write(const void* data, size_t length, void* stream) {
+    return async_writer_write((AsyncWriter*)stream, data, length);
+}
+
+// Formats the records in chunks on n_threads threads (inline for a single one) and writes them in order
+static size_t write_record_batch_to(
+    const ByteSink* sink,
+    const RecordBatch* batch,
+    const size_t* permutation,
+    size_t n_records,
+    size_t n_threads
+) {
+    if (n_threads == 0)
+        n_threads = 1;
+
+    size_t chunk_size = (n_records + n_threads - 1) / n_threads;
+    if (chunk_size > PARALLEL_WRITE_CHUNK_SIZE)
+        chunk_size = PARALLEL_WRITE_CHUNK_SIZE;
+
+    FormatTask* tasks = calloc(n_threads, sizeof(FormatTask));
+    pthread_t* threads = malloc(n_threads * sizeof(pthread_t));
+    if (!tasks || !threads) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t n_wrote_records = 0;
+    int failed = 0;
+
+    // Every round formats up to n_threads chunks in parallel, then writes them in order
+    for (size_t round_begin = 0; round_begin < n_records && !failed; round_begin += n_threads * chunk_size) {
+        size_t n_tasks = 0;
+
+        for (size_t begin = round_begin; n_tasks < n_threads && begin < n_records; begin += chunk_size) {
+            FormatTask* task = &tasks[n_tasks];
+
+            task -> batch = batch;
+            task -> permutation = permutation;
+            task -> begin = begin;
+            task -> end = begin + chunk_size < n_records ? begin + chunk_size : n_records;
+
+            if (task -> buffer == NULL) {
+                task -> capacity = (task -> end - task -> begin) * 64 + 1;
+                task -> buffer = malloc(task -> capacity);
+                if (task -> buffer == NULL) {
+                    print_error("Memory allocation failed");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+            if (n_threads == 1)
+                format_task_run(task);
+            else if (pthread_create(&threads[n_tasks], NULL, format_task_run, task) != 0) {
+                print_error("Thread creation failed");
+                exit(EXIT_FAILURE);
+            }
+
+            n_tasks++;
+        }
+
+        if (n_threads > 1)
+            for (size_t t = 0; t < n_tasks; t++)
+                pthread_join(threads[t], NULL);
+
+        for (size_t t = 0; t < n_tasks && !failed; t++) {
+            if (sink -> write(tasks[t].buffer, tasks[t].length, sink -> stream) != tasks[t].length)
+                failed = 1;
+            else
+                n_wrote_records += tasks[t].end - tasks[t].begin;
+        }
+    }
+
+    for (size_t t = 0; t < n_threads; t++)
+        free(tasks[t].buffer);
+
+    free(tasks);
+    free(threads);
+
+    return n_wrote_records;
+}
+
+size_t write_record_batch_parallel(
+    FILE* outfile,
+    const RecordBatch* batch,
+    const size_t* permutation,
+    size_t n_records,
+    size_t n_threads
+) {
+    if (n_records > batch -> n_records)
+        n_records = batch -> n_records;
+
+    if (n_threads <= 1 || n_records == 0)
+        return write_record_batch(outfile, batch, permutation, n_records);
+
+    ByteSink sink = { file_write, outfile };
+
+    return write_record_batch_to(&sink, batch, permutation, n_records, n_threads);
+}
+
+size_t write_record_batch_async(
+    AsyncWriter* writer,
+    const RecordBatch* batch,
+    const size_t* permutation,
+    size_t n_records,
+    size_t n_threads
+) {
+    if (n_records > batch -> n_records)
+        n_records = batch -> n_records;
+
+    ByteSink sink = { async_write, writer };
+
+    return write_record_batch_to(&sink, batch, permutation, n_records, n_threads);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file group_by.c
+ * @brief Implementation of the sort-based group-by aggregation of records.
+ */
+
+#include "group_by.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+// Adds a record to the aggregates of its group
+static void group_add(GroupAggregate* group, int field2, double field3) {
+    group -> count++;
+    group -> field2_sum += field2;
+    group -> field3_sum += field3;
+}
+
+// Writes the aggregates of a group after its key, already written by the caller
+static void group_write(FILE* outfile, const GroupAggregate* group) {
+    fprintf(
+        outfile,
+        ",%zu,%lld,%lf,%lf,%lf\n",
+        group -> count,
+        group -> field2_sum,
+        (double)group -> field2_sum / group -> count,
+        group -> field3_sum,
+        group -> field3_sum / group -> count
+    );
+}
+
+// Writes the key of a group in the same format as the records
+static void key_write(FILE* outfile, size_t field, const char* field1, int field2, double field3) {
+    switch (field) {
+        case 1:
+            fputs(field1, outfile);
+            break;
+
+        case 2:
+            fprintf(outfile, "%d", field2);
+            break;
+
+        default:
+            fprintf(outfile, "%lf", field3);
+            break;
+    }
+}
+
+size_t write_record_groups(FILE* outfile, const RecordBatch* batch, const size_t* permutation, size_t field) {
+    GroupAggregate group = { 0, 0, 0.0 };
+    size_t n_groups = 0;
+    size_t first = 0; // index of the first record of the current group
+
+    for (size_t k = 0; k < batch -> n_records; k++) {
+        size_t i = permutation ? permutation[k] : k;
+
+        int same_key = group.count > 0 && (
+            field == 1 ? field1_compare(&batch -> field1[first], &batch -> field1[i]) == 0 :
+            field == 2 ? batch -> field2[first] == batch -> field2[i] :
+            batch -> field3[first] == batch -> field3[i]
+        );
+
+        if (!same_key) {
+            if (group.count > 0) {
+                key_write(outfile, field, field1_str(&batch -> field1[first]), batch -> field2[first], batch -> field3[first]);
+                group_write(outfile, &group);
+                n_groups++;
+            }
+
+            group = (GroupAggregate){ 0, 0, 0.0 };
+            first = i;
+        }
+
+        group_add(&group, batch -> field2[i], batch -> field3[i]);
+    }
+
+    if (group.count > 0) {
+        key_write(outfile, field, field1_str(&batch -> field1[first]), batch -> field2[first], batch -> field3[first]);
+        group_write(outfile, &group);
+        n_groups++;
+    }
+
+    return n_groups;
+}
+
+// Compares the key of a record with the key of the current group, in the order of the sort
+static int key_compare(size_t field, const char* key_field1, int key_field2, double key_field3, const char* field1, int field2, double field3) {
+    switch (field) {
+        case 1:
+            return strcmp(field1, key_field1);
+
+        case 2:
+            return (field2 > key_field2) - (field2 < key_field2);
+
+        default:
+            return (field3 > key_field3) - (field3 < key_field3);
+    }
+}
+
+int group_sorted_records(FILE* sorted_csv, FILE* outfile, size_t field, size_t* n_groups) {
+    char line[RECORD_LINE_BUFFER_SIZE];
+    char key_field1[MAX_FIELD1_SIZE] = "";
+    int key_field2 = 0;
+    double key_field3 = 0.0;
+    GroupAggregate group = { 0, 0, 0.0 };
+    int valid = 1;
+    int id;
+    char* field1;
+    int field2;
+    double field3;
+
+    *n_groups = 0;
+
+    while (fgets(line, RECORD_LINE_BUFFER_SIZE, sorted_csv)) {
+        if (parse_record_line(line, NULL, &id, &field1, &field2, &field3) != 1) {
+            valid = 0;
+            break;
+        }
+
+        int order = group.count > 0 ? key_compare(field, key_field1, key_field2, key_field3, field1, field2, field3) : 1;
+        if (order < 0) {
+            valid = 0;
+            break;
+        }
+
+        if (order != 0) {
+            if (group.count > 0) {
+                key_write(outfile, field, key_field1, key_field2, key_field3);
+                group_write(outfile, &group);
+                (*n_groups)++;
+            }
+
+            group = (GroupAggregate){ 0, 0, 0.0 };
+            snprintf(key_field1, sizeof(key_field1), "%s", field1);
+            key_field2 = field2;
+            key_field3 = field3;
+        }
+
+        group_add(&group, field2, field3);
+    }
+
+    // The group being read when the file is rejected may be incomplete
+    if (valid && group.count > 0) {
+        key_write(outfile, field, key_field1, key_field2, key_field3);
+        group_write(outfile, &group);
+        (*n_groups)++;
+    }
+
+    return valid;
+}
@@ -10,12 +10,44 @@
  * @section usage Usage
  * The application is executed with the following command:
  * ```
- * ./bin/main_ex1(.exe) <input_file> <output_file> <algorithm> <field>
+ * ./bin/main_ex1(.exe) <input_file> <output_file> <field> <algorithm> [options]
  * ```
  * - `<input_file>`: Path to the input CSV file.
  * - `<output_file>`: Path to the output CSV file (must be different from `<input_file>`).
- * - `<algorithm>`: Sorting algorithm to use (0 for merge sort, 1 for quick sort).
- * - `<field>`: Field to be used as the key for sorting (0 for `field1`, 1 for `field2`, 2 for `field3`).
+ * - `<field>`: Field to be used as the key for sorting (1 for `field1`, 2 for `field2`, 3 for `field3`).
+ * - `<algorithm>`: Sorting algorithm to use (1 for merge sort, 2 for quick sort, 3 for automatic choice).
+ *   The automatic choice picks, from a sample of the keys, between natural merge sort, radix sort, quick sort and merge sort.
+ * - `--threads=N` (optional): Number of threads formatting the sorted records (default: number of processors).
+ * - `--field1-prefix=STR`, `--field2-range=MIN:MAX`, `--field3-range=MIN:MAX` (optional): Filters applied while
+ *   the input is parsed; only the matching records are loaded, sorted and written.
+ * - `--index=PATH`, `--index-block=N` (optional): Write a sparse index sidecar of the sorted output, holding the
+ *   byte offset and key of the first line of every block of N lines.
+ * - `--io=uring|stdio` (optional): Read and write the files through io_uring, with several large requests in
+ *   flight, instead of stdio (falls back to stdio where io_uring is not available).
+ * - `--group-by` (optional): Aggregate the sorted records by key instead of writing them.
+ *
+ * A sorted file can then be searched by key range without scanning it:
+ * ```
+ * ./bin/main_ex1(.exe) lookup <sorted_file> <index_file> <low> [high]
+ * ```
+ *
+ * With `--group-by` the output holds one `key,count,field2_sum,field2_avg,field3_sum,field3_avg`
+ * line per distinct key instead of the records. A file already sorted by a field can be
+ * aggregated the same way, in one streaming pass:
+ * ```
+ * ./bin/main_ex1(.exe) group <sorted_file> <output_file> <field>
+ * ```
+ *
+ * Two files sorted by the same key (`id`, 1, 2 or 3) can be joined in one streaming pass,
+ * buffering only the right records that share the current key:
+ * ```
+ * ./bin/main_ex1(.exe) join <left_file> <right_file> <output_file> <key> [--left]
+ * ```
+ *
+ * Percentiles of field2 and field3 can be estimated in one multi-threaded pass, without sorting:
+ * ```
+ * ./bin/main_ex1(.exe) quantiles <input_file> [--threads=N] [--k=K] [--percentiles=50,90,99]
+ * ```
  *
  * Example:
  * ```
@@ -26,7 +58,13 @@
  *
  * - **main.c**: Contains the main entry point for the application. It handles command line argument parsing, input validation, sorting, and writing results to the output file.
  * - **algo.h**: Declares the `merge_sort` and `quick_sort` functions used for sorting arrays.
- * - **csv.h**: Provides the interface for functions related to reading and writing CSV records and defines the `Record` structure.
+ * - **auto_sort.h**: Chooses the sorting algorithm of a key column from a sample of its keys.
+ * - **group_by.h**: Aggregates sorted records by key in a single streaming pass.
+ * - **merge_join.h**: Joins two sorted files in a single streaming pass.
+ * - **quantile_sketch.h**: Estimates percentiles of the numeric fields with mergeable KLL sketches.
+ * - **csv.h**: Provides the interface for functions related to reading and writing CSV records and defines the `Record` and `RecordBatch` structures.
+ * - **sparse_index.h**: Builds, loads and searches the sparse index sidecars of sorted CSV files.
+ * - **async_io.h**: Sequential reader and writer backed by io_uring, with a stdio fallback.
  *
  * @section modules Modules and Functions
  *
@@ -35,15 +73,16 @@
  *   - `merge_sort`: A stable sorting algorithm implemented in `algo.h`.
  *   - `quick_sort`: A fast, in-place sorting algorithm implemented in `algo.h`.
  * - **CSV Operations**:
- *   - `read_records`: Reads CSV records from an input file.
- *   - `write_records`: Writes records to an output file in CSV format.
+ *   - `read_records` / `read_record_batch`: Reads CSV records from an input file.
+ *   - `sort_record_batch`: Sorts the key column of a `RecordBatch` into a permutation.
+ *   - `write_records` / `write_record_batch`: Writes records to an output file in CSV format.
  *   - `count_lines`: Counts the number of records (lines) in a CSV file.
  *
  * @section record_structure Record Structure
  *
  * The `Record` structure represents a record with the following fields:
  * - `id` (integer)
- * - `field1` (string)
+ * - `field1` (string, stored inline when at most 15 characters long, on the heap otherwise)
  * - `field2` (integer)
  * - `field3` (double)
  *
@@ -56,7 +95,7 @@
  *
  * @section sorting_details Sorting Logic
  *
- * The `compare_records` function pointer is set to one of the field comparison functions (`compare_field1`, `compare_field2`, or `compare_field3`), depending on the `field` argument provided by the user.
+ * The records are loaded column by column into a `RecordBatch` (struct-of-arrays). Sorting copies only the key column selected by the `field` argument, paired with the record indices (`Field1Key`, `Field2Key` or `Field3Key`), and sorts it with `compare_field1_key`, `compare_field2_key` or `compare_field3_key`. The resulting permutation is used to gather the columns when the records are written.
  *
  * @section error_handling Error Handling
  *
@@ -86,26 +125,204 @@
 
 #include "error_logger.h"
 #include "algo.h"
+#include "auto_sort.h"
+#include "group_by.h"
+#include "merge_join.h"
+#include "quantile_sketch.h"
 #include "csv.h"
+#include "sparse_index.h"
+#include "async_io.h"
 #include <time.h>
 #include <string.h>
 #include <stdint.h>
 #include <inttypes.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <limits.h>
+#include <math.h>
+#include <unistd.h>
+
+
+/**
+ * @brief Optional settings of a sorting run.
+ *
+ * These settings are parsed from the `--name=value` arguments that may follow
+ * the four mandatory ones.
+ */
+typedef struct _SortOptions {
+    size_t n_threads;    ///< Number of threads used to format the output records.
+    int has_filter;      ///< Non-zero if at least one predicate of `filter` is enabled.
+    RecordFilter filter; ///< Predicates pushed down into the CSV reader.
+    const char* index_path; ///< Path of the sparse index sidecar to build, or NULL.
+    size_t index_block_size; ///< Number of lines per block of the sparse index.
+    int use_uring;       ///< Non-zero to read and write the files through io_uring.
+    int group_by;        ///< Non-zero to write one aggregated line per key instead of the records.
+
+} SortOptions;
+
+/**
+ * @brief Returns the number of online processors, or 1 if it cannot be determined.
+ *
+ * @return The default number of worker threads.
+ */
+size_t default_thread_count(void) {
+#ifdef _SC_NPROCESSORS_ONLN
+    long n_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n_processors > 0)
+        return (size_t)n_processors;
+#endif
+
+    return 1;
+}
+
+/**
+ * @brief Parses a `MIN:MAX` range of integers, where either bound may be omitted.
+ *
+ * @param value The range to parse.
+ * @param min Pointer where the lower bound is stored (`INT_MIN` if omitted).
+ * @param max Pointer where the upper bound is stored (`INT_MAX` if omitted).
+ * @return 1 if the range is valid, 0 if it is malformed, inverted or a bound does not fit in an int.
+ */
+int parse_int_range(const char* value, int* min, int* max) {
+    const char* colon = strchr(value, ':');
+    if (colon == NULL)
+        return 0;
+
+    char* end;
+    *min = INT_MIN;
+    *max = INT_MAX;
+
+    if (colon != value && (parse_int(value, &end, min) != 0 || end != colon))
+        return 0;
+
+    if (colon[1] != '\0' && (parse_int(colon + 1, &end, max) != 0 || *end != '\0'))
+        return 0;
+
+    return *min <= *max;
+}
+
+/**
+ * @brief Parses a `MIN:MAX` range of doubles, where either bound may be omitted.
+ *
+ * @param value The range to parse.
+ * @param min Pointer where the lower bound is stored (`-HUGE_VAL` if omitted).
+ * @param max Pointer where the upper bound is stored (`HUGE_VAL` if omitted).
+ * @return 1 if the range is valid, 0 otherwise.
+ */
+int parse_double_range(const char* value, double* min, double* max) {
+    const char* colon = strchr(value, ':');
+    if (colon == NULL)
+        return 0;
 
+    char* end;
+    *min = -HUGE_VAL;
+    *max = HUGE_VAL;
+
+    if (colon != value) {
+        *min = strtod(value, &end);
+        if (end != colon)
+            return 0;
+    }
+
+    if (colon[1] != '\0') {
+        *max = strtod(colon + 1, &end);
+        if (*end != '\0')
+            return 0;
+    }
+
+    return *min <= *max;
+}
 
 /**
- * @brief Generic pointer to a comparison function for sorting records by different fields.
+ * @brief Parses the optional arguments of the program.
+ *
+ * Supported options:
+ * - `--threads=N`: number of threads used to format the output (default: number of processors).
+ * - `--field1-prefix=STR`: keep only the records whose field1 starts with `STR`.
+ * - `--field2-range=MIN:MAX`: keep only the records with `MIN <= field2 <= MAX`.
+ * - `--field3-range=MIN:MAX`: keep only the records with `MIN <= field3 <= MAX`.
+ * - `--index=PATH`: build a sparse index of the sorted output in `PATH`.
+ * - `--index-block=N`: number of lines per block of the sparse index (default: `DEFAULT_INDEX_BLOCK_SIZE`).
+ * - `--io=uring|stdio`: backend of the input and output files (default: `stdio`).
+ * - `--group-by`: write, for every distinct key, the number of records and the sum and
+ *   average of field2 and field3 instead of the sorted records.
  *
- * This global pointer is used to store the address of a comparison function that is chosen in main
+ * Either bound of a range may be omitted (e.g. `--field2-range=10:`).
  *
- * @param a Pointer to the first record.
- * @param b Pointer to the second record.
- * @return A negative value if the first record is less than the second, zero if they are equal,
- *         and a positive value if the first record is greater than the second.
+ * @param argc Number of optional arguments.
+ * @param argv Array of optional arguments.
+ * @param options Pointer to the options to fill.
+ * @throw `EXIT_FAILURE` if an option is unknown or has an invalid value.
  */
-int (*compare_records)(const void* a, const void* b);
+void parse_options(int argc, char* argv[], SortOptions* options) {
+    memset(options, 0, sizeof(SortOptions));
+    options -> n_threads = default_thread_count();
+    options -> index_block_size = DEFAULT_INDEX_BLOCK_SIZE;
+
+    for (int i = 0; i < argc; i++) {
+        if (strncmp(argv[i], "--threads=", strlen("--threads=")) == 0) {
+            int n_threads = atoi(argv[i] + strlen("--threads="));
+            if (n_threads < 1) {
+                print_error("invalid number of threads (expected a positive integer) -> %s", argv[i]);
+                exit(EXIT_FAILURE);
+            }
+
+            options -> n_threads = (size_t)n_threads;
+        }
+        else if (strncmp(argv[i], "--field1-prefix=", strlen("--field1-prefix=")) == 0) {
+            options -> filter.field1_prefix = argv[i] + strlen("--field1-prefix=");
+            options -> has_filter = 1;
+        }
+        else if (strncmp(argv[i], "--field2-range=", strlen("--field2-range=")) == 0) {
+            if (!parse_int_range(argv[i] + strlen("--field2-range="), &options -> filter.field2_min, &options -> filter.field2_max)) {
+                print_error("invalid field2 range (expected MIN:MAX) -> %s", argv[i]);
+                exit(EXIT_FAILURE);
+            }
+
+            options -> filter.has_field2_range = 1;
+            options -> has_filter = 1;
+        }
+        else if (strncmp(argv[i], "--field3-range=", strlen("--field3-range=")) == 0) {
+            if (!parse_double_range(argv[i] + strlen("--field3-range="), &options -> filter.field3_min, &options -> filter.field3_max)) {
+                print_error("invalid field3 range (expected MIN:MAX) -> %s", argv[i]);
+                exit(EXIT_FAILURE);
+            }
+
+            options -> filter.has_field3_range = 1;
+            options -> has_filter = 1;
+        }
+        else if (strncmp(argv[i], "--index=", strlen("--index=")) == 0) {
+            options -> index_path = argv[i] + strlen("--index=");
+        }
+        else if (strncmp(argv[i], "--index-block=", strlen("--index-block=")) == 0) {
+            int block_size = atoi(argv[i] + strlen("--index-block="));
+            if (block_size < 1) {
+                print_error("invalid index block size (expected a positive integer) -> %s", argv[i]);
+                exit(EXIT_FAILURE);
+            }
+
+            options -> index_block_size = (size_t)block_size;
+        }
+        else if (strcmp(argv[i], "--io=uring") == 0) {
+            options -> use_uring = 1;
+        }
+        else if (strcmp(argv[i], "--io=stdio") == 0) {
+            options -> use_uring = 0;
+        }
+        else if (strcmp(argv[i], "--group-by") == 0) {
+            options -> group_by = 1;
+        }
+        else {
+            print_error("unknown option -> %s", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (options -> group_by && options -> index_path) {
+        print_error("--index cannot be used with --group-by, whose output is not made of records");
+        exit(EXIT_FAILURE);
+    }
+}
 
 /**
  * @brief Validates the input arguments.
@@ -116,7 +333,7 @@ int (*compare_records)(const void* a, const void* b);
  *
  * @param input_file Path to the input file.
  * @param output_file Path to the output file.
- * @param algorithm Algorithm to be used (1 for merge sort, 2 for quick sort).
+ * @param algorithm Algorithm to be used (1 for merge sort, 2 for quick sort, 3 for automatic choice).
  * @param field Field to be used as the key for sorting (1 for field1, 2 for field2, 3 for field3).
  * @throw `EXIT_FAILURE` if any of the input arguments is invalid.
  */
@@ -166,12 +383,12 @@ void validate_input(char* input_file, char* output_file, char* field, char* algo
     }
 
     int algo = atoi(algorithm);
-    if (algo != 1 && algo != 2) {
+    if (algo < 1 || algo > 3) {
         fclose(input);
         fclose(output);
 
         print_error(
-            "invalid algorithm (expected 1 or 2) -> %s",
+            "invalid algorithm (expected 1, 2, or 3) -> %s",
             algorithm
         );
         exit(EXIT_FAILURE);
@@ -181,87 +398,602 @@ void validate_input(char* input_file, char* output_file, char* field, char* algo
     fclose(output);
 }
 
+/**
+ * @brief Computes the sorted order of a RecordBatch, reporting the time spent.
+ *
+ * @param batch Pointer to the batch to sort.
+ * @param field Field to be used as the key for sorting (1 for field1, 2 for field2, 3 for field3).
+ * @param algo Algorithm to be used (1 for merge sort, 2 for quick sort, 3 for automatic choice).
+ * @return The permutation returned by `sort_record_batch`.
+ * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
+ */
+size_t* sort_batch(const RecordBatch* batch, size_t field, size_t algo) {
+    time_t start;
+    time_t end;
+    size_t* permutation;
+
+    if (algo == 3) {
+        KeyProfile profile;
+        SortStrategy strategy;
+
+        printf("Sorting records with the algorithm fitting the keys...\n");
+
+        start = time(NULL);
+        permutation = auto_sort_record_batch(batch, field, &profile, &strategy);
+        end = time(NULL);
+
+        printf(
+            "Sampled %zu keys: %.1f%% descents, %.1f%% duplicates -> %s.\n",
+            profile.n_sampled,
+            100 * profile.descent_ratio,
+            100 * profile.duplicate_ratio,
+            sort_strategy_name(strategy)
+        );
+    }
+    else {
+        printf("Sorting records with %s_sort...\n", algo == 2 ? "quick" : "merge");
+
+        start = time(NULL);
+        permutation = sort_record_batch(batch, field, algo == 2 ? quick_sort : merge_sort);
+        end = time(NULL);
+    }
+
+    printf("Sorted records in %" PRId64 " seconds.\n", end - start);
+
+    return permutation;
+}
+
+/**
+ * @brief Writes the aggregates of every group of a sorted RecordBatch, reporting the time spent.
+ *
+ * @param outfile Pointer to the output file.
+ * @param batch Pointer to the batch.
+ * @param permutation Sorted order of the records.
+ * @param field Field the records are grouped by (1 for field1, 2 for field2, 3 for field3).
+ */
+void write_groups(FILE* outfile, const RecordBatch* batch, const size_t* permutation, size_t field) {
+    printf("Aggregating %zu sorted records by field%zu...\n", batch -> n_records, field);
+
+    time_t start = time(NULL);
+    size_t n_groups = write_record_groups(outfile, batch, permutation, field);
+    time_t end = time(NULL);
+
+    printf("Wrote %zu groups in %" PRId64 " seconds.\n", n_groups, end - start);
+}
+
 /**
  * @brief Sorts the records in the input file and writes them to the output file.
  *
- * This function reads the records from the input file, sorts them using the specified
- * algorithm, and writes the sorted records to the output file.
+ * This function reads the records from the input file into a columnar RecordBatch,
+ * sorts a permutation of the records on the key column using the specified algorithm,
+ * and writes the records to the output file following that permutation.
  *
  * @param infile Pointer to the input file.
  * @param outfile Pointer to the output file.
  * @param field Field to be used as the key for sorting (1 for field1, 2 for field2, 3 for field3).
- * @param algo Algorithm to be used (1 for merge sort, 2 for quick sort).
+ * @param algo Algorithm to be used (1 for merge sort, 2 for quick sort, 3 for automatic choice).
+ * @param options Optional settings of the run.
  * @throw `EXIT_FAILURE` if an error occurs during memory allocation.
  */
-void sort_records(FILE *infile, FILE *outfile, size_t field, size_t algo) {
-    switch (field) {
-        case 1:
-            compare_records = compare_field1;
-            break;
+void sort_records(FILE *infile, FILE *outfile, size_t field, size_t algo, const SortOptions* options) {
+    printf("\nSorting by field%zu...\n", field);
 
-        case 2:
-            compare_records = compare_field2;
-            break;
+    time_t start;
+    time_t end;
+    RecordBatch batch;
+    size_t n_read_records;
 
-        case 3:
-            compare_records = compare_field3;
-            break;
+    if (options -> has_filter) {
+        // The number of matching records is unknown: let the batch grow while reading
+        record_batch_init(&batch, 0);
 
-        default:
-            break;
+        printf("Reading matching records...\n");
+
+        start = time(NULL);
+        n_read_records = read_record_batch(infile, &batch, SIZE_MAX, &options -> filter);
     }
+    else {
+        size_t n_records = count_lines(infile);
+        record_batch_init(&batch, n_records);
 
-    printf("\nSorting by field%zu...\n", field);
+        printf("Reading %zu records...\n", n_records);
 
-    size_t n_records = count_lines(infile);
-    time_t start;
-    time_t end;
+        start = time(NULL);
+        n_read_records = read_record_batch(infile, &batch, n_records, NULL);
+    }
+    end = time(NULL);
 
-    RecordPtr records = (RecordPtr) malloc(n_records * sizeof(Record));
-    if (!records){
-        print_error("Memory allocation failed");
-        exit(EXIT_FAILURE);
+    printf("Read %zu records in %" PRId64 " seconds.\n", n_read_records, end - start);
+
+    size_t* permutation = sort_batch(&batch, field, algo);
+
+    if (options -> group_by) {
+        write_groups(outfile, &batch, permutation, field);
+
+        free(permutation);
+        record_batch_free(&batch);
+        return;
     }
 
-    printf("Reading %zu records...\n", n_records);
+    printf("Writing %zu sorted records with %zu threads...\n", n_read_records, options -> n_threads);
 
     start = time(NULL);
-    size_t n_read_records = read_records(infile, records, n_records);
+    size_t n_wrote_records = write_record_batch_parallel(outfile, &batch, permutation, n_read_records, options -> n_threads);
     end = time(NULL);
 
+    printf("Wrote %zu records in %" PRId64 " seconds.\n", n_wrote_records, end - start);
+
+    free(permutation);
+    record_batch_free(&batch);
+}
+
+/**
+ * @brief Same as `sort_records`, reading and writing the files through io_uring.
+ *
+ * The input is read in large blocks with several reads in flight, so the number of
+ * records is not counted beforehand: the batch grows while reading. The sorted records
+ * are formatted in chunks and handed to a writer keeping several writes in flight.
+ * Either file falls back to stdio if io_uring is not available.
+ *
+ * @param input_file Path to the input file.
+ * @param output_file Path to the output file.
+ * @param field Field to be used as the key for sorting (1 for field1, 2 for field2, 3 for field3).
+ * @param algo Algorithm to be used (1 for merge sort, 2 for quick sort, 3 for automatic choice).
+ * @param options Optional settings of the run.
+ * @throw `EXIT_FAILURE` if a file cannot be opened or written, or if an error occurs during memory allocation.
+ */
+void sort_records_async(const char* input_file, const char* output_file, size_t field, size_t algo, const SortOptions* options) {
+    printf("\nSorting by field%zu...\n", field);
+
+    AsyncReader* reader = async_reader_open(input_file, 1, ASYNC_IO_BLOCK_SIZE, ASYNC_IO_QUEUE_DEPTH);
+    if (!reader) {
+        print_error("input file does not exist -> %s", input_file);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("Reading records (%s)...\n", async_reader_backend(reader) == ASYNC_IO_URING ? "io_uring" : "stdio");
+
+    RecordBatch batch;
+    record_batch_init(&batch, 0);
+
+    time_t start = time(NULL);
+    size_t n_read_records = read_record_batch_async(reader, &batch, SIZE_MAX, options -> has_filter ? &options -> filter : NULL);
+    time_t end = time(NULL);
+
+    async_reader_close(reader);
+
     printf("Read %zu records in %" PRId64 " seconds.\n", n_read_records, end - start);
 
-    printf("Sorting records with %s_sort...\n", algo == 2 ? "quick" : "merge");
+    size_t* permutation = sort_batch(&batch, field, algo);
 
-    start = time(NULL);
-    switch (algo) {
-        case 1:
-            merge_sort(records, n_read_records, sizeof(Record), compare_records);
-            break;
+    // The aggregated output is small: it is written through stdio
+    if (options -> group_by) {
+        FILE* outfile = fopen(output_file, "w");
+        if (!outfile) {
+            print_error("output file cannot be created -> %s", output_file);
+            exit(EXIT_FAILURE);
+        }
 
-        case 2:
-            quick_sort(records, n_read_records, sizeof(Record), compare_records);
-            break;
+        write_groups(outfile, &batch, permutation, field);
+        fclose(outfile);
 
-        default:
-            break;
+        free(permutation);
+        record_batch_free(&batch);
+        return;
     }
-    end = time(NULL);
 
-    printf("Sorted records in %" PRId64 " seconds.\n", end - start);
+    AsyncWriter* writer = async_writer_open(output_file, 1, ASYNC_IO_BLOCK_SIZE, ASYNC_IO_QUEUE_DEPTH);
+    if (!writer) {
+        print_error("output file cannot be created -> %s", output_file);
+        exit(EXIT_FAILURE);
+    }
 
-    printf("Writing %zu sorted records...\n", n_read_records);
+    printf(
+        "Writing %zu sorted records with %zu threads (%s)...\n",
+        n_read_records,
+        options -> n_threads,
+        async_writer_backend(writer) == ASYNC_IO_URING ? "io_uring" : "stdio"
+    );
 
     start = time(NULL);
-    size_t n_wrote_records = write_records(outfile, records, n_read_records);
+    size_t n_wrote_records = write_record_batch_async(writer, &batch, permutation, n_read_records, options -> n_threads);
+    if (async_writer_close(writer) != 0) {
+        print_error("output file cannot be written -> %s", output_file);
+        exit(EXIT_FAILURE);
+    }
     end = time(NULL);
 
     printf("Wrote %zu records in %" PRId64 " seconds.\n", n_wrote_records, end - start);
 
-    for (size_t i = 0; i < n_read_records; i++)
-        free(records[i].field1);
+    free(permutation);
+    record_batch_free(&batch);
+}
+
+/**
+ * @brief Builds the sparse index sidecar of the sorted output file.
+ *
+ * @param output_file Path to the sorted output file, already flushed.
+ * @param field Field the output file is sorted by.
+ * @param options Optional settings of the run, holding the index path and block size.
+ * @throw `EXIT_FAILURE` if one of the files cannot be opened.
+ */
+void index_sorted_output(const char* output_file, size_t field, const SortOptions* options) {
+    FILE* sorted_csv = fopen(output_file, "r");
+    if (!sorted_csv) {
+        print_error("output file cannot be read back -> %s", output_file);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE* index_file = fopen(options -> index_path, "w");
+    if (!index_file) {
+        fclose(sorted_csv);
+
+        print_error("index file cannot be created -> %s", options -> index_path);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("Indexing sorted records every %zu lines...\n", options -> index_block_size);
+
+    time_t start = time(NULL);
+    size_t n_entries = build_sparse_index(sorted_csv, index_file, field, options -> index_block_size);
+    time_t end = time(NULL);
 
-    free(records);
+    printf("Wrote %zu index entries in %" PRId64 " seconds.\n", n_entries, end - start);
+
+    fclose(index_file);
+    fclose(sorted_csv);
+}
+
+/**
+ * @brief Prints the records of a sorted file whose key lies in a range, using its sparse index.
+ *
+ * Arguments: `<sorted_file> <index_file> <low> [high]`; when `high` is omitted the lookup
+ * returns the records whose key equals `low`. The matching lines are written to stdout.
+ *
+ * @param argc Number of arguments of the lookup command.
+ * @param argv Arguments of the lookup command.
+ * @return `EXIT_SUCCESS` if the lookup was performed.
+ * @throw `EXIT_FAILURE` if the files cannot be opened or the keys are invalid.
+ */
+int lookup_records(int argc, char* argv[]) {
+    if (argc != 3 && argc != 4) {
+        print_error("lookup expects <sorted_file> <index_file> <low> [high]");
+        exit(EXIT_FAILURE);
+    }
+
+    FILE* sorted_csv = fopen(argv[0], "r");
+    if (!sorted_csv) {
+        print_error("sorted file does not exist -> %s", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE* index_file = fopen(argv[1], "r");
+    if (!index_file) {
+        fclose(sorted_csv);
+
+        print_error("index file does not exist -> %s", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    SparseIndex index;
+    if (!load_sparse_index(index_file, &index)) {
+        fclose(index_file);
+        fclose(sorted_csv);
+
+        print_error("invalid index file -> %s", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    fclose(index_file);
+
+    Record low;
+    Record high;
+    const char* high_text = argc == 4 ? argv[3] : argv[2];
+    if (!parse_index_key(index.field, argv[2], &low) || !parse_index_key(index.field, high_text, &high)) {
+        sparse_index_free(&index);
+        fclose(sorted_csv);
+
+        print_error("invalid key for field%zu -> %s", index.field, high_text);
+        exit(EXIT_FAILURE);
+    }
+
+    if (compare_index_keys(index.field, &low, &high) > 0) {
+        field1_free(&low.field1);
+        field1_free(&high.field1);
+        sparse_index_free(&index);
+        fclose(sorted_csv);
+
+        print_error("invalid key range: %s is greater than %s", argv[2], high_text);
+        exit(EXIT_FAILURE);
+    }
+
+    sparse_index_lookup(sorted_csv, &index, &low, &high, stdout);
+
+    field1_free(&low.field1);
+    field1_free(&high.field1);
+    sparse_index_free(&index);
+    fclose(sorted_csv);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Aggregates the records of a file already sorted by the grouping field.
+ *
+ * Arguments: `<sorted_file> <output_file> <field>`. The sorted file is streamed once,
+ * so it can be the output of a previous run or of any external sort, whatever its size.
+ *
+ * @param argc Number of arguments of the group command.
+ * @param argv Arguments of the group command.
+ * @return `EXIT_SUCCESS` if the aggregation was performed.
+ * @throw `EXIT_FAILURE` if the files cannot be opened, the field is invalid or the file is not sorted by it.
+ */
+int group_records(int argc, char* argv[]) {
+    if (argc != 3) {
+        print_error("group expects <sorted_file> <output_file> <field>");
+        exit(EXIT_FAILURE);
+    }
+
+    int field = atoi(argv[2]);
+    if (field < 1 || field > 3) {
+        print_error("invalid field (expected 1, 2, or 3) -> %s", argv[2]);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE* sorted_csv = fopen(argv[0], "r");
+    if (!sorted_csv) {
+        print_error("sorted file does not exist -> %s", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE* outfile = fopen(argv[1], "w");
+    if (!outfile) {
+        fclose(sorted_csv);
+
+        print_error("output file cannot be created -> %s", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    size_t n_groups;
+    time_t start = time(NULL);
+    int grouped = group_sorted_records(sorted_csv, outfile, (size_t)field, &n_groups);
+    time_t end = time(NULL);
+
+    if (!grouped) {
+        fclose(outfile);
+        fclose(sorted_csv);
+
+        print_error("the input file has a malformed line or is not sorted by field%d -> %s", field, argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("Wrote %zu groups in %" PRId64 " seconds.\n", n_groups, end - start);
+
+    fclose(outfile);
+    fclose(sorted_csv);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Joins two files sorted by the same key in a single streaming pass.
+ *
+ * Arguments: `<left_file> <right_file> <output_file> <key> [--left]`, where `key` is `id`,
+ * `1`, `2` or `3`. The join is an inner join unless `--left` is given.
+ *
+ * @param argc Number of arguments of the join command.
+ * @param argv Arguments of the join command.
+ * @return `EXIT_SUCCESS` if the join was performed.
+ * @throw `EXIT_FAILURE` if the files cannot be opened, the key is invalid or a file is not sorted by it.
+ */
+int join_records(int argc, char* argv[]) {
+    if ((argc != 4 && argc != 5) || (argc == 5 && strcmp(argv[4], "--left") != 0)) {
+        print_error("join expects <left_file> <right_file> <output_file> <key> [--left]");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t key = strcmp(argv[3], "id") == 0 ? 0 : (size_t)atoi(argv[3]);
+    if ((key == 0 && strcmp(argv[3], "id") != 0) || !join_key_compare(key)) {
+        print_error("invalid join key (expected id, 1, 2, or 3) -> %s", argv[3]);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE* left = fopen(argv[0], "r");
+    if (!left) {
+        print_error("left file does not exist -> %s", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE* right = fopen(argv[1], "r");
+    if (!right) {
+        fclose(left);
+
+        print_error("right file does not exist -> %s", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    FILE* outfile = fopen(argv[2], "w");
+    if (!outfile) {
+        fclose(left);
+        fclose(right);
+
+        print_error("output file cannot be created -> %s", argv[2]);
+        exit(EXIT_FAILURE);
+    }
+
+    setvbuf(left, NULL, _IOFBF, READING_BUFFER_SIZE);
+    setvbuf(right, NULL, _IOFBF, READING_BUFFER_SIZE);
+    setvbuf(outfile, NULL, _IOFBF, WRITING_BUFFER_SIZE);
+
+    JoinStats stats;
+    time_t start = time(NULL);
+    int sorted = merge_join(left, right, outfile, key, argc == 5 ? JOIN_LEFT : JOIN_INNER, &stats);
+    time_t end = time(NULL);
+
+    fclose(outfile);
+    fclose(right);
+    fclose(left);
+
+    if (!sorted) {
+        print_error("the input files are not sorted by the join key -> %s", argv[3]);
+        exit(EXIT_FAILURE);
+    }
+
+    printf(
+        "Joined %zu left and %zu right records into %zu rows in %" PRId64 " seconds (largest group: %zu).\n",
+        stats.n_left,
+        stats.n_right,
+        stats.n_rows,
+        end - start,
+        stats.max_group
+    );
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Prints approximate percentiles of field2 and field3 without sorting the file.
+ *
+ * Arguments: `<input_file> [--threads=N] [--k=K] [--percentiles=P1,P2,...]`. The file is
+ * read once by N threads, each sketching its own byte range with a KLL sketch of
+ * accuracy K (default: `KLL_DEFAULT_K`); the sketches are merged and queried for the
+ * percentiles (default: 50,90,95,99).
+ *
+ * @param argc Number of arguments of the quantiles command.
+ * @param argv Arguments of the quantiles command.
+ * @return `EXIT_SUCCESS` if the percentiles were computed.
+ * @throw `EXIT_FAILURE` if the file cannot be opened or an option is invalid.
+ */
+int quantile_records(int argc, char* argv[]) {
+    if (argc < 1) {
+        print_error("quantiles expects <input_file> [--threads=N] [--k=K] [--percentiles=P1,P2,...]");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t n_threads = default_thread_count();
+    size_t k = KLL_DEFAULT_K;
+    double percentiles[64] = { 50, 90, 95, 99 };
+    size_t n_percentiles = 4;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--threads=", strlen("--threads=")) == 0) {
+            int value = atoi(argv[i] + strlen("--threads="));
+            if (value < 1) {
+                print_error("invalid number of threads (expected a positive integer) -> %s", argv[i]);
+                exit(EXIT_FAILURE);
+            }
+
+            n_threads = (size_t)value;
+        }
+        else if (strncmp(argv[i], "--k=", strlen("--k=")) == 0) {
+            int value = atoi(argv[i] + strlen("--k="));
+            if (value < KLL_MIN_LEVEL_CAPACITY) {
+                print_error("invalid sketch accuracy (expected at least %d) -> %s", KLL_MIN_LEVEL_CAPACITY, argv[i]);
+                exit(EXIT_FAILURE);
+            }
+
+            k = (size_t)value;
+        }
+        else if (strncmp(argv[i], "--percentiles=", strlen("--percentiles=")) == 0) {
+            const char* text = argv[i] + strlen("--percentiles=");
+            char* end;
+
+            n_percentiles = 0;
+            do {
+                double value = strtod(text, &end);
+                if (end == text || value < 0 || value > 100 || n_percentiles == sizeof(percentiles) / sizeof(percentiles[0])) {
+                    print_error("invalid percentiles (expected up to 64 values in [0, 100]) -> %s", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+
+                percentiles[n_percentiles++] = value;
+                text = end + 1;
+            } while (*end == ',');
+
+            if (*end != '\0') {
+                print_error("invalid percentiles (expected up to 64 values in [0, 100]) -> %s", argv[i]);
+                exit(EXIT_FAILURE);
+            }
+        }
+        else {
+            print_error("unknown option -> %s", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    KllSketch sketches[2];
+
+    time_t start = time(NULL);
+    if (!sketch_csv_file(argv[0], n_threads, k, &sketches[0], &sketches[1])) {
+        print_error("input file does not exist -> %s", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    time_t end = time(NULL);
+
+    printf("Sketched %" PRIu64 " records with %zu threads in %" PRId64 " seconds.\n", sketches[0].n, n_threads, end - start);
+
+    for (size_t s = 0; s < 2; s++) {
+        printf("field%zu: min=%lf", s + 2, sketches[s].min);
+
+        for (size_t p = 0; p < n_percentiles; p++)
+            printf(", p%g=%lf", percentiles[p], kll_quantile(&sketches[s], percentiles[p] / 100));
+
+        printf(", max=%lf (%zu values retained)\n", sketches[s].max, sketches[s].n_retained);
+
+        kll_free(&sketches[s]);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Prints the usage of the program to stderr.
+ *
+ * @param program Name of the executable.
+ */
+void print_usage(const char* program) {
+    fprintf(
+        stderr,
+        "Usage:\n"
+        "  %s <input_file> <output_file> <field> <algorithm> [options]\n"
+        "  %s lookup <sorted_file> <index_file> <low> [high]\n"
+        "  %s group <sorted_file> <output_file> <field>\n"
+        "  %s join <left_file> <right_file> <output_file> <id|1|2|3> [--left]\n"
+        "  %s quantiles <input_file> [--threads=N] [--k=K] [--percentiles=P1,P2,...]\n\n"
+        "Options:\n"
+        "  <input_file>   path to the input file\n"
+        "  <output_file>  path to the output file (different from input_file)\n"
+        "  <field>        1 for field1 (string), 2 for field2 (int), 3 for field3 (double)\n"
+        "  <algorithm>    1 for merge sort, 2 for quick sort, 3 for automatic choice\n"
+        "  --threads=N             threads formatting the output (default: all)\n"
+        "  --field1-prefix=STR     keep records whose field1 starts with STR\n"
+        "  --field2-range=MIN:MAX  keep records with field2 in [MIN, MAX]\n"
+        "  --field3-range=MIN:MAX  keep records with field3 in [MIN, MAX]\n"
+        "  --index=PATH            write a sparse index of the output to PATH\n"
+        "  --index-block=N         lines per index block (default: %d)\n"
+        "  --io=uring|stdio        I/O backend of the input and output files (default: stdio)\n"
+        "  --group-by              write key,count,sum2,avg2,sum3,avg3 per key instead of records\n\n"
+        "Lookup:\n"
+        "  prints the lines of <sorted_file> whose key lies in [low, high]\n\n"
+        "Group:\n"
+        "  aggregates <sorted_file>, sorted by <field>, in a single streaming pass\n\n"
+        "Join:\n"
+        "  inner (or left) merge-join of two files sorted by the same key\n\n"
+        "Quantiles:\n"
+        "  approximate percentiles of field2 and field3 (KLL sketch, default k: %d)\n\n"
+        "Example:\n"
+        "  %s input.csv output.csv 1 2 --index=output.idx\n"
+        "  %s lookup output.csv output.idx alpha\n",
+        program,
+        program,
+        program,
+        program,
+        program,
+        DEFAULT_INDEX_BLOCK_SIZE,
+        KLL_DEFAULT_K,
+        program,
+        program
+    );
 }
 
 /**
@@ -277,43 +1009,57 @@ void sort_records(FILE *infile, FILE *outfile, size_t field, size_t algo) {
  *         `EXIT_FAILURE` if the input arguments are invalid.
  */
 int main(int argc, char* argv[]) {
-    if (argc != 5) {
-        print_error(
-            "Usage:\n"
-            "  %s <input_file> <output_file> <field> <algorithm>\n\n"
-            "Options:\n"
-            "  <input_file>   path to the input file\n"
-            "  <output_file>  path to the output file (different from input_file)\n"
-            "  <field>        1 for field1 (string), 2 for field2 (int), 3 for field3 (double)\n"
-            "  <algorithm>    1 for merge sort, 2 for quick sort\n"
-            "Example:\n"
-            "  %s input.csv output.csv 1 2\n",
-            argv[0],
-            argv[0]
-        );
+    if (argc >= 2 && strcmp(argv[1], "lookup") == 0)
+        return lookup_records(argc - 2, argv + 2);
+
+    if (argc >= 2 && strcmp(argv[1], "group") == 0)
+        return group_records(argc - 2, argv + 2);
+
+    if (argc >= 2 && strcmp(argv[1], "join") == 0)
+        return join_records(argc - 2, argv + 2);
+
+    if (argc >= 2 && strcmp(argv[1], "quantiles") == 0)
+        return quantile_records(argc - 2, argv + 2);
+
+    if (argc < 5) {
+        print_usage(argv[0]);
+        print_error("invalid number of arguments -> %d", argc - 1);
         exit(EXIT_FAILURE);
     }
 
     validate_input(argv[1], argv[2], argv[3], argv[4]);
 
-    FILE* infile = fopen(argv[1], "r");
-    FILE* outfile = fopen(argv[2], "w");
+    SortOptions options;
+    parse_options(argc - 5, argv + 5, &options);
+
     size_t field = atoi(argv[3]);
     size_t algo = atoi(argv[4]);
 
     time_t start = time(NULL);
-    sort_records(infile, outfile, field, algo);
-    time_t end = time(NULL);
 
-    printf("Total time in %" PRId64 " seconds.\n", end - start);
+    if (options.use_uring)
+        sort_records_async(argv[1], argv[2], field, algo, &options);
+    else {
+        FILE* infile = fopen(argv[1], "r");
+        FILE* outfile = fopen(argv[2], "w");
 
-    if (infile)
-        fclose(infile);
+        sort_records(infile, outfile, field, algo, &options);
 
-    fflush(outfile);
+        if (infile)
+            fclose(infile);
 
-    if (outfile)
-        fclose(outfile);
+        fflush(outfile);
+
+        if (outfile)
+            fclose(outfile);
+    }
+
+    if (options.index_path)
+        index_sorted_output(argv[2], field, &options);
+
+    time_t end = time(NULL);
+
+    printf("Total time in %" PRId64 " seconds.\n", end - start);
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+/**
+ * @file merge_join.c
+ * @brief Implementation of the streaming merge-join of two sorted CSV files.
+ */
+
+#include "merge_join.h"
+#include "error_logger.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+/**
+ * @brief Sequential reader of one side of the join, holding its current record.
+ */
+typedef struct _JoinReader {
+    FILE* file;
+    char line[RECORD_LINE_BUFFER_SIZE];
+    Record record;  ///< Current record, valid if `has_record`.
+    int has_record;
+    int unsorted;   ///< Non-zero if a record smaller than the previous one was found.
+    size_t n_read;
+
+} JoinReader;
+
+// Moves a reader to its next record, checking that the records come in order
+static void join_reader_next(JoinReader* reader, int (*compare)(const void*, const void*)) {
+    Record previous = reader -> record;
+    int had_record = reader -> has_record;
+    int id;
+    char* field1;
+    int field2;
+    double field3;
+
+    reader -> has_record = 0;
+
+    if (!reader -> unsorted && fgets(reader -> line, RECORD_LINE_BUFFER_SIZE, reader -> file)
+        && parse_record_line(reader -> line, NULL, &id, &field1, &field2, &field3) == 1) {
+        Record next;
+        next.id = id;
+        next.field2 = field2;
+        next.field3 = field3;
+        field1_set(&next.field1, field1);
+
+        if (had_record && compare(&previous, &next) > 0) {
+            reader -> unsorted = 1;
+            field1_free(&next.field1);
+        }
+        else {
+            reader -> record = next;
+            reader -> has_record = 1;
+            reader -> n_read++;
+        }
+    }
+
+    if (had_record)
+        field1_free(&previous.field1);
+}
+
+// Writes the fields of a record, followed by `end`
+static int write_join_record(FILE* outfile, const Record* record, const char* end) {
+    return fprintf(outfile, "%d,%s,%d,%lf%s", record -> id, field1_str(&record -> field1), record -> field2, record -> field3, end);
+}
+
+int (*join_key_compare(size_t key))(const void*, const void*) {
+    switch (key) {
+        case 0:
+            return compare_id;
+
+        case 1:
+            return compare_field1;
+
+        case 2:
+            return compare_field2;
+
+        case 3:
+            return compare_field3;
+
+        default:
+            return NULL;
+    }
+}
+
+int merge_join(FILE* left, FILE* right, FILE* outfile, size_t key, JoinType type, JoinStats* stats) {
+    int (*compare)(const void*, const void*) = join_key_compare(key);
+    if (!compare)
+        return 0;
+
+    JoinReader* readers = calloc(2, sizeof(JoinReader));
+    if (!readers) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    JoinReader* left_reader = &readers[0];
+    JoinReader* right_reader = &readers[1];
+    left_reader -> file = left;
+    right_reader -> file = right;
+
+    // Right records sharing the key of the current left record
+    Record* group = NULL;
+    size_t group_size = 0;
+    size_t group_capacity = 0;
+    JoinStats counters = { 0, 0, 0, 0 };
+
+    join_reader_next(left_reader, compare);
+    join_reader_next(right_reader, compare);
+
+    while (left_reader -> has_record) {
+        const Record* current = &left_reader -> record;
+
+        if (group_size == 0 || compare(current, &group[0]) != 0) {
+            for (size_t g = 0; g < group_size; g++)
+                field1_free(&group[g].field1);
+            group_size = 0;
+
+            while (right_reader -> has_record && compare(&right_reader -> record, current) < 0)
+                join_reader_next(right_reader, compare);
+
+            while (right_reader -> has_record && compare(&right_reader -> record, current) == 0) {
+                if (group_size == group_capacity) {
+                    group_capacity = group_capacity ? group_capacity * 2 : 16;
+
+                    Record* grown = realloc(group, group_capacity * sizeof(Record));
+                    if (!grown) {
+                        print_error("Memory allocation failed");
+                        exit(EXIT_FAILURE);
+                    }
+
+                    group = grown;
+                }
+
+                group[group_size] = right_reader -> record;
+                field1_set(&group[group_size].field1, field1_str(&right_reader -> record.field1));
+                group_size++;
+
+                join_reader_next(right_reader, compare);
+            }
+
+            if (group_size > counters.max_group)
+                counters.max_group = group_size;
+        }
+
+        for (size_t g = 0; g < group_size; g++) {
+            write_join_record(outfile, current, ",");
+            write_join_record(outfile, &group[g], "\n");
+            counters.n_rows++;
+        }
+
+        if (group_size == 0 && type == JOIN_LEFT) {
+            write_join_record(outfile, current, ",,,,\n");
+            counters.n_rows++;
+        }
+
+        join_reader_next(left_reader, compare);
+    }
+
+    int sorted = !left_reader -> unsorted && !right_reader -> unsorted;
+
+    counters.n_left = left_reader -> n_read;
+    counters.n_right = right_reader -> n_read;
+
+    if (stats)
+        *stats = counters;
+
+    for (size_t g = 0; g < group_size; g++)
+        field1_free(&group[g].field1);
+
+    free(group);
+    free(readers);
+
+    return sorted;
+}
@@ -0,0 +1,352 @@
+/**
+ * @file quantile_sketch.c
+ * @brief Implementation of the KLL quantile sketches and of the multi-threaded CSV sketching.
+ */
+
+#include "quantile_sketch.h"
+#include "algo.h"
+#include "csv.h"
+#include "error_logger.h"
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <pthread.h>
+
+
+// Compares two doubles
+static int compare_double(const void* a, const void* b) {
+    double valueA = *(const double*)a;
+    double valueB = *(const double*)b;
+
+    return (valueA > valueB) - (valueA < valueB);
+}
+
+// Returns the next pseudo-random value of a xorshift64 generator
+static uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+
+    return *state = x;
+}
+
+// Capacity of level h: k for the top level, shrinking by 2/3 per level below it
+static size_t level_capacity(const KllSketch* sketch, size_t h) {
+    size_t capacity = sketch -> k;
+
+    for (size_t depth = sketch -> n_levels - 1 - h; depth > 0 && capacity > KLL_MIN_LEVEL_CAPACITY; depth--)
+        capacity = (capacity * 2 + 2) / 3;
+
+    return capacity > KLL_MIN_LEVEL_CAPACITY ? capacity : KLL_MIN_LEVEL_CAPACITY;
+}
+
+// Sum of the capacities of all the levels
+static size_t total_capacity(const KllSketch* sketch) {
+    size_t total = 0;
+
+    for (size_t h = 0; h < sketch -> n_levels; h++)
+        total += level_capacity(sketch, h);
+
+    return total;
+}
+
+// Adds an empty level on top of the sketch
+static void add_level(KllSketchPtr sketch) {
+    size_t n_levels = sketch -> n_levels + 1;
+
+    double** levels = realloc(sketch -> levels, n_levels * sizeof(double*));
+    if (levels) sketch -> levels = levels;
+
+    size_t* sizes = realloc(sketch -> sizes, n_levels * sizeof(size_t));
+    if (sizes) sketch -> sizes = sizes;
+
+    size_t* capacities = realloc(sketch -> capacities, n_levels * sizeof(size_t));
+    if (capacities) sketch -> capacities = capacities;
+
+    if (!levels || !sizes || !capacities) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    sketch -> levels[n_levels - 1] = NULL;
+    sketch -> sizes[n_levels - 1] = 0;
+    sketch -> capacities[n_levels - 1] = 0;
+    sketch -> n_levels = n_levels;
+    sketch -> capacity = total_capacity(sketch);
+}
+
+// Appends a value to level h, growing its buffer if needed
+static void level_push(KllSketchPtr sketch, size_t h, double value) {
+    if (sketch -> sizes[h] == sketch -> capacities[h]) {
+        size_t capacity = sketch -> capacities[h] ? sketch -> capacities[h] * 2 : level_capacity(sketch, h) + 1;
+
+        double* level = realloc(sketch -> levels[h], capacity * sizeof(double));
+        if (!level) {
+            print_error("Memory allocation failed");
+            exit(EXIT_FAILURE);
+        }
+
+        sketch -> levels[h] = level;
+        sketch -> capacities[h] = capacity;
+    }
+
+    sketch -> levels[h][sketch -> sizes[h]++] = value;
+}
+
+// Sorts level h and promotes every other value, from a random offset, to level h + 1
+static void compact_level(KllSketchPtr sketch, size_t h) {
+    if (h + 1 == sketch -> n_levels)
+        add_level(sketch);
+
+    double* level = sketch -> levels[h];
+    size_t size = sketch -> sizes[h];
+
+    quick_sort(level, size, sizeof(double), compare_double);
+
+    // With an odd size the smallest value stays, so that an even number is compacted
+    size_t kept = size % 2;
+    size_t offset = next_random(&sketch -> random_state) & 1;
+
+    for (size_t i = kept + offset; i < size; i += 2)
+        level_push(sketch, h + 1, sketch -> levels[h][i]);
+
+    sketch -> sizes[h] = kept;
+    sketch -> n_retained -= (size - kept) / 2;
+}
+
+// Compacts the lowest full levels until the sketch fits in its capacity
+static void compress(KllSketchPtr sketch) {
+    while (sketch -> n_retained > sketch -> capacity) {
+        for (size_t h = 0; h < sketch -> n_levels; h++)
+            if (sketch -> sizes[h] >= level_capacity(sketch, h)) {
+                compact_level(sketch, h);
+                break;
+            }
+    }
+}
+
+void kll_init(KllSketchPtr sketch, size_t k, uint64_t seed) {
+    memset(sketch, 0, sizeof(KllSketch));
+
+    sketch -> k = k > KLL_MIN_LEVEL_CAPACITY ? k : KLL_MIN_LEVEL_CAPACITY;
+    sketch -> random_state = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    sketch -> min = NAN;
+    sketch -> max = NAN;
+
+    add_level(sketch);
+}
+
+void kll_free(KllSketchPtr sketch) {
+    for (size_t h = 0; h < sketch -> n_levels; h++)
+        free(sketch -> levels[h]);
+
+    free(sketch -> levels);
+    free(sketch -> sizes);
+    free(sketch -> capacities);
+
+    memset(sketch, 0, sizeof(KllSketch));
+}
+
+void kll_update(KllSketchPtr sketch, double value) {
+    if (sketch -> n == 0 || value < sketch -> min)
+        sketch -> min = value;
+
+    if (sketch -> n == 0 || value > sketch -> max)
+        sketch -> max = value;
+
+    level_push(sketch, 0, value);
+    sketch -> n++;
+    sketch -> n_retained++;
+
+    if (sketch -> n_retained > sketch -> capacity)
+        compress(sketch);
+}
+
+void kll_merge(KllSketchPtr sketch, const KllSketch* other) {
+    if (other -> n == 0)
+        return;
+
+    while (sketch -> n_levels < other -> n_levels)
+        add_level(sketch);
+
+    for (size_t h = 0; h < other -> n_levels; h++)
+        for (size_t i = 0; i < other -> sizes[h]; i++)
+            level_push(sketch, h, other -> levels[h][i]);
+
+    if (sketch -> n == 0 || other -> min < sketch -> min)
+        sketch -> min = other -> min;
+
+    if (sketch -> n == 0 || other -> max > sketch -> max)
+        sketch -> max = other -> max;
+
+    sketch -> n += other -> n;
+    sketch -> n_retained += other -> n_retained;
+
+    compress(sketch);
+}
+
+/**
+ * @brief Retained value with the number of values it stands for.
+ */
+typedef struct _WeightedValue {
+    double value;
+    uint64_t weight;
+
+} WeightedValue;
+
+// Compares two weighted values by value
+static int compare_weighted_value(const void* a, const void* b) {
+    return compare_double(&((const WeightedValue*)a) -> value, &((const WeightedValue*)b) -> value);
+}
+
+double kll_quantile(const KllSketch* sketch, double q) {
+    if (sketch -> n == 0)
+        return NAN;
+
+    if (q <= 0)
+        return sketch -> min;
+
+    if (q >= 1)
+        return sketch -> max;
+
+    WeightedValue* values = malloc(sketch -> n_retained * sizeof(WeightedValue));
+    if (!values) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t n_values = 0;
+    for (size_t h = 0; h < sketch -> n_levels; h++)
+        for (size_t i = 0; i < sketch -> sizes[h]; i++)
+            values[n_values++] = (WeightedValue){ sketch -> levels[h][i], (uint64_t)1 << h };
+
+    merge_sort(values, n_values, sizeof(WeightedValue), compare_weighted_value);
+
+    // The total weight may differ slightly from n after the compactions
+    uint64_t total = 0;
+    for (size_t i = 0; i < n_values; i++)
+        total += values[i].weight;
+
+    double target = q * total;
+    double result = values[n_values - 1].value;
+    uint64_t cumulative = 0;
+
+    for (size_t i = 0; i < n_values; i++) {
+        cumulative += values[i].weight;
+
+        if (cumulative >= target) {
+            result = values[i].value;
+            break;
+        }
+    }
+
+    free(values);
+
+    return result;
+}
+
+/**
+ * @brief Byte range of the CSV file sketched by a single thread.
+ */
+typedef struct _SketchTask {
+    const char* path;
+    long begin;
+    long end;
+    KllSketch field2;
+    KllSketch field3;
+
+} SketchTask;
+
+// Worker that sketches the lines starting in [begin, end) of the file
+static void* sketch_task_run(void* arg) {
+    SketchTask* task = (SketchTask*)arg;
+    char line[RECORD_LINE_BUFFER_SIZE];
+    int id;
+    char* field1;
+    int field2;
+    double field3;
+
+    FILE* file = fopen(task -> path, "r");
+    if (!file)
+        return NULL;
+
+    long position = task -> begin;
+
+    // A range starting inside a line leaves that line to the previous range
+    if (position > 0) {
+        fseek(file, position - 1, SEEK_SET);
+
+        int c = fgetc(file);
+        while (c != '\n' && c != EOF) {
+            c = fgetc(file);
+            position++;
+        }
+    }
+
+    while (position < task -> end && fgets(line, RECORD_LINE_BUFFER_SIZE, file)) {
+        position += (long)strlen(line);
+
+        if (parse_record_line(line, NULL, &id, &field1, &field2, &field3) != 1)
+            break;
+
+        kll_update(&task -> field2, field2);
+        kll_update(&task -> field3, field3);
+    }
+
+    fclose(file);
+
+    return NULL;
+}
+
+int sketch_csv_file(const char* path, size_t n_threads, size_t k, KllSketchPtr field2, KllSketchPtr field3) {
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return 0;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+
+    if (n_threads == 0)
+        n_threads = 1;
+
+    SketchTask* tasks = calloc(n_threads, sizeof(SketchTask));
+    pthread_t* threads = malloc(n_threads * sizeof(pthread_t));
+    if (!tasks || !threads) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t t = 0; t < n_threads; t++) {
+        tasks[t].path = path;
+        tasks[t].begin = (long)(size * (double)t / n_threads);
+        tasks[t].end = t + 1 == n_threads ? size : (long)(size * (double)(t + 1) / n_threads);
+        kll_init(&tasks[t].field2, k, 2 * t + 1);
+        kll_init(&tasks[t].field3, k, 2 * t + 2);
+
+        if (pthread_create(&threads[t], NULL, sketch_task_run, &tasks[t]) != 0) {
+            print_error("Thread creation failed");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    kll_init(field2, k, 0);
+    kll_init(field3, k, 0);
+
+    for (size_t t = 0; t < n_threads; t++) {
+        pthread_join(threads[t], NULL);
+
+        kll_merge(field2, &tasks[t].field2);
+        kll_merge(field3, &tasks[t].field3);
+
+        kll_free(&tasks[t].field2);
+        kll_free(&tasks[t].field3);
+    }
+
+    free(tasks);
+    free(threads);
+
+    return 1;
+}
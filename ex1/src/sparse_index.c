@@ -0,0 +1,232 @@
+/**
+ * @file sparse_index.c
+ * @brief Implementation of the sparse index sidecars of sorted CSV files.
+ */
+
+#include "sparse_index.h"
+#include "error_logger.h"
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+/**
+ * @brief Compares the key of a parsed line with a key parsed by `parse_index_key`.
+ *
+ * @param field Field the keys belong to.
+ * @param field1 field1 of the line.
+ * @param field2 field2 of the line.
+ * @param field3 field3 of the line.
+ * @param key The key to compare with.
+ * @return A negative value, zero or a positive value if the line's key is respectively
+ *         less than, equal to or greater than `key`.
+ */
+static int compare_line_key(size_t field, const char* field1, int field2, double field3, const Record* key) {
+    switch (field) {
+        case 1:
+            return strcmp(field1, field1_str(&key -> field1));
+
+        case 2:
+            return (field2 > key -> field2) - (field2 < key -> field2);
+
+        default:
+            return (field3 > key -> field3) - (field3 < key -> field3);
+    }
+}
+
+int compare_index_keys(size_t field, const Record* a, const Record* b) {
+    return compare_line_key(field, field1_str(&a -> field1), a -> field2, a -> field3, b);
+}
+
+int parse_index_key(size_t field, const char* text, Record* key) {
+    char* end;
+
+    memset(key, 0, sizeof(Record));
+
+    switch (field) {
+        case 1:
+            if (*text == '\0' || strlen(text) >= MAX_FIELD1_SIZE || strchr(text, ','))
+                return 0;
+
+            field1_set(&key -> field1, text);
+            return 1;
+
+        case 2: {
+            errno = 0;
+            long value = strtol(text, &end, 10);
+
+            key -> field2 = (int)value;
+            return end != text && *end == '\0' && errno != ERANGE && value >= INT_MIN && value <= INT_MAX;
+        }
+
+        case 3:
+            key -> field3 = strtod(text, &end);
+            return end != text && *end == '\0';
+
+        default:
+            return 0;
+    }
+}
+
+size_t build_sparse_index(FILE* sorted_csv, FILE* index_file, size_t field, size_t block_size) {
+    char line[RECORD_LINE_BUFFER_SIZE];
+    size_t n_lines = 0;
+    size_t n_entries = 0;
+    int id;
+    char* field1;
+    int field2;
+    double field3;
+
+    if (block_size == 0 || field < 1 || field > 3)
+        return 0;
+
+    fprintf(index_file, "%zu,%zu\n", field, block_size);
+
+    for (;;) {
+        long offset = ftell(sorted_csv);
+
+        if (!fgets(line, RECORD_LINE_BUFFER_SIZE, sorted_csv))
+            break;
+
+        if (n_lines++ % block_size != 0)
+            continue;
+
+        if (parse_record_line(line, NULL, &id, &field1, &field2, &field3) != 1)
+            break;
+
+        switch (field) {
+            case 1:
+                fprintf(index_file, "%ld,%s\n", offset, field1);
+                break;
+
+            case 2:
+                fprintf(index_file, "%ld,%d\n", offset, field2);
+                break;
+
+            default:
+                fprintf(index_file, "%ld,%.17g\n", offset, field3);
+                break;
+        }
+
+        n_entries++;
+    }
+
+    return n_entries;
+}
+
+int load_sparse_index(FILE* index_file, SparseIndexPtr index) {
+    char line[RECORD_LINE_BUFFER_SIZE];
+    size_t capacity = 64;
+
+    memset(index, 0, sizeof(SparseIndex));
+
+    if (fscanf(index_file, "%zu,%zu\n", &index -> field, &index -> block_size) != 2)
+        return 0;
+
+    if (index -> field < 1 || index -> field > 3 || index -> block_size == 0)
+        return 0;
+
+    index -> offsets = malloc(capacity * sizeof(long));
+    index -> keys = malloc(capacity * sizeof(Record));
+    if (!index -> offsets || !index -> keys) {
+        print_error("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    while (fgets(line, RECORD_LINE_BUFFER_SIZE, index_file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+
+        char* end;
+        long offset = strtol(line, &end, 10);
+        if (end == line || *end != ',')
+            break;
+
+        if (index -> n_entries == capacity) {
+            capacity *= 2;
+
+            long* offsets = realloc(index -> offsets, capacity * sizeof(long));
+            if (offsets) index -> offsets = offsets;
+
+            Record* keys = realloc(index -> keys, capacity * sizeof(Record));
+            if (keys) index -> keys = keys;
+
+            if (!offsets || !keys) {
+                print_error("Memory allocation failed");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if (!parse_index_key(index -> field, end + 1, &index -> keys[index -> n_entries]))
+            break;
+
+        index -> offsets[index -> n_entries++] = offset;
+    }
+
+    if (!feof(index_file)) {
+        sparse_index_free(index);
+        return 0;
+    }
+
+    return 1;
+}
+
+void sparse_index_free(SparseIndexPtr index) {
+    for (size_t i = 0; i < index -> n_entries; i++)
+        field1_free(&index -> keys[i].field1);
+
+    free(index -> offsets);
+    free(index -> keys);
+
+    memset(index, 0, sizeof(SparseIndex));
+}
+
+size_t sparse_index_lookup(FILE* sorted_csv, const SparseIndex* index, const Record* low, const Record* high, FILE* outfile) {
+    if (index -> n_entries == 0 || compare_index_keys(index -> field, low, high) > 0)
+        return 0;
+
+    // Find the first block whose first key is not less than low
+    size_t left = 0;
+    size_t right = index -> n_entries;
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+
+        if (compare_index_keys(index -> field, &index -> keys[mid], low) < 0)
+            left = mid + 1;
+        else
+            right = mid;
+    }
+
+    // Records equal to low may also end the previous block
+    size_t first_block = left > 0 ? left - 1 : 0;
+
+    if (fseek(sorted_csv, index -> offsets[first_block], SEEK_SET) != 0)
+        return 0;
+
+    char line[RECORD_LINE_BUFFER_SIZE];
+    char parsed[RECORD_LINE_BUFFER_SIZE];
+    size_t n_matches = 0;
+    int id;
+    char* field1;
+    int field2;
+    double field3;
+
+    while (fgets(line, RECORD_LINE_BUFFER_SIZE, sorted_csv)) {
+        memcpy(parsed, line, RECORD_LINE_BUFFER_SIZE);
+
+        if (parse_record_line(parsed, NULL, &id, &field1, &field2, &field3) != 1)
+            break;
+
+        if (compare_line_key(index -> field, field1, field2, field3, low) < 0)
+            continue;
+
+        if (compare_line_key(index -> field, field1, field2, field3, high) > 0)
+            break;
+
+        fputs(line, outfile);
+        n_matches++;
+    }
+
+    return n_matches;
+}
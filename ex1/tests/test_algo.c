@@ -3,7 +3,7 @@
  * @brief Unit tests for sorting algorithms using the Unity framework.
  *
  * This source file contains the implementation of test cases to validate
- * the correctness of `merge_sort` and `quick_sort` functions. 
+ * the correctness of `merge_sort`, `quick_sort` and `natural_merge_sort` functions. 
  */
 
 #include "algo.h"
@@ -24,6 +24,19 @@ static int int_cmp(const void *a, const void *b) {
     return *(int *)a - *(int *)b;
 }
 
+/**
+ * @brief Comparator function for the first integer of pairs of integers.
+ *
+ * The second integer records the original position, to check stability.
+ *
+ * @param a Pointer to the first pair.
+ * @param b Pointer to the second pair.
+ * @return Difference between the first integers of the two pairs.
+ */
+static int pair_cmp(const void *a, const void *b) {
+    return ((const int *)a)[0] - ((const int *)b)[0];
+}
+
 // -------------------------- Merge Sort Tests --------------------------
 
 void test_merge_sort(void) {
@@ -167,3 +180,29 @@ void test_quick_sort_negative_numbers(void) {
 
     TEST_ASSERT_EQUAL_INT_ARRAY(expected, arr, n);
 }
+
+// ---------------------- Natural Merge Sort Tests ----------------------
+
+void test_natural_merge_sort(void) {
+    // Runs: [3, 5, 5], [4, 2, 1] (descending), [2, 6, 7], [0]
+    int arr[][2] = {{3, 0}, {5, 1}, {5, 2}, {4, 3}, {2, 4}, {1, 5}, {2, 6}, {6, 7}, {7, 8}, {0, 9}};
+    int n = sizeof(arr) / sizeof(arr[0]);
+    int expected[][2] = {{0, 9}, {1, 5}, {2, 4}, {2, 6}, {3, 0}, {4, 3}, {5, 1}, {5, 2}, {6, 7}, {7, 8}};
+
+    natural_merge_sort(arr, n, sizeof(arr[0]), pair_cmp);
+
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, arr, 2 * n);
+}
+
+void test_natural_merge_sort_single_run(void) {
+    int sorted[] = {1, 2, 2, 3, 4, 5};
+    int reversed[] = {5, 4, 3, 2, 1};
+    int expected_reversed[] = {1, 2, 3, 4, 5};
+    int expected_sorted[] = {1, 2, 2, 3, 4, 5};
+
+    natural_merge_sort(sorted, 6, sizeof(int), int_cmp);
+    natural_merge_sort(reversed, 5, sizeof(int), int_cmp);
+
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected_sorted, sorted, 6);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected_reversed, reversed, 5);
+}
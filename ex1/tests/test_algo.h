@@ -128,4 +128,19 @@ void test_quick_sort_single_element(void);
  */
 void test_quick_sort_negative_numbers(void);
 
+/**
+ * @brief Test case for natural_merge_sort on an array made of ascending and descending runs.
+ *
+ * This test verifies that natural_merge_sort correctly sorts the array and
+ * keeps the relative order of equal elements.
+ */
+void test_natural_merge_sort(void);
+
+/**
+ * @brief Test case for natural_merge_sort on already sorted and reverse-sorted arrays.
+ *
+ * This test checks that a single run, ascending or descending, is sorted correctly.
+ */
+void test_natural_merge_sort_single_run(void);
+
 #endif  // _TEST_ALGO_H
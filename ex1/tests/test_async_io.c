@@ -0,0 +1,212 @@
+/**
+ * @file test_async_io.c
+ * @brief Unit tests for the io_uring-backed reader and writer.
+ * 
+ * This file contains the implementation of unit tests for the async I/O functions.
+ * The files are created in the working directory, since the reader and the writer
+ * work on paths, and removed at the end of each test.
+ */
+
+#include "test_async_io.h"
+#include "csv.h"
+#include "algo.h"
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/** @brief Path of the temporary file used by the tests. */
+static const char* temp_path = "test_async_io.tmp";
+
+/** @brief Path of the FIFO used by the tests, kept apart so that a failed run cannot block the other tests. */
+static const char* fifo_path = "test_async_io.fifo";
+
+/** @brief Mock CSV content, whose last line has no newline. */
+static const char* csv_content =
+    "1,Charlie,30,3.5\n"
+    "2,Alice,10,1.5\n"
+    "3,a field1 longer than the inline storage,20,2.5\n"
+    "4,Bob,40,4.5";
+
+/**
+ * @brief Utility function that writes a string to the temporary file.
+ * 
+ * @param content The content of the file.
+ */
+static void write_temp_file(const char* content) {
+    FILE* file = fopen(temp_path, "w");
+    TEST_ASSERT_NOT_NULL(file);
+
+    fputs(content, file);
+    fclose(file);
+}
+
+/**
+ * @brief Utility function that reads the whole temporary file into a string.
+ * 
+ * @param buffer Buffer receiving the content.
+ * @param size Size of the buffer.
+ */
+static void read_temp_file(char* buffer, size_t size) {
+    FILE* file = fopen(temp_path, "r");
+    TEST_ASSERT_NOT_NULL(file);
+
+    size_t length = fread(buffer, 1, size - 1, file);
+    buffer[length] = '\0';
+    fclose(file);
+}
+
+void test_async_reader_gets() {
+    char line[16];
+
+    write_temp_file(csv_content);
+
+    for (int use_uring = 0; use_uring <= 1; use_uring++) {
+        // Blocks of 7 bytes, so that every line spans several of them
+        AsyncReader* reader = async_reader_open(temp_path, use_uring, 7, 3);
+        TEST_ASSERT_NOT_NULL(reader);
+
+        TEST_ASSERT_EQUAL_STRING("1,Charlie,30,3.", async_reader_gets(line, sizeof(line), reader));
+        TEST_ASSERT_EQUAL_STRING("5\n", async_reader_gets(line, sizeof(line), reader));
+        TEST_ASSERT_EQUAL_STRING("2,Alice,10,1.5\n", async_reader_gets(line, sizeof(line), reader));
+        TEST_ASSERT_EQUAL_STRING("3,a field1 long", async_reader_gets(line, sizeof(line), reader));
+        TEST_ASSERT_EQUAL_STRING("er than the inl", async_reader_gets(line, sizeof(line), reader));
+        TEST_ASSERT_EQUAL_STRING("ine storage,20,", async_reader_gets(line, sizeof(line), reader));
+        TEST_ASSERT_EQUAL_STRING("2.5\n", async_reader_gets(line, sizeof(line), reader));
+        TEST_ASSERT_EQUAL_STRING("4,Bob,40,4.5", async_reader_gets(line, sizeof(line), reader));
+        TEST_ASSERT_NULL(async_reader_gets(line, sizeof(line), reader));
+
+        async_reader_close(reader);
+    }
+
+    remove(temp_path);
+}
+
+void test_async_reader_fifo() {
+#ifdef __linux__
+    char line[64];
+
+    remove(fifo_path);
+    TEST_ASSERT_EQUAL_INT(0, mkfifo(fifo_path, 0600));
+
+    pid_t child = fork();
+    TEST_ASSERT_TRUE(child >= 0);
+
+    if (child == 0) {
+        FILE* fifo = fopen(fifo_path, "w");
+        if (fifo)
+            fputs(csv_content, fifo);
+
+        _exit(fifo && fclose(fifo) == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    // A pipe has no size to split into reads, so the reader falls back to stdio
+    AsyncReader* reader = async_reader_open(fifo_path, 1, 7, 3);
+    TEST_ASSERT_NOT_NULL(reader);
+    TEST_ASSERT_EQUAL_INT(ASYNC_IO_STDIO, async_reader_backend(reader));
+
+    TEST_ASSERT_EQUAL_STRING("1,Charlie,30,3.5\n", async_reader_gets(line, sizeof(line), reader));
+    TEST_ASSERT_EQUAL_STRING("2,Alice,10,1.5\n", async_reader_gets(line, sizeof(line), reader));
+    TEST_ASSERT_EQUAL_STRING("3,a field1 longer than the inline storage,20,2.5\n", async_reader_gets(line, sizeof(line), reader));
+    TEST_ASSERT_EQUAL_STRING("4,Bob,40,4.5", async_reader_gets(line, sizeof(line), reader));
+    TEST_ASSERT_NULL(async_reader_gets(line, sizeof(line), reader));
+
+    async_reader_close(reader);
+
+    int status;
+    TEST_ASSERT_EQUAL_INT(child, waitpid(child, &status, 0));
+    TEST_ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+
+    remove(fifo_path);
+#else
+    TEST_IGNORE_MESSAGE("FIFOs are only tested on Linux");
+#endif
+}
+
+void test_async_writer_write() {
+    char expected[4096];
+    char actual[4096];
+
+    for (int use_uring = 0; use_uring <= 1; use_uring++) {
+        AsyncWriter* writer = async_writer_open(temp_path, use_uring, 5, 2);
+        TEST_ASSERT_NOT_NULL(writer);
+
+        size_t length = 0;
+        for (int i = 0; i < 200; i++) {
+            char piece[32];
+            int n = snprintf(piece, sizeof(piece), "%d:%.*s;", i, i % 7, "abcdefg");
+
+            TEST_ASSERT_EQUAL_size_t(n, async_writer_write(writer, piece, n));
+            memcpy(expected + length, piece, n);
+            length += n;
+        }
+        expected[length] = '\0';
+
+        TEST_ASSERT_EQUAL_INT(0, async_writer_close(writer));
+
+        read_temp_file(actual, sizeof(actual));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+    }
+
+    remove(temp_path);
+}
+
+void test_record_batch_async_round_trip() {
+    char expected[1024];
+    char actual[1024];
+    RecordBatch batch;
+
+    write_temp_file(csv_content);
+
+    // Reference output, through stdio
+    FILE* infile = fopen(temp_path, "r");
+    TEST_ASSERT_NOT_NULL(infile);
+
+    record_batch_init(&batch, 0);
+    TEST_ASSERT_EQUAL_size_t(4, read_record_batch(infile, &batch, SIZE_MAX, NULL));
+    fclose(infile);
+
+    size_t* permutation = sort_record_batch(&batch, 2, merge_sort);
+
+    FILE* outfile = tmpfile();
+    TEST_ASSERT_NOT_NULL(outfile);
+    write_record_batch(outfile, &batch, permutation, batch.n_records);
+    rewind(outfile);
+    expected[fread(expected, 1, sizeof(expected) - 1, outfile)] = '\0';
+    fclose(outfile);
+
+    free(permutation);
+    record_batch_free(&batch);
+
+    for (size_t n_threads = 1; n_threads <= 3; n_threads += 2) {
+        write_temp_file(csv_content);
+
+        AsyncReader* reader = async_reader_open(temp_path, 1, 16, 2);
+        TEST_ASSERT_NOT_NULL(reader);
+
+        record_batch_init(&batch, 0);
+        TEST_ASSERT_EQUAL_size_t(4, read_record_batch_async(reader, &batch, SIZE_MAX, NULL));
+        async_reader_close(reader);
+
+        permutation = sort_record_batch(&batch, 2, merge_sort);
+
+        AsyncWriter* writer = async_writer_open(temp_path, 1, 16, 2);
+        TEST_ASSERT_NOT_NULL(writer);
+        TEST_ASSERT_EQUAL_size_t(4, write_record_batch_async(writer, &batch, permutation, batch.n_records, n_threads));
+        TEST_ASSERT_EQUAL_INT(0, async_writer_close(writer));
+
+        read_temp_file(actual, sizeof(actual));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+
+        free(permutation);
+        record_batch_free(&batch);
+    }
+
+    remove(temp_path);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file test_async_io.h
+ * @brief Unit test declarations for the io_uring-backed reader and writer.
+ *
+ * This header file declares test cases for reading lines and writing data through
+ * an AsyncReader and an AsyncWriter, with both the io_uring and the stdio backends.
+ * 
+ * @see async_io.h
+ */
+
+#ifndef _TEST_ASYNC_IO_H
+#define _TEST_ASYNC_IO_H
+
+#include "async_io.h"
+#include "unity.h"
+
+
+/**
+ * @brief Test case for the `async_reader_gets` function.
+ *
+ * Verifies that lines spanning several blocks, lines longer than the buffer and a
+ * last line without newline are returned as `fgets` would, with both backends.
+ */
+void test_async_reader_gets();
+
+/**
+ * @brief Test case for `async_reader_open` on a FIFO.
+ *
+ * Verifies that a file which is not a regular file, and whose size is therefore
+ * unknown, is read through stdio in full instead of as an empty file.
+ */
+void test_async_reader_fifo();
+
+/**
+ * @brief Test case for the `async_writer_write` function.
+ *
+ * Verifies that data written in pieces of various sizes ends up in the file
+ * unchanged and in order, with both backends.
+ */
+void test_async_writer_write();
+
+/**
+ * @brief Test case for the `read_record_batch_async` and `write_record_batch_async` functions.
+ *
+ * Verifies that a batch read through an AsyncReader and written through an
+ * AsyncWriter in sorted order gives the same file as the stdio functions.
+ */
+void test_record_batch_async_round_trip();
+
+#endif // _TEST_ASYNC_IO_H
@@ -0,0 +1,168 @@
+/**
+ * @file test_auto_sort.c
+ * @brief Unit tests for the automatic choice of the sorting algorithm.
+ * 
+ * This file contains the implementation of unit tests for the auto_sort functions.
+ */
+
+#include "test_auto_sort.h"
+#include "algo.h"
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/**
+ * @brief Utility function that fills a batch with generated records.
+ *
+ * Record i gets `field2 = key(i)`, `field3 = key(i) / 4.0` and a field1 made of
+ * the decimal digits of `key(i)`.
+ * 
+ * @param batch Pointer to the batch to initialize and fill.
+ * @param n_records Number of records.
+ * @param key Generator of the key of each record.
+ */
+static void fill_batch(RecordBatch* batch, size_t n_records, int (*key)(size_t)) {
+    char field1[16];
+
+    record_batch_init(batch, n_records);
+
+    for (size_t i = 0; i < n_records; i++) {
+        int value = key(i);
+
+        snprintf(field1, sizeof(field1), "%d", value);
+
+        batch -> id[i] = (int)i;
+        field1_set(&batch -> field1[i], field1);
+        batch -> field2[i] = value;
+        batch -> field3[i] = value / 4.0;
+    }
+
+    batch -> n_records = n_records;
+}
+
+/** @brief Ascending keys. */
+static int sorted_key(size_t i) { return (int)i; }
+
+/** @brief Descending keys. */
+static int reversed_key(size_t i) { return -(int)i; }
+
+/** @brief Hashes an index into a pseudo-random 32-bit value. */
+static uint32_t mix(size_t i) {
+    uint32_t h = (uint32_t)i * 0x9E3779B9u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+
+    return h;
+}
+
+/** @brief Pseudo-random keys, mostly distinct, of both signs. */
+static int random_key(size_t i) { return (int)(mix(i) % 100003) - 50000; }
+
+/** @brief Pseudo-random keys among 8 values. */
+static int few_values_key(size_t i) { return (int)(mix(i) % 8); }
+
+/**
+ * @brief Utility function that asserts that a permutation lists the records of a batch in sorted order.
+ * 
+ * @param batch Pointer to the sorted batch.
+ * @param field Field the batch is sorted by.
+ * @param permutation The permutation to check.
+ */
+static void assert_sorted(const RecordBatch* batch, size_t field, const size_t* permutation) {
+    for (size_t k = 1; k < batch -> n_records; k++) {
+        size_t a = permutation[k - 1];
+        size_t b = permutation[k];
+
+        switch (field) {
+            case 1:
+                TEST_ASSERT_TRUE(field1_compare(&batch -> field1[a], &batch -> field1[b]) <= 0);
+                break;
+
+            case 2:
+                TEST_ASSERT_TRUE(batch -> field2[a] <= batch -> field2[b]);
+                break;
+
+            default:
+                TEST_ASSERT_TRUE(batch -> field3[a] <= batch -> field3[b]);
+                break;
+        }
+    }
+}
+
+void test_choose_sort_strategy() {
+    RecordBatch batch;
+    KeyProfile profile;
+
+    fill_batch(&batch, 5000, sorted_key);
+    profile_record_batch(&batch, 2, &profile);
+    TEST_ASSERT_EQUAL_size_t(AUTO_SORT_SAMPLE_SIZE, profile.n_sampled);
+    TEST_ASSERT_TRUE(profile.descent_ratio == 0.0);
+    TEST_ASSERT_TRUE(profile.duplicate_ratio == 0.0);
+    TEST_ASSERT_EQUAL_INT(SORT_STRATEGY_NATURAL_MERGE, choose_sort_strategy(2, &profile));
+    record_batch_free(&batch);
+
+    fill_batch(&batch, 5000, reversed_key);
+    profile_record_batch(&batch, 3, &profile);
+    TEST_ASSERT_TRUE(profile.descent_ratio == 1.0);
+    TEST_ASSERT_EQUAL_INT(SORT_STRATEGY_NATURAL_MERGE, choose_sort_strategy(3, &profile));
+    record_batch_free(&batch);
+
+    fill_batch(&batch, 5000, random_key);
+    profile_record_batch(&batch, 2, &profile);
+    TEST_ASSERT_TRUE(profile.descent_ratio > 0.3 && profile.descent_ratio < 0.7);
+    TEST_ASSERT_EQUAL_INT(SORT_STRATEGY_RADIX, choose_sort_strategy(2, &profile));
+    profile_record_batch(&batch, 1, &profile);
+    TEST_ASSERT_EQUAL_INT(SORT_STRATEGY_MERGE, choose_sort_strategy(1, &profile));
+    record_batch_free(&batch);
+
+    fill_batch(&batch, 5000, few_values_key);
+    profile_record_batch(&batch, 1, &profile);
+    TEST_ASSERT_TRUE(profile.duplicate_ratio > 0.9);
+    TEST_ASSERT_EQUAL_INT(SORT_STRATEGY_QUICK, choose_sort_strategy(1, &profile));
+    record_batch_free(&batch);
+}
+
+void test_radix_sort_record_batch() {
+    RecordBatch batch;
+
+    fill_batch(&batch, 3000, random_key);
+    batch.field3[10] = -0.0;
+    batch.field3[20] = 0.0;
+
+    for (size_t field = 2; field <= 3; field++) {
+        size_t* expected = sort_record_batch(&batch, field, merge_sort);
+        size_t* actual = radix_sort_record_batch(&batch, field);
+
+        TEST_ASSERT_NOT_NULL(actual);
+        TEST_ASSERT_EQUAL_MEMORY(expected, actual, batch.n_records * sizeof(size_t));
+
+        free(expected);
+        free(actual);
+    }
+
+    TEST_ASSERT_NULL(radix_sort_record_batch(&batch, 1));
+
+    record_batch_free(&batch);
+}
+
+void test_auto_sort_record_batch() {
+    int (*keys[])(size_t) = { sorted_key, reversed_key, random_key, few_values_key };
+    RecordBatch batch;
+    SortStrategy strategy;
+
+    for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++) {
+        fill_batch(&batch, 2000, keys[k]);
+
+        for (size_t field = 1; field <= 3; field++) {
+            size_t* permutation = auto_sort_record_batch(&batch, field, NULL, &strategy);
+
+            assert_sorted(&batch, field, permutation);
+            free(permutation);
+        }
+
+        record_batch_free(&batch);
+    }
+}
@@ -0,0 +1,41 @@
+/**
+ * @file test_auto_sort.h
+ * @brief Unit test declarations for the automatic choice of the sorting algorithm.
+ *
+ * This header file declares test cases for profiling key columns, choosing a
+ * strategy from the profile and sorting numeric columns with radix sort.
+ * 
+ * @see auto_sort.h
+ */
+
+#ifndef _TEST_AUTO_SORT_H
+#define _TEST_AUTO_SORT_H
+
+#include "auto_sort.h"
+#include "unity.h"
+
+
+/**
+ * @brief Test case for the `profile_record_batch` and `choose_sort_strategy` functions.
+ *
+ * Verifies that sorted, reverse-sorted, random and duplicate-heavy columns are
+ * profiled as such and dispatched to the expected strategy.
+ */
+void test_choose_sort_strategy();
+
+/**
+ * @brief Test case for the `radix_sort_record_batch` function.
+ *
+ * Verifies that negative, zero and positive keys of field2 and field3 are sorted
+ * in the same order as `merge_sort`, ties included.
+ */
+void test_radix_sort_record_batch();
+
+/**
+ * @brief Test case for the `auto_sort_record_batch` function.
+ *
+ * Verifies that the permutation is sorted whatever the strategy chosen.
+ */
+void test_auto_sort_record_batch();
+
+#endif // _TEST_AUTO_SORT_H
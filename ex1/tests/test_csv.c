@@ -6,42 +6,20 @@
  */
 
 #include "test_csv.h"
+#include "algo.h"
+#include "test_utils.h"
 #include "unity.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
 
 // Mock data for testing
-static Record record1 = {1, "Alice", 10, 5.5}; ///< Mock record 1 for testing.
-static Record record2 = {2, "Bob", 20, 7.8};   ///< Mock record 2 for testing.
-static Record record3 = {3, "Alice", 15, 9.9}; ///< Mock record 3 for testing.
-static Record record4 = {4, "Charlie", 30, 3.2}; ///< Mock record 4 for testing.
-
-/**
- * @brief Utility function to create a temporary file for testing purposes.
- * 
- * This function creates a temporary file, writes the provided content to it, and returns the file pointer.
- * The file is created using the `tmpfile` function and its content is written using `fputs`.
- * The file pointer is rewound before returning it.
- * 
- * @param content The content to write to the temporary file.
- * 
- * @return FILE* A pointer to the created temporary file.
- * 
- * @note The function exits the program if the temporary file cannot be created.
- */
-static FILE* create_temp_file(const char* content) {
-    FILE* temp = tmpfile();
-    if (temp == NULL) {
-        fprintf(stderr, "Unable to create temporary file\n");
-        exit(EXIT_FAILURE);
-    }
-
-    fputs(content, temp);
-    rewind(temp);
-
-    return temp;
-}
+static Record record1 = {1, {"Alice"}, 10, 5.5}; ///< Mock record 1 for testing.
+static Record record2 = {2, {"Bob"}, 20, 7.8};   ///< Mock record 2 for testing.
+static Record record3 = {3, {"Alice"}, 15, 9.9}; ///< Mock record 3 for testing.
+static Record record4 = {4, {"Charlie"}, 30, 3.2}; ///< Mock record 4 for testing.
 
 /**
  * @brief Unit test for comparing the first field of two records.
@@ -64,11 +42,17 @@ void test_compare_field1() {
  * - If `record1` is less than `record2` based on the second field.
  * - If `record3` is equal to itself based on the second field.
  * - If `record4` is greater than `record1` based on the second field.
+ * - If values far apart, whose difference overflows an int, are ordered correctly.
  */
 void test_compare_field2() {
     TEST_ASSERT_TRUE(compare_field2(&record1, &record2) < 0);
     TEST_ASSERT_TRUE(compare_field2(&record3, &record3) == 0);
     TEST_ASSERT_TRUE(compare_field2(&record4, &record1) > 0);
+
+    Record low = {5, {"Dave"}, -2000000000, 1.0};
+    Record high = {6, {"Eve"}, 2000000000, 1.0};
+    TEST_ASSERT_TRUE(compare_field2(&low, &high) < 0);
+    TEST_ASSERT_TRUE(compare_field2(&high, &low) > 0);
 }
 
 /**
@@ -117,21 +101,21 @@ void test_read_records() {
     // Test with valid data
     FILE* temp_file = create_temp_file("1,Alice,10,5.5\n2,Bob,20,7.8\n3,Charlie,30,9.9\n");
     Record records[3];
-    size_t n = read_records(temp_file, records, 3);
+    size_t n = read_records(temp_file, records, 3, NULL);
     TEST_ASSERT_EQUAL(3, n);
-    TEST_ASSERT_EQUAL_STRING("Alice", records[0].field1);
-    TEST_ASSERT_EQUAL_STRING("Bob", records[1].field1);
-    TEST_ASSERT_EQUAL_STRING("Charlie", records[2].field1);
+    TEST_ASSERT_EQUAL_STRING("Alice", field1_str(&records[0].field1));
+    TEST_ASSERT_EQUAL_STRING("Bob", field1_str(&records[1].field1));
+    TEST_ASSERT_EQUAL_STRING("Charlie", field1_str(&records[2].field1));
 
-    free(records[0].field1);
-    free(records[1].field1);
-    free(records[2].field1);
+    field1_free(&records[0].field1);
+    field1_free(&records[1].field1);
+    field1_free(&records[2].field1);
     
     fclose(temp_file);
 
     // Test with empty file
     temp_file = create_temp_file("");
-    n = read_records(temp_file, records, 3);
+    n = read_records(temp_file, records, 3, NULL);
     TEST_ASSERT_EQUAL(0, n);
 
     fclose(temp_file);
@@ -148,9 +132,9 @@ void test_read_records() {
  */
 void test_write_records() {
     Record records[3] = {
-        {1, "Alice", 10, 5.5},
-        {2, "Bob", 20, 7.8},
-        {3, "Charlie", 30, 9.9}
+        {1, {"Alice"}, 10, 5.5},
+        {2, {"Bob"}, 20, 7.8},
+        {3, {"Charlie"}, 30, 9.9}
     };
 
     FILE* temp_file = tmpfile();
@@ -168,16 +152,340 @@ void test_write_records() {
     char expected[MAX_LINE_SIZE];
 
     fgets(buffer, sizeof(buffer), temp_file);
-    sprintf(expected, recordWriteFmt, records[0].id, records[0].field1, records[0].field2, records[0].field3);
+    sprintf(expected, recordWriteFmt, records[0].id, field1_str(&records[0].field1), records[0].field2, records[0].field3);
+    TEST_ASSERT_EQUAL_STRING(expected, buffer);
+
+    fgets(buffer, sizeof(buffer), temp_file);
+    sprintf(expected, recordWriteFmt, records[1].id, field1_str(&records[1].field1), records[1].field2, records[1].field3);
+    TEST_ASSERT_EQUAL_STRING(expected, buffer);
+
+    fgets(buffer, sizeof(buffer), temp_file);
+    sprintf(expected, recordWriteFmt, records[2].id, field1_str(&records[2].field1), records[2].field2, records[2].field3);
     TEST_ASSERT_EQUAL_STRING(expected, buffer);
 
+    fclose(temp_file);
+}
+
+/**
+ * @brief Unit test for reading records into a RecordBatch.
+ * 
+ * This test validates the behavior of the `read_record_batch` function. It checks:
+ * - If every column of the batch holds the fields of the records read.
+ * - If the batch grows past its initial capacity.
+ * 
+ * @note A temporary file is created for the test case.
+ */
+void test_read_record_batch() {
+    FILE* temp_file = create_temp_file("1,Alice,10,5.5\n2,Bob,20,7.8\n3,Charlie,30,9.9\n");
+    RecordBatch batch;
+    record_batch_init(&batch, 2);
+
+    size_t n = read_record_batch(temp_file, &batch, 3, NULL);
+    TEST_ASSERT_EQUAL(3, n);
+    TEST_ASSERT_EQUAL(3, batch.n_records);
+    TEST_ASSERT_EQUAL_STRING("Charlie", field1_str(&batch.field1[2]));
+    TEST_ASSERT_EQUAL_INT(1, batch.id[0]);
+    TEST_ASSERT_EQUAL_INT(2, batch.id[1]);
+    TEST_ASSERT_EQUAL_STRING("Alice", field1_str(&batch.field1[0]));
+    TEST_ASSERT_EQUAL_STRING("Bob", field1_str(&batch.field1[1]));
+    TEST_ASSERT_EQUAL_INT(10, batch.field2[0]);
+    TEST_ASSERT_EQUAL_INT(20, batch.field2[1]);
+    TEST_ASSERT_TRUE(batch.field3[0] == 5.5);
+    TEST_ASSERT_TRUE(batch.field3[1] == 7.8);
+
+    record_batch_free(&batch);
+    fclose(temp_file);
+}
+
+/**
+ * @brief Unit test for sorting a RecordBatch.
+ * 
+ * This test validates the behavior of the `sort_record_batch` function. It checks:
+ * - If the permutation orders the records by field1, field2 and field3.
+ * - If merge sort keeps records with equal keys in their original order.
+ * - If quick sort produces the same key order.
+ */
+void test_sort_record_batch() {
+    FILE* temp_file = create_temp_file("1,Charlie,30,0.5\n2,Alice,20,7.8\n3,Bob,10,9.9\n4,Alice,40,3.2\n");
+    RecordBatch batch;
+    record_batch_init(&batch, 4);
+    read_record_batch(temp_file, &batch, 4, NULL);
+    fclose(temp_file);
+
+    size_t expected_field1[] = {1, 3, 2, 0};
+    size_t expected_field2[] = {2, 1, 0, 3};
+    size_t expected_field3[] = {0, 3, 1, 2};
+
+    size_t* permutation = sort_record_batch(&batch, 1, merge_sort);
+    TEST_ASSERT_EQUAL_MEMORY(expected_field1, permutation, sizeof(expected_field1));
+    free(permutation);
+
+    permutation = sort_record_batch(&batch, 2, merge_sort);
+    TEST_ASSERT_EQUAL_MEMORY(expected_field2, permutation, sizeof(expected_field2));
+    free(permutation);
+
+    permutation = sort_record_batch(&batch, 3, quick_sort);
+    TEST_ASSERT_EQUAL_MEMORY(expected_field3, permutation, sizeof(expected_field3));
+    free(permutation);
+
+    permutation = sort_record_batch(&batch, 1, quick_sort);
+    for (size_t i = 1; i < batch.n_records; i++)
+        TEST_ASSERT_TRUE(field1_compare(&batch.field1[permutation[i - 1]], &batch.field1[permutation[i]]) <= 0);
+    free(permutation);
+
+    record_batch_free(&batch);
+}
+
+/**
+ * @brief Unit test for writing a RecordBatch to a file.
+ * 
+ * This test validates the behavior of the `write_record_batch` function. It checks:
+ * - If the records are written in the order given by the permutation.
+ * - If the written records match the format of `write_records`.
+ * 
+ * @note A temporary file is created for each test case.
+ */
+void test_write_record_batch() {
+    FILE* temp_file = create_temp_file("1,Alice,10,5.5\n2,Bob,20,7.8\n");
+    RecordBatch batch;
+    record_batch_init(&batch, 2);
+    read_record_batch(temp_file, &batch, 2, NULL);
+    fclose(temp_file);
+
+    temp_file = tmpfile();
+    if (temp_file == NULL) {
+        fprintf(stderr, "Unable to create temporary file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t permutation[] = {1, 0};
+    size_t n = write_record_batch(temp_file, &batch, permutation, 2);
+    TEST_ASSERT_EQUAL(2, n);
+
+    rewind(temp_file);
+
+    char buffer[MAX_LINE_SIZE];
+    char expected[MAX_LINE_SIZE];
+
     fgets(buffer, sizeof(buffer), temp_file);
-    sprintf(expected, recordWriteFmt, records[1].id, records[1].field1, records[1].field2, records[1].field3);
+    sprintf(expected, recordWriteFmt, 2, "Bob", 20, 7.8);
     TEST_ASSERT_EQUAL_STRING(expected, buffer);
 
     fgets(buffer, sizeof(buffer), temp_file);
-    sprintf(expected, recordWriteFmt, records[2].id, records[2].field1, records[2].field2, records[2].field3);
+    sprintf(expected, recordWriteFmt, 1, "Alice", 10, 5.5);
     TEST_ASSERT_EQUAL_STRING(expected, buffer);
 
     fclose(temp_file);
+    record_batch_free(&batch);
+}
+
+/**
+ * @brief Unit test for the small-string-optimized Field1 storage.
+ * 
+ * This test validates the behavior of the `field1_set` and `field1_compare` functions. It checks:
+ * - If strings up to `FIELD1_INLINE_CAPACITY` characters are stored inline.
+ * - If longer strings are spilled to the heap and read back unchanged.
+ * - If comparisons between inline, heap and mixed values agree with `strcmp`.
+ */
+void test_field1_inline_storage() {
+    const char* strings[] = {
+        "",
+        "Alice",
+        "Alice, the 15th",
+        "Alice, the 16th!",
+        "Alice, the 15th and more",
+        "Bob"
+    };
+    size_t n = sizeof(strings) / sizeof(strings[0]);
+    Field1 values[sizeof(strings) / sizeof(strings[0])];
+
+    for (size_t i = 0; i < n; i++) {
+        field1_set(&values[i], strings[i]);
+        TEST_ASSERT_EQUAL_STRING(strings[i], field1_str(&values[i]));
+        TEST_ASSERT_EQUAL(strlen(strings[i]) > FIELD1_INLINE_CAPACITY, values[i].heap.tag == FIELD1_HEAP_TAG);
+    }
+
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++) {
+            int expected = strcmp(strings[i], strings[j]);
+            int actual = field1_compare(&values[i], &values[j]);
+
+            TEST_ASSERT_EQUAL_INT((expected > 0) - (expected < 0), (actual > 0) - (actual < 0));
+        }
+
+    for (size_t i = 0; i < n; i++)
+        field1_free(&values[i]);
+}
+
+/**
+ * @brief Reads the whole content of a file into a heap-allocated buffer.
+ * 
+ * @param file The file to read, rewound before reading.
+ * @param length Pointer where the number of bytes read is stored.
+ * 
+ * @return char* The content of the file, to be freed by the caller.
+ */
+static char* read_whole_file(FILE* file, size_t* length) {
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+
+    char* content = malloc(size + 1);
+    TEST_ASSERT_NOT_NULL(content);
+
+    *length = fread(content, 1, size, file);
+    content[*length] = '\0';
+
+    return content;
+}
+
+/**
+ * @brief Unit test for writing a RecordBatch with several formatting threads.
+ * 
+ * This test validates the behavior of the `write_record_batch_parallel` function. It checks:
+ * - If the output is byte-identical to the serial writer, for several thread counts.
+ * - If every record is reported as written.
+ * 
+ * @note Temporary files are created for each test case.
+ */
+void test_write_record_batch_parallel() {
+    const size_t n_records = 1000;
+    RecordBatch batch;
+    record_batch_init(&batch, n_records);
+
+    char long_field1[64];
+    for (size_t i = 0; i < n_records; i++) {
+        snprintf(long_field1, sizeof(long_field1), i % 3 ? "word%zu" : "a much longer field1 value %zu", i);
+
+        batch.id[i] = (int)i;
+        field1_set(&batch.field1[i], long_field1);
+        batch.field2[i] = (int)(i * 7919 % 1000) - 500;
+        batch.field3[i] = i / 7.0;
+        batch.n_records++;
+    }
+
+    size_t* permutation = sort_record_batch(&batch, 2, merge_sort);
+
+    FILE* serial_file = tmpfile();
+    TEST_ASSERT_NOT_NULL(serial_file);
+    TEST_ASSERT_EQUAL(n_records, write_record_batch(serial_file, &batch, permutation, n_records));
+
+    size_t serial_length;
+    char* serial_content = read_whole_file(serial_file, &serial_length);
+    fclose(serial_file);
+
+    size_t thread_counts[] = {1, 2, 3, 8};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        FILE* parallel_file = tmpfile();
+        TEST_ASSERT_NOT_NULL(parallel_file);
+        TEST_ASSERT_EQUAL(n_records, write_record_batch_parallel(parallel_file, &batch, permutation, n_records, thread_counts[t]));
+
+        size_t parallel_length;
+        char* parallel_content = read_whole_file(parallel_file, &parallel_length);
+        fclose(parallel_file);
+
+        TEST_ASSERT_EQUAL(serial_length, parallel_length);
+        TEST_ASSERT_EQUAL_STRING(serial_content, parallel_content);
+
+        free(parallel_content);
+    }
+
+    free(serial_content);
+    free(permutation);
+    record_batch_free(&batch);
+}
+
+/**
+ * @brief Unit test for the filters applied while reading records.
+ * 
+ * This test validates the filtering of `read_records` and `read_record_batch`. It checks:
+ * - If only the records with the requested field1 prefix are read.
+ * - If the field2 and field3 ranges are inclusive and combine with the prefix.
+ * - If skipped records do not count towards the number of records requested.
+ * - If a prefix is only matched within field1, and out-of-range integers are rejected as malformed.
+ * 
+ * @note A temporary file is created for each test case.
+ */
+void test_read_records_filtered() {
+    const char* content =
+        "1,Alice,10,5.5\n"
+        "2,Bob,20,7.8\n"
+        "3,Alfred,30,9.9\n"
+        "4,Albert,40,1.5\n"
+        "5,Charlie,50,3.2\n";
+
+    RecordFilter prefix_filter = {0};
+    prefix_filter.field1_prefix = "Al";
+
+    FILE* temp_file = create_temp_file(content);
+    Record records[2];
+    size_t n = read_records(temp_file, records, 2, &prefix_filter);
+    TEST_ASSERT_EQUAL(2, n);
+    TEST_ASSERT_EQUAL_INT(1, records[0].id);
+    TEST_ASSERT_EQUAL_INT(3, records[1].id);
+    TEST_ASSERT_EQUAL_STRING("Alfred", field1_str(&records[1].field1));
+    field1_free(&records[0].field1);
+    field1_free(&records[1].field1);
+    fclose(temp_file);
+
+    RecordFilter range_filter = {0};
+    range_filter.field1_prefix = "Al";
+    range_filter.has_field2_range = 1;
+    range_filter.field2_min = 10;
+    range_filter.field2_max = 40;
+    range_filter.has_field3_range = 1;
+    range_filter.field3_min = 1.5;
+    range_filter.field3_max = 6.0;
+
+    temp_file = create_temp_file(content);
+    RecordBatch batch;
+    record_batch_init(&batch, 0);
+    n = read_record_batch(temp_file, &batch, SIZE_MAX, &range_filter);
+    TEST_ASSERT_EQUAL(2, n);
+    TEST_ASSERT_EQUAL_INT(1, batch.id[0]);
+    TEST_ASSERT_EQUAL_INT(4, batch.id[1]);
+    TEST_ASSERT_EQUAL_INT(40, batch.field2[1]);
+    TEST_ASSERT_EQUAL_STRING("Albert", field1_str(&batch.field1[1]));
+    record_batch_free(&batch);
+    fclose(temp_file);
+
+    int id, field2;
+    char* field1;
+    double field3;
+
+    RecordFilter delimiter_filter = {0};
+    delimiter_filter.field1_prefix = "Al,";
+
+    char short_line[] = "6,Al,60,1.0\n";
+    TEST_ASSERT_EQUAL_INT(0, parse_record_line(short_line, &delimiter_filter, &id, &field1, &field2, &field3));
+
+    char field2_line[] = "7,Alice,99999999999,1.0\n";
+    TEST_ASSERT_EQUAL_INT(-1, parse_record_line(field2_line, &range_filter, &id, &field1, &field2, &field3));
+
+    char id_line[] = "-99999999999,Alice,20,1.0\n";
+    TEST_ASSERT_EQUAL_INT(-1, parse_record_line(id_line, NULL, &id, &field1, &field2, &field3));
+}
+
+/**
+ * @brief Unit test for the range-checked conversion of integers.
+ * 
+ * This test validates the behavior of the `parse_int` function. It checks:
+ * - If the integers at the limits of an int are converted, and the end points past their digits.
+ * - If values out of the range of an int, which `strtol` would accept, are rejected.
+ * - If a string without digits is rejected.
+ */
+void test_parse_int() {
+    char* end;
+    int value;
+
+    TEST_ASSERT_EQUAL_INT(0, parse_int("2147483647:", &end, &value));
+    TEST_ASSERT_EQUAL_INT(INT_MAX, value);
+    TEST_ASSERT_EQUAL_CHAR(':', *end);
+
+    TEST_ASSERT_EQUAL_INT(0, parse_int("-2147483648", &end, &value));
+    TEST_ASSERT_EQUAL_INT(INT_MIN, value);
+
+    TEST_ASSERT_EQUAL_INT(-1, parse_int("4294967296", &end, &value));
+    TEST_ASSERT_EQUAL_INT(-1, parse_int("-9999999999", &end, &value));
+    TEST_ASSERT_EQUAL_INT(-1, parse_int("x1", &end, &value));
 }
@@ -64,4 +64,62 @@ void test_read_records();
  */
 void test_write_records();
 
+/**
+ * @brief Test case for the `read_record_batch` function.
+ *
+ * Validates that `read_record_batch` fills every column of a RecordBatch
+ * with the fields of the records read from a CSV file.
+ */
+void test_read_record_batch();
+
+/**
+ * @brief Test case for the `sort_record_batch` function.
+ *
+ * Checks that the permutation returned by `sort_record_batch` orders the
+ * records by the requested key column, for every field and both sorts.
+ */
+void test_sort_record_batch();
+
+/**
+ * @brief Test case for the `write_record_batch` function.
+ *
+ * Confirms that `write_record_batch` gathers the columns following the
+ * permutation and writes the records in the expected format.
+ */
+void test_write_record_batch();
+
+/**
+ * @brief Test case for the small-string-optimized Field1 storage.
+ *
+ * Verifies that short strings are stored inline, long strings on the heap,
+ * and that `field1_compare` orders them as `strcmp` does.
+ */
+void test_field1_inline_storage();
+
+/**
+ * @brief Test case for the `write_record_batch_parallel` function.
+ *
+ * Confirms that formatting the records on several threads produces exactly
+ * the same bytes as `write_record_batch`.
+ */
+void test_write_record_batch_parallel();
+
+/**
+ * @brief Test case for the filters of `read_records` and `read_record_batch`.
+ *
+ * Verifies that the field1 prefix and the field2/field3 ranges are applied
+ * while parsing, and that only the matching records are stored. Also checks
+ * that the prefix does not match across the delimiter of field1, and that
+ * out-of-range integers make a line malformed.
+ */
+void test_read_records_filtered();
+
+/**
+ * @brief Test case for the `parse_int` function.
+ *
+ * Verifies that integers within the range of an int are converted, and that
+ * values out of that range or without digits are rejected.
+ */
+void test_parse_int();
+
 #endif // _TEST_CSV_H
@@ -0,0 +1,156 @@
+/**
+ * @file test_group_by.c
+ * @brief Unit tests for the group-by aggregation of sorted records.
+ * 
+ * This file contains the implementation of unit tests for the group_by functions.
+ */
+
+#include "test_group_by.h"
+#include "algo.h"
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Mock CSV content, unsorted, with repeated field1 and field2 values. */
+static const char* csv_content =
+    "1,Bob,10,1.5\n"
+    "2,Alice,20,2.0\n"
+    "3,Bob,30,3.5\n"
+    "4,Carol,10,4.0\n"
+    "5,Alice,-5,0.5\n"
+    "6,Bob,20,1.0\n";
+
+/**
+ * @brief Utility function that loads the mock content into a batch.
+ * 
+ * @param batch Pointer to the batch to initialize and fill.
+ */
+static void load_batch(RecordBatch* batch) {
+    FILE* temp = tmpfile();
+    TEST_ASSERT_NOT_NULL(temp);
+
+    fputs(csv_content, temp);
+    rewind(temp);
+
+    record_batch_init(batch, 0);
+    TEST_ASSERT_EQUAL_size_t(6, read_record_batch(temp, batch, SIZE_MAX, NULL));
+
+    fclose(temp);
+}
+
+/**
+ * @brief Utility function that reads the whole content of a file into a buffer.
+ * 
+ * @param file The file, rewound before reading.
+ * @param buffer Buffer receiving the content.
+ * @param size Size of the buffer.
+ */
+static void read_back(FILE* file, char* buffer, size_t size) {
+    rewind(file);
+
+    size_t length = fread(buffer, 1, size - 1, file);
+    buffer[length] = '\0';
+}
+
+void test_write_record_groups() {
+    const char* expected[] = {
+        "Alice,2,15,7.500000,2.500000,1.250000\n"
+        "Bob,3,60,20.000000,6.000000,2.000000\n"
+        "Carol,1,10,10.000000,4.000000,4.000000\n",
+
+        "-5,1,-5,-5.000000,0.500000,0.500000\n"
+        "10,2,20,10.000000,5.500000,2.750000\n"
+        "20,2,40,20.000000,3.000000,1.500000\n"
+        "30,1,30,30.000000,3.500000,3.500000\n",
+
+        "0.500000,1,-5,-5.000000,0.500000,0.500000\n"
+        "1.000000,1,20,20.000000,1.000000,1.000000\n"
+        "1.500000,1,10,10.000000,1.500000,1.500000\n"
+        "2.000000,1,20,20.000000,2.000000,2.000000\n"
+        "3.500000,1,30,30.000000,3.500000,3.500000\n"
+        "4.000000,1,10,10.000000,4.000000,4.000000\n"
+    };
+    size_t expected_groups[] = { 3, 4, 6 };
+    char actual[1024];
+    RecordBatch batch;
+
+    load_batch(&batch);
+
+    for (size_t field = 1; field <= 3; field++) {
+        size_t* permutation = sort_record_batch(&batch, field, merge_sort);
+
+        FILE* outfile = tmpfile();
+        TEST_ASSERT_NOT_NULL(outfile);
+
+        TEST_ASSERT_EQUAL_size_t(expected_groups[field - 1], write_record_groups(outfile, &batch, permutation, field));
+        read_back(outfile, actual, sizeof(actual));
+        TEST_ASSERT_EQUAL_STRING(expected[field - 1], actual);
+
+        fclose(outfile);
+        free(permutation);
+    }
+
+    record_batch_free(&batch);
+}
+
+void test_group_sorted_records() {
+    char expected[1024];
+    char actual[1024];
+    RecordBatch batch;
+
+    load_batch(&batch);
+
+    for (size_t field = 1; field <= 3; field++) {
+        size_t* permutation = sort_record_batch(&batch, field, merge_sort);
+
+        FILE* grouped = tmpfile();
+        FILE* sorted_csv = tmpfile();
+        FILE* streamed = tmpfile();
+        TEST_ASSERT_NOT_NULL(grouped);
+        TEST_ASSERT_NOT_NULL(sorted_csv);
+        TEST_ASSERT_NOT_NULL(streamed);
+
+        size_t n_groups = write_record_groups(grouped, &batch, permutation, field);
+        read_back(grouped, expected, sizeof(expected));
+
+        write_record_batch(sorted_csv, &batch, permutation, batch.n_records);
+        rewind(sorted_csv);
+
+        size_t n_streamed;
+        TEST_ASSERT_EQUAL_INT(1, group_sorted_records(sorted_csv, streamed, field, &n_streamed));
+        TEST_ASSERT_EQUAL_size_t(n_groups, n_streamed);
+        read_back(streamed, actual, sizeof(actual));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+
+        fclose(grouped);
+        fclose(sorted_csv);
+        fclose(streamed);
+        free(permutation);
+    }
+
+    record_batch_free(&batch);
+
+    const char* invalid_files[] = {
+        "1,Alice,10,1.0\n2,Bob,20,2.0\n3,Alice,30,3.0\n",   // Alice again after Bob
+        "1,Alice,10,1.0\n2,Bob,20\n3,Carol,30,3.0\n"         // missing field3
+    };
+    size_t completed_groups[] = { 1, 0 };
+
+    for (size_t f = 0; f < 2; f++) {
+        FILE* sorted_csv = tmpfile();
+        FILE* streamed = tmpfile();
+        TEST_ASSERT_NOT_NULL(sorted_csv);
+        TEST_ASSERT_NOT_NULL(streamed);
+
+        fputs(invalid_files[f], sorted_csv);
+        rewind(sorted_csv);
+
+        size_t n_streamed;
+        TEST_ASSERT_EQUAL_INT(0, group_sorted_records(sorted_csv, streamed, 1, &n_streamed));
+        TEST_ASSERT_EQUAL_size_t(completed_groups[f], n_streamed);
+
+        fclose(sorted_csv);
+        fclose(streamed);
+    }
+}
@@ -0,0 +1,35 @@
+/**
+ * @file test_group_by.h
+ * @brief Unit test declarations for the group-by aggregation of sorted records.
+ *
+ * This header file declares test cases for aggregating a sorted RecordBatch and
+ * a sorted CSV file by key.
+ * 
+ * @see group_by.h
+ */
+
+#ifndef _TEST_GROUP_BY_H
+#define _TEST_GROUP_BY_H
+
+#include "group_by.h"
+#include "unity.h"
+
+
+/**
+ * @brief Test case for the `write_record_groups` function.
+ *
+ * Verifies that a batch sorted through a permutation is written as one line per
+ * distinct key, with the count, sums and averages of its records, for every field.
+ */
+void test_write_record_groups();
+
+/**
+ * @brief Test case for the `group_sorted_records` function.
+ *
+ * Verifies that streaming a sorted CSV file gives the same groups as aggregating
+ * the equivalent sorted batch, and that a file with a key out of order or a
+ * malformed line is rejected.
+ */
+void test_group_sorted_records();
+
+#endif // _TEST_GROUP_BY_H
@@ -10,11 +10,23 @@
  * 
  * @see test_algo.h
  * @see test_csv.h
+ * @see test_sparse_index.h
+ * @see test_async_io.h
+ * @see test_auto_sort.h
+ * @see test_group_by.h
+ * @see test_merge_join.h
+ * @see test_quantile_sketch.h
  * @see Unity
  */
 
 #include "test_algo.h"
 #include "test_csv.h"
+#include "test_sparse_index.h"
+#include "test_async_io.h"
+#include "test_auto_sort.h"
+#include "test_group_by.h"
+#include "test_merge_join.h"
+#include "test_quantile_sketch.h"
 #include "unity.h"
 
 /**
@@ -69,6 +81,10 @@ int main(void) {
     RUN_TEST(test_quick_sort_single_element); ///< Test for quick sort with a single element.
     RUN_TEST(test_quick_sort_negative_numbers); ///< Test for quick sort with negative numbers.
 
+    // Natural Merge Sort tests
+    RUN_TEST(test_natural_merge_sort); ///< Test for natural merge sort with mixed runs and duplicates.
+    RUN_TEST(test_natural_merge_sort_single_run); ///< Test for natural merge sort with a single run.
+
     // CSV tests
     RUN_TEST(test_compare_field1); ///< Test for comparing the first field of records in a CSV.
     RUN_TEST(test_compare_field2); ///< Test for comparing the second field of records in a CSV.
@@ -76,6 +92,42 @@ int main(void) {
     RUN_TEST(test_count_lines); ///< Test for counting the number of lines in a CSV file.
     RUN_TEST(test_read_records); ///< Test for reading records from a CSV file.
     RUN_TEST(test_write_records); ///< Test for writing records to a CSV file.
+    RUN_TEST(test_read_record_batch); ///< Test for reading records into a columnar RecordBatch.
+    RUN_TEST(test_sort_record_batch); ///< Test for sorting the key column of a RecordBatch.
+    RUN_TEST(test_write_record_batch); ///< Test for writing a RecordBatch following a permutation.
+    RUN_TEST(test_field1_inline_storage); ///< Test for the inline/heap storage of field1.
+    RUN_TEST(test_write_record_batch_parallel); ///< Test for the multi-threaded RecordBatch writer.
+    RUN_TEST(test_read_records_filtered); ///< Test for the filters applied while reading records.
+    RUN_TEST(test_parse_int); ///< Test for the range-checked conversion of integers.
+
+    // Sparse index tests
+    RUN_TEST(test_build_and_load_sparse_index); ///< Test for building and loading a sparse index sidecar.
+    RUN_TEST(test_sparse_index_lookup); ///< Test for range lookups through a sparse index.
+
+    // Async I/O tests
+    RUN_TEST(test_async_reader_gets); ///< Test for reading lines through an AsyncReader.
+    RUN_TEST(test_async_reader_fifo); ///< Test for reading a FIFO through an AsyncReader.
+    RUN_TEST(test_async_writer_write); ///< Test for writing data through an AsyncWriter.
+    RUN_TEST(test_record_batch_async_round_trip); ///< Test for reading and writing a RecordBatch asynchronously.
+
+    // Automatic sort tests
+    RUN_TEST(test_choose_sort_strategy); ///< Test for profiling key columns and choosing a strategy.
+    RUN_TEST(test_radix_sort_record_batch); ///< Test for the radix sort of numeric key columns.
+    RUN_TEST(test_auto_sort_record_batch); ///< Test for sorting with the automatically chosen strategy.
+
+    // Group-by tests
+    RUN_TEST(test_write_record_groups); ///< Test for aggregating a sorted RecordBatch by key.
+    RUN_TEST(test_group_sorted_records); ///< Test for aggregating a sorted CSV file in one streaming pass.
+
+    // Merge-join tests
+    RUN_TEST(test_merge_join_inner); ///< Test for the inner merge-join of two sorted files.
+    RUN_TEST(test_merge_join_left); ///< Test for the left merge-join of two sorted files.
+    RUN_TEST(test_merge_join_unsorted); ///< Test for the detection of unsorted join inputs.
+
+    // Quantile sketch tests
+    RUN_TEST(test_kll_quantile); ///< Test for the quantiles of a KLL sketch.
+    RUN_TEST(test_kll_merge); ///< Test for merging KLL sketches.
+    RUN_TEST(test_sketch_csv_file); ///< Test for sketching a CSV file with several threads.
 
     return UNITY_END(); ///< Finalize Unity test framework and return the result.
 }
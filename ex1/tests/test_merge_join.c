@@ -0,0 +1,117 @@
+/**
+ * @file test_merge_join.c
+ * @brief Unit tests for the streaming merge-join of sorted CSV files.
+ * 
+ * This file contains the implementation of unit tests for the merge_join function.
+ */
+
+#include "test_merge_join.h"
+#include "test_utils.h"
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Mock left file, sorted by field1. */
+static const char* left_content =
+    "1,Alice,10,1.5\n"
+    "2,Bob,20,2.5\n"
+    "3,Bob,30,3.5\n"
+    "4,Dave,40,4.5\n";
+
+/** @brief Mock right file, sorted by field1. */
+static const char* right_content =
+    "10,Aaron,1,0.1\n"
+    "11,Bob,2,0.2\n"
+    "12,Bob,3,0.3\n"
+    "13,Carol,4,0.4\n"
+    "14,Dave,5,0.5\n";
+
+/**
+ * @brief Utility function that joins two strings and returns the output.
+ * 
+ * @param left_text Content of the left file.
+ * @param right_text Content of the right file.
+ * @param key Join key.
+ * @param type Kind of join.
+ * @param stats Pointer receiving the counters of the join.
+ * @param output Buffer receiving the output.
+ * @param size Size of the buffer.
+ * @return The result of `merge_join`.
+ */
+static int join_strings(const char* left_text, const char* right_text, size_t key, JoinType type, JoinStats* stats, char* output, size_t size) {
+    FILE* left = create_temp_file(left_text);
+    FILE* right = create_temp_file(right_text);
+    FILE* outfile = tmpfile();
+    TEST_ASSERT_NOT_NULL(outfile);
+
+    int result = merge_join(left, right, outfile, key, type, stats);
+
+    rewind(outfile);
+    output[fread(output, 1, size - 1, outfile)] = '\0';
+
+    fclose(left);
+    fclose(right);
+    fclose(outfile);
+
+    return result;
+}
+
+void test_merge_join_inner() {
+    char output[1024];
+    JoinStats stats;
+
+    TEST_ASSERT_EQUAL_INT(1, join_strings(left_content, right_content, 1, JOIN_INNER, &stats, output, sizeof(output)));
+    TEST_ASSERT_EQUAL_STRING(
+        "2,Bob,20,2.500000,11,Bob,2,0.200000\n"
+        "2,Bob,20,2.500000,12,Bob,3,0.300000\n"
+        "3,Bob,30,3.500000,11,Bob,2,0.200000\n"
+        "3,Bob,30,3.500000,12,Bob,3,0.300000\n"
+        "4,Dave,40,4.500000,14,Dave,5,0.500000\n",
+        output
+    );
+
+    TEST_ASSERT_EQUAL_size_t(4, stats.n_left);
+    TEST_ASSERT_EQUAL_size_t(5, stats.n_right);
+    TEST_ASSERT_EQUAL_size_t(5, stats.n_rows);
+    TEST_ASSERT_EQUAL_size_t(2, stats.max_group);
+
+    // Join on id: only id 1 is shared
+    TEST_ASSERT_EQUAL_INT(1, join_strings(left_content, "1,Zed,7,7.0\n9,Yan,8,8.0\n", 0, JOIN_INNER, &stats, output, sizeof(output)));
+    TEST_ASSERT_EQUAL_STRING("1,Alice,10,1.500000,1,Zed,7,7.000000\n", output);
+
+    // Join on field2 with keys whose difference overflows an int
+    TEST_ASSERT_EQUAL_INT(1, join_strings("1,A,-2000000000,1.0\n2,B,2000000000,2.0\n", "3,C,-2000000000,3.0\n4,D,2000000000,4.0\n", 2, JOIN_INNER, &stats, output, sizeof(output)));
+    TEST_ASSERT_EQUAL_size_t(2, stats.n_rows);
+}
+
+void test_merge_join_left() {
+    char output[1024];
+    JoinStats stats;
+
+    TEST_ASSERT_EQUAL_INT(1, join_strings(left_content, right_content, 1, JOIN_LEFT, &stats, output, sizeof(output)));
+    TEST_ASSERT_EQUAL_STRING(
+        "1,Alice,10,1.500000,,,,\n"
+        "2,Bob,20,2.500000,11,Bob,2,0.200000\n"
+        "2,Bob,20,2.500000,12,Bob,3,0.300000\n"
+        "3,Bob,30,3.500000,11,Bob,2,0.200000\n"
+        "3,Bob,30,3.500000,12,Bob,3,0.300000\n"
+        "4,Dave,40,4.500000,14,Dave,5,0.500000\n",
+        output
+    );
+    TEST_ASSERT_EQUAL_size_t(6, stats.n_rows);
+
+    // An empty right file keeps every left record
+    TEST_ASSERT_EQUAL_INT(1, join_strings(left_content, "", 1, JOIN_LEFT, &stats, output, sizeof(output)));
+    TEST_ASSERT_EQUAL_size_t(4, stats.n_rows);
+    TEST_ASSERT_EQUAL_size_t(0, stats.n_right);
+}
+
+void test_merge_join_unsorted() {
+    char output[1024];
+    JoinStats stats;
+
+    TEST_ASSERT_EQUAL_INT(0, join_strings("1,Bob,1,1.0\n2,Alice,2,2.0\n", right_content, 1, JOIN_INNER, &stats, output, sizeof(output)));
+    TEST_ASSERT_EQUAL_INT(0, join_strings(left_content, "1,Dave,1,1.0\n2,Bob,2,2.0\n", 1, JOIN_INNER, &stats, output, sizeof(output)));
+    TEST_ASSERT_EQUAL_INT(0, join_strings(left_content, right_content, 4, JOIN_INNER, &stats, output, sizeof(output)));
+}
@@ -0,0 +1,41 @@
+/**
+ * @file test_merge_join.h
+ * @brief Unit test declarations for the streaming merge-join of sorted CSV files.
+ *
+ * This header file declares test cases for inner and left joins of two sorted
+ * files, with duplicate keys on both sides.
+ * 
+ * @see merge_join.h
+ */
+
+#ifndef _TEST_MERGE_JOIN_H
+#define _TEST_MERGE_JOIN_H
+
+#include "merge_join.h"
+#include "unity.h"
+
+
+/**
+ * @brief Test case for `merge_join` with `JOIN_INNER`.
+ *
+ * Verifies that every pair of records with equal keys is written once, including
+ * the cross product of duplicate keys, and that the counters are filled, including
+ * on field2 keys too far apart to be compared by subtraction.
+ */
+void test_merge_join_inner();
+
+/**
+ * @brief Test case for `merge_join` with `JOIN_LEFT`.
+ *
+ * Verifies that left records without match are written once with empty right fields.
+ */
+void test_merge_join_left();
+
+/**
+ * @brief Test case for `merge_join` on files not sorted by the key.
+ *
+ * Verifies that the join reports the unsorted input and that invalid keys are rejected.
+ */
+void test_merge_join_unsorted();
+
+#endif // _TEST_MERGE_JOIN_H
@@ -0,0 +1,120 @@
+/**
+ * @file test_quantile_sketch.c
+ * @brief Unit tests for the KLL quantile sketches.
+ * 
+ * This file contains the implementation of unit tests for the quantile_sketch functions.
+ */
+
+#include "test_quantile_sketch.h"
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/** @brief Path of the temporary CSV file used by `test_sketch_csv_file`. */
+static const char* temp_path = "test_quantile_sketch.tmp";
+
+/**
+ * @brief Returns the i-th value of a permutation of [0, n) for n = 100000.
+ * 
+ * @param i Index in the stream.
+ * @return A distinct value of [0, 100000) for every i of [0, 100000).
+ */
+static double shuffled(size_t i) {
+    // 7919 is coprime with 100000, so i -> 7919 i mod 100000 is a permutation
+    return (double)((i * 7919) % 100000);
+}
+
+/**
+ * @brief Utility function asserting that the percentiles of a sketch of [0, n) are within 2% of n in rank.
+ * 
+ * @param sketch Pointer to the sketch.
+ * @param n Number of values sketched, 0 to n - 1.
+ */
+static void assert_rank_error(const KllSketch* sketch, size_t n) {
+    for (int p = 1; p < 100; p++) {
+        double estimate = kll_quantile(sketch, p / 100.0);
+        double exact = p / 100.0 * n;
+
+        TEST_ASSERT_TRUE(estimate >= exact - 0.02 * n && estimate <= exact + 0.02 * n);
+    }
+}
+
+void test_kll_quantile() {
+    KllSketch sketch;
+
+    kll_init(&sketch, KLL_DEFAULT_K, 1);
+    TEST_ASSERT_TRUE(kll_quantile(&sketch, 0.5) != kll_quantile(&sketch, 0.5)); // NaN when empty
+
+    // Below the capacity of the sketch, every value is retained
+    for (int i = 100; i >= 1; i--)
+        kll_update(&sketch, i);
+
+    TEST_ASSERT_TRUE(kll_quantile(&sketch, 0.5) == 50);
+    TEST_ASSERT_TRUE(kll_quantile(&sketch, 0.9) == 90);
+    TEST_ASSERT_TRUE(kll_quantile(&sketch, 0.0) == 1);
+    TEST_ASSERT_TRUE(kll_quantile(&sketch, 1.0) == 100);
+    kll_free(&sketch);
+
+    kll_init(&sketch, KLL_DEFAULT_K, 1);
+    for (size_t i = 0; i < 100000; i++)
+        kll_update(&sketch, shuffled(i));
+
+    TEST_ASSERT_TRUE(sketch.n == 100000);
+    TEST_ASSERT_TRUE(sketch.n_retained < 2000);
+    TEST_ASSERT_TRUE(sketch.min == 0 && sketch.max == 99999);
+    assert_rank_error(&sketch, 100000);
+    kll_free(&sketch);
+}
+
+void test_kll_merge() {
+    KllSketch first;
+    KllSketch second;
+
+    kll_init(&first, KLL_DEFAULT_K, 1);
+    kll_init(&second, KLL_DEFAULT_K, 2);
+
+    for (size_t i = 0; i < 100000; i++)
+        kll_update(i < 30000 ? &first : &second, shuffled(i));
+
+    kll_merge(&first, &second);
+
+    TEST_ASSERT_TRUE(first.n == 100000);
+    TEST_ASSERT_TRUE(first.min == 0 && first.max == 99999);
+    assert_rank_error(&first, 100000);
+
+    kll_free(&first);
+    kll_free(&second);
+}
+
+void test_sketch_csv_file() {
+    KllSketch field2;
+    KllSketch field3;
+
+    FILE* file = fopen(temp_path, "w");
+    TEST_ASSERT_NOT_NULL(file);
+
+    for (int i = 0; i < 1000; i++)
+        fprintf(file, "%d,name%d,%d,%lf\n", i, i % 7, i - 500, i / 10.0);
+
+    fclose(file);
+
+    for (size_t n_threads = 1; n_threads <= 7; n_threads += 3) {
+        TEST_ASSERT_EQUAL_INT(1, sketch_csv_file(temp_path, n_threads, KLL_DEFAULT_K, &field2, &field3));
+
+        TEST_ASSERT_TRUE(field2.n == 1000);
+        TEST_ASSERT_TRUE(field3.n == 1000);
+        TEST_ASSERT_TRUE(field2.min == -500 && field2.max == 499);
+        TEST_ASSERT_TRUE(field3.min == 0 && field3.max == 99.9);
+
+        double median = kll_quantile(&field2, 0.5);
+        TEST_ASSERT_TRUE(median >= -30 && median <= 30);
+
+        kll_free(&field2);
+        kll_free(&field3);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, sketch_csv_file("missing_file.csv", 2, KLL_DEFAULT_K, &field2, &field3));
+
+    remove(temp_path);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file test_quantile_sketch.h
+ * @brief Unit test declarations for the KLL quantile sketches.
+ *
+ * This header file declares test cases for updating, merging and querying KLL
+ * sketches, and for sketching a CSV file with several threads.
+ * 
+ * @see quantile_sketch.h
+ */
+
+#ifndef _TEST_QUANTILE_SKETCH_H
+#define _TEST_QUANTILE_SKETCH_H
+
+#include "quantile_sketch.h"
+#include "unity.h"
+
+
+/**
+ * @brief Test case for `kll_quantile` on streams of various sizes.
+ *
+ * Verifies that quantiles are exact while the sketch holds every value, and that
+ * the rank error stays within 2% of n on a large shuffled stream.
+ */
+void test_kll_quantile();
+
+/**
+ * @brief Test case for the `kll_merge` function.
+ *
+ * Verifies that merging the sketches of two halves of a stream counts every value
+ * and keeps the rank error within 2% of n.
+ */
+void test_kll_merge();
+
+/**
+ * @brief Test case for the `sketch_csv_file` function.
+ *
+ * Verifies that splitting a file into byte ranges sketches every line exactly once,
+ * whatever the number of threads.
+ */
+void test_sketch_csv_file();
+
+#endif // _TEST_QUANTILE_SKETCH_H
@@ -0,0 +1,152 @@
+/**
+ * @file test_sparse_index.c
+ * @brief Unit tests for the sparse index sidecars of sorted CSV files.
+ * 
+ * This file contains the implementation of unit tests for the sparse index functions.
+ */
+
+#include "test_sparse_index.h"
+#include "test_utils.h"
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Mock CSV file sorted by field2, where the key 20 spans two blocks of 2 lines. */
+static const char* sorted_by_field2 =
+    "5,Eve,10,1.5\n"
+    "3,Carol,15,2.5\n"
+    "1,Alice,20,3.5\n"
+    "4,Dave,20,4.5\n"
+    "2,Bob,20,5.5\n"
+    "6,Frank,30,6.5\n"
+    "7,Grace,40,7.5\n";
+
+/**
+ * @brief Utility function that builds and loads the index of a sorted temporary file.
+ * 
+ * @param sorted_csv The sorted file, rewound after indexing.
+ * @param field Field the file is sorted by.
+ * @param block_size Number of lines per block.
+ * @param index Pointer to the index to load.
+ */
+static void index_temp_file(FILE* sorted_csv, size_t field, size_t block_size, SparseIndex* index) {
+    FILE* index_file = tmpfile();
+    TEST_ASSERT_NOT_NULL(index_file);
+
+    build_sparse_index(sorted_csv, index_file, field, block_size);
+    rewind(sorted_csv);
+    rewind(index_file);
+
+    TEST_ASSERT_TRUE(load_sparse_index(index_file, index));
+    fclose(index_file);
+}
+
+/**
+ * @brief Unit test for building and loading a sparse index.
+ * 
+ * This test validates the behavior of `build_sparse_index` and `load_sparse_index`. It checks:
+ * - If one entry is written for every block, including the last partial one.
+ * - If the offsets point to the first line of each block.
+ * - If the keys are the ones of the first line of each block.
+ */
+void test_build_and_load_sparse_index() {
+    FILE* sorted_csv = create_temp_file(sorted_by_field2);
+    FILE* index_file = tmpfile();
+    TEST_ASSERT_NOT_NULL(index_file);
+
+    TEST_ASSERT_EQUAL(4, build_sparse_index(sorted_csv, index_file, 2, 2));
+    rewind(index_file);
+
+    SparseIndex index;
+    TEST_ASSERT_TRUE(load_sparse_index(index_file, &index));
+    TEST_ASSERT_EQUAL(2, index.field);
+    TEST_ASSERT_EQUAL(2, index.block_size);
+    TEST_ASSERT_EQUAL(4, index.n_entries);
+
+    int expected_keys[] = {10, 20, 20, 40};
+    char line[RECORD_LINE_BUFFER_SIZE];
+    for (size_t i = 0; i < index.n_entries; i++) {
+        TEST_ASSERT_EQUAL_INT(expected_keys[i], index.keys[i].field2);
+
+        fseek(sorted_csv, index.offsets[i], SEEK_SET);
+        fgets(line, sizeof(line), sorted_csv);
+        TEST_ASSERT_EQUAL_INT(expected_keys[i], atoi(strchr(strchr(line, ',') + 1, ',') + 1));
+    }
+
+    sparse_index_free(&index);
+    fclose(index_file);
+    fclose(sorted_csv);
+}
+
+/**
+ * @brief Unit test for point and range lookups through a sparse index.
+ * 
+ * This test validates the behavior of `sparse_index_lookup`. It checks:
+ * - If a point lookup returns every record with the key, across block boundaries.
+ * - If a range lookup returns the records of the range in file order.
+ * - If a lookup outside of the keys of the file returns nothing, as does an inverted range.
+ * - If field2 keys far apart, whose difference overflows an int, are ordered correctly.
+ * - If lookups on field1 work on string keys.
+ */
+void test_sparse_index_lookup() {
+    FILE* sorted_csv = create_temp_file(sorted_by_field2);
+    SparseIndex index;
+    index_temp_file(sorted_csv, 2, 2, &index);
+
+    Record low;
+    Record high;
+    char buffer[1024];
+
+    FILE* out = tmpfile();
+    TEST_ASSERT_TRUE(parse_index_key(2, "20", &low));
+    TEST_ASSERT_EQUAL(3, sparse_index_lookup(sorted_csv, &index, &low, &low, out));
+    rewind(out);
+    buffer[fread(buffer, 1, sizeof(buffer) - 1, out)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("1,Alice,20,3.5\n4,Dave,20,4.5\n2,Bob,20,5.5\n", buffer);
+    fclose(out);
+
+    out = tmpfile();
+    TEST_ASSERT_TRUE(parse_index_key(2, "12", &low));
+    TEST_ASSERT_TRUE(parse_index_key(2, "30", &high));
+    TEST_ASSERT_EQUAL(5, sparse_index_lookup(sorted_csv, &index, &low, &high, out));
+    fclose(out);
+
+    out = tmpfile();
+    TEST_ASSERT_TRUE(parse_index_key(2, "41", &low));
+    TEST_ASSERT_TRUE(parse_index_key(2, "50", &high));
+    TEST_ASSERT_EQUAL(0, sparse_index_lookup(sorted_csv, &index, &low, &high, out));
+    TEST_ASSERT_EQUAL(0, sparse_index_lookup(sorted_csv, &index, &high, &low, out));
+    fclose(out);
+
+    sparse_index_free(&index);
+    fclose(sorted_csv);
+
+    sorted_csv = create_temp_file("1,A,-2000000000,1.0\n2,B,-1000000000,2.0\n3,C,1000000000,3.0\n4,D,2000000000,4.0\n");
+    index_temp_file(sorted_csv, 2, 1, &index);
+
+    out = tmpfile();
+    TEST_ASSERT_TRUE(parse_index_key(2, "2000000000", &low));
+    TEST_ASSERT_EQUAL(1, sparse_index_lookup(sorted_csv, &index, &low, &low, out));
+    TEST_ASSERT_TRUE(parse_index_key(2, "-2000000000", &low));
+    TEST_ASSERT_TRUE(parse_index_key(2, "1000000000", &high));
+    TEST_ASSERT_EQUAL(3, sparse_index_lookup(sorted_csv, &index, &low, &high, out));
+    fclose(out);
+
+    sparse_index_free(&index);
+    fclose(sorted_csv);
+
+    sorted_csv = create_temp_file("2,Alice,1,1.0\n1,Bob,2,2.0\n3,Bob,3,3.0\n4,Carol,4,4.0\n");
+    index_temp_file(sorted_csv, 1, 1, &index);
+
+    out = tmpfile();
+    TEST_ASSERT_TRUE(parse_index_key(1, "B", &low));
+    TEST_ASSERT_TRUE(parse_index_key(1, "Bz", &high));
+    TEST_ASSERT_EQUAL(2, sparse_index_lookup(sorted_csv, &index, &low, &high, out));
+    field1_free(&low.field1);
+    field1_free(&high.field1);
+    fclose(out);
+
+    sparse_index_free(&index);
+    fclose(sorted_csv);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file test_sparse_index.h
+ * @brief Unit test declarations for the sparse index sidecars.
+ *
+ * This header file declares test cases for building, loading and searching
+ * the sparse index of a sorted CSV file.
+ * 
+ * @see sparse_index.h
+ */
+
+#ifndef _TEST_SPARSE_INDEX_H
+#define _TEST_SPARSE_INDEX_H
+
+#include "sparse_index.h"
+#include "unity.h"
+
+
+/**
+ * @brief Test case for the `build_sparse_index` and `load_sparse_index` functions.
+ *
+ * Verifies that one entry is written for every block of lines, with the offset
+ * and key of the first line of the block, and that loading the sidecar
+ * restores the same entries.
+ */
+void test_build_and_load_sparse_index();
+
+/**
+ * @brief Test case for the `sparse_index_lookup` function.
+ *
+ * Verifies that point and range lookups return exactly the lines of the sorted
+ * file whose key lies in the range, including keys spanning several blocks.
+ */
+void test_sparse_index_lookup();
+
+#endif // _TEST_SPARSE_INDEX_H
@@ -0,0 +1,22 @@
+/**
+ * @file test_utils.c
+ * @brief Utility functions shared by the unit tests.
+ * 
+ * This file contains the implementation of the helpers used by several test files.
+ */
+
+#include "test_utils.h"
+#include <stdlib.h>
+
+FILE* create_temp_file(const char* content) {
+    FILE* temp = tmpfile();
+    if (temp == NULL) {
+        fprintf(stderr, "Unable to create temporary file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs(content, temp);
+    rewind(temp);
+
+    return temp;
+}
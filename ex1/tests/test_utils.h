@@ -0,0 +1,30 @@
+/**
+ * @file test_utils.h
+ * @brief Utility functions shared by the unit tests.
+ *
+ * This header file declares the helpers used by several test files to build
+ * their input files.
+ */
+
+#ifndef _TEST_UTILS_H
+#define _TEST_UTILS_H
+
+#include <stdio.h>
+
+
+/**
+ * @brief Utility function to create a temporary file for testing purposes.
+ * 
+ * This function creates a temporary file, writes the provided content to it, and returns the file pointer.
+ * The file is created using the `tmpfile` function and its content is written using `fputs`.
+ * The file pointer is rewound before returning it.
+ * 
+ * @param content The content to write to the temporary file.
+ * 
+ * @return FILE* A pointer to the created temporary file.
+ * 
+ * @note The function exits the program if the temporary file cannot be created.
+ */
+FILE* create_temp_file(const char* content);
+
+#endif // _TEST_UTILS_H
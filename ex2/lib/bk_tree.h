@@ -0,0 +1,88 @@
+/**
+ * @file bk_tree.h
+ * @brief Interface for a BK-tree index over the words of a dictionary.
+ *
+ * A BK-tree stores every word in a node, and each child is labelled with its edit distance
+ * from the parent. Since the edit distance is a metric, the triangle inequality tells that a
+ * word at distance `d` from a node and at most `k` from the searched word can only lie below
+ * the children labelled from `d - k` to `d + k`, so the other subtrees are skipped.
+ *
+ * The tree is stored in flat arrays, its nodes in breadth-first order: the children of a node
+ * are contiguous and sorted by their label.
+ */
+
+#ifndef _BK_TREE_H
+#define _BK_TREE_H
+
+#include <stdlib.h>
+
+
+/**
+ * @brief BK-tree over the words of a dictionary.
+ */
+typedef struct _BkTree {
+    char** dictionary;   ///< Words of the dictionary (not owned by the tree).
+    int n_nodes;         ///< Number of nodes, i.e. of words in the dictionary.
+    int* word_index;     ///< Index in the dictionary of the word of each node.
+    int* edge;           ///< Edit distance between the word of each node and the one of its parent.
+    int* first_child;    ///< Node of the first child of each node.
+    int* n_children;     ///< Number of children of each node.
+
+} BkTree, *BkTreePtr;
+
+/**
+ * @brief Builds a BK-tree over the words of a dictionary.
+ *
+ * The words are inserted in dictionary order, duplicated words included, so that the searches
+ * can break ties between words at the same distance on their position in the dictionary.
+ * The tree refers to the words of the dictionary, which must outlive it.
+ *
+ * @param tree Pointer to the tree to build.
+ * @param dictionary Array of the words of the dictionary.
+ * @param words_in_dictionary Number of words in the dictionary.
+ * @return The number of nodes of the tree, or -1 if an error occurs.
+ */
+int bk_tree_build(BkTreePtr tree, char** dictionary, int words_in_dictionary);
+
+/**
+ * @brief Frees the memory allocated for a BK-tree.
+ *
+ * @param tree Pointer to the tree.
+ */
+void bk_tree_free(BkTreePtr tree);
+
+/**
+ * @brief Returns the memory used by a BK-tree, the words of the dictionary excluded.
+ *
+ * @param tree Pointer to the tree.
+ * @return The size of the arrays of the nodes, in bytes.
+ */
+size_t bk_tree_memory_usage(const BkTree* tree);
+
+/**
+ * @brief Finds the word of the dictionary closest to a given word.
+ *
+ * The result is the one of a linear scan of the dictionary: among the words at the minimum
+ * distance, the first one in dictionary order.
+ *
+ * @param tree Pointer to the tree.
+ * @param word The word to look for.
+ * @param closest_word Receives the closest word of the dictionary.
+ * @param min_distance Receives the edit distance between `word` and `closest_word`.
+ * @return The index of the closest word in the dictionary, or -1 if the tree is empty or `word` is NULL.
+ */
+int bk_tree_find_closest(const BkTree* tree, const char* word, const char** closest_word, int* min_distance);
+
+/**
+ * @brief Finds all the words of the dictionary within a given edit distance of a word.
+ *
+ * @param tree Pointer to the tree.
+ * @param word The word to look for.
+ * @param k The maximum edit distance.
+ * @param matches Receives an array, to be freed by the caller, with the indexes in the dictionary
+ *                of the words found, in dictionary order.
+ * @return The number of words found, or -1 if an error occurs.
+ */
+int bk_tree_find_within(const BkTree* tree, const char* word, int k, int** matches);
+
+#endif // _BK_TREE_H
@@ -0,0 +1,59 @@
+/**
+ * @file closest_word.h
+ * @brief Interface for finding the closest word of a dictionary with a scan of its length buckets.
+ *
+ * Since only insertions and deletions are allowed, the edit distance between two words is at
+ * least the difference of their lengths. The buckets of the dictionary are therefore scanned
+ * from the length of the word looked for outwards, and the scan stops once the length gap
+ * exceeds the best distance found so far: the remaining buckets cannot hold a closer word.
+ * Words up to `EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH` characters are compared with the interleaved
+ * blocks of a bucket by `edit_distance_batch`, longer ones with its words one at a time.
+ */
+
+#ifndef _CLOSEST_WORD_H
+#define _CLOSEST_WORD_H
+
+#include "text_io.h"
+
+
+/**
+ * @brief Word of the dictionary suggested for a word, with its distance.
+ */
+typedef struct _Suggestion {
+    const char* word;    ///< Word of the dictionary.
+    int index;           ///< Index of the word in the dictionary.
+    int distance;        ///< Edit distance between the word looked for and `word`.
+
+} Suggestion;
+
+/**
+ * @brief Finds the word of the dictionary closest to a given word.
+ *
+ * The result is the one of a linear scan of the dictionary in file order: among the words at
+ * the minimum distance, the first one in the file.
+ *
+ * @param word The word to look for.
+ * @param dictionary Pointer to the dictionary, loaded by `load_dictionary`.
+ * @param closest_word Receives the closest word of the dictionary.
+ * @param min_distance Receives the edit distance between `word` and `closest_word`.
+ * @return The index of the closest word in the dictionary, or -1 if the dictionary is empty or `word` is NULL.
+ */
+int find_closest_word(const char* word, const Dictionary* dictionary, const char** closest_word, int* min_distance);
+
+/**
+ * @brief Finds the `k` words of the dictionary closest to a given word.
+ *
+ * The words are ranked by distance, then by position in the file, so the first suggestion is the
+ * word returned by `find_closest_word`. The best words found so far are kept in a bounded max-heap,
+ * whose worst word bounds the distances computed and the length buckets scanned, as the best word
+ * does for `find_closest_word`.
+ *
+ * @param word The word to look for.
+ * @param dictionary Pointer to the dictionary, loaded by `load_dictionary`.
+ * @param k The number of words to find.
+ * @param suggestions Array of `k` entries receiving the closest words, from the closest one.
+ * @return The number of words found, `k` unless the dictionary holds fewer words, or -1 if an error occurs.
+ */
+int find_closest_words(const char* word, const Dictionary* dictionary, int k, Suggestion* suggestions);
+
+#endif // _CLOSEST_WORD_H
@@ -0,0 +1,86 @@
+/**
+ * @file correction_cache.h
+ * @brief Interface for a bounded cache of the corrections of words, evicting the least recently used one.
+ *
+ * Texts repeat the same words over and over: the cache remembers the closest word found for a
+ * word, as its index in the dictionary, and its distance, so that the next occurrences of the
+ * word skip the search. It holds at most a fixed number of words, which keeps its memory bounded
+ * on inputs of any size: once full, the word used least recently makes room for the new one.
+ *
+ * The words are looked up in a hash table with chaining, and kept in a doubly linked list from
+ * the most to the least recently used, both stored in flat arrays of entries. A mutex guards the
+ * cache, which may be shared by the threads correcting the words.
+ */
+
+#ifndef _CORRECTION_CACHE_H
+#define _CORRECTION_CACHE_H
+
+#include <stdlib.h>
+#include <pthread.h>
+
+
+#define CORRECTION_CACHE_DEFAULT_CAPACITY 65536
+
+/**
+ * @brief Bounded cache of the corrections of words.
+ */
+typedef struct _CorrectionCache {
+    int capacity;        ///< Maximum number of words in the cache.
+    int n_entries;       ///< Number of words in the cache.
+    char** keys;         ///< Copy of the word of each entry.
+    int* word_index;     ///< Index in the dictionary of the closest word of each entry.
+    int* distance;       ///< Edit distance between the word of each entry and its closest word.
+    int* chain_next;     ///< Next entry of the same bucket, or -1.
+    int* newer;          ///< Entry used just after each entry, or -1 for the most recent one.
+    int* older;          ///< Entry used just before each entry, or -1 for the least recent one.
+    int* buckets;        ///< First entry of each bucket, or -1.
+    size_t bucket_mask;  ///< Number of buckets minus one, the number of buckets being a power of two.
+    int most_recent;     ///< Entry used most recently, or -1 if the cache is empty.
+    int least_recent;    ///< Entry used least recently, or -1 if the cache is empty.
+    size_t hits;         ///< Number of lookups that found their word.
+    size_t misses;       ///< Number of lookups that did not find their word.
+    pthread_mutex_t lock;
+
+} CorrectionCache, *CorrectionCachePtr;
+
+/**
+ * @brief Initializes an empty cache.
+ *
+ * @param cache Pointer to the cache to initialize.
+ * @param capacity Maximum number of words in the cache.
+ * @return The capacity of the cache, or -1 if the capacity is not positive or an error occurs.
+ */
+int correction_cache_init(CorrectionCachePtr cache, int capacity);
+
+/**
+ * @brief Frees the memory allocated for a cache.
+ *
+ * @param cache Pointer to the cache.
+ */
+void correction_cache_free(CorrectionCachePtr cache);
+
+/**
+ * @brief Looks up the correction of a word, making it the most recently used one.
+ *
+ * @param cache Pointer to the cache.
+ * @param word The word to look for.
+ * @param distance Receives the edit distance between the word and its closest word.
+ * @return The index in the dictionary of the closest word, or -1 if the word is not in the cache.
+ */
+int correction_cache_get(CorrectionCachePtr cache, const char* word, int* distance);
+
+/**
+ * @brief Stores the correction of a word as the most recently used one.
+ *
+ * When the cache is full, the least recently used word is evicted. A word already in the cache
+ * has its correction replaced.
+ *
+ * @param cache Pointer to the cache.
+ * @param word The word, copied by the cache.
+ * @param word_index Index in the dictionary of the closest word.
+ * @param distance Edit distance between the word and its closest word.
+ * @return 1 on success, or 0 if the word cannot be copied.
+ */
+int correction_cache_put(CorrectionCachePtr cache, const char* word, int word_index, int distance);
+
+#endif // _CORRECTION_CACHE_H
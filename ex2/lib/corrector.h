@@ -0,0 +1,113 @@
+/**
+ * @file corrector.h
+ * @brief Interface for correcting words with one of the search engines over a dictionary.
+ *
+ * A corrector bundles a dictionary with the index of the chosen engine, built once, and
+ * corrects batches of words on several threads. The dictionary and the index are only read
+ * by the searches, so the threads share them without synchronization. An optional cache, guarded
+ * by its own lock, remembers the corrections of the words already met.
+ */
+
+#ifndef _CORRECTOR_H
+#define _CORRECTOR_H
+
+#include "text_io.h"
+#include "bk_tree.h"
+#include "symspell.h"
+#include "trie.h"
+#include "qgram_index.h"
+#include "correction_cache.h"
+
+
+/**
+ * @brief Search structures the closest words can be looked up with.
+ */
+typedef enum _Engine {
+    ENGINE_SCAN,    ///< Scan of the length buckets of the dictionary.
+    ENGINE_BKTREE,  ///< BK-tree built over the dictionary.
+    ENGINE_SYMSPELL,///< SymSpell deletion index, falling back to the scan.
+    ENGINE_TRIE,    ///< Trie of the dictionary, searched with one row of the table per level.
+    ENGINE_QGRAM    ///< Inverted index of the q-grams of the dictionary, falling back to the scan.
+
+} Engine;
+
+/**
+ * @brief Dictionary and index of the engine used to correct words.
+ */
+typedef struct _Corrector {
+    const Dictionary* dictionary; ///< Dictionary the words are corrected with (not owned by the corrector).
+    Engine engine;                ///< Engine used to find the closest words.
+    BkTree tree;                  ///< BK-tree of the dictionary, for `ENGINE_BKTREE`.
+    SymSpellIndex symspell;       ///< Deletion index of the dictionary, for `ENGINE_SYMSPELL`.
+    Trie trie;                    ///< Trie of the dictionary, for `ENGINE_TRIE`.
+    QGramIndex qgram;             ///< Q-gram index of the dictionary, for `ENGINE_QGRAM`.
+    CorrectionCache* cache;       ///< Cache of the corrections, or NULL if it is disabled.
+
+} Corrector, *CorrectorPtr;
+
+/**
+ * @brief Correction of a word: the closest word of the dictionary and its distance.
+ */
+typedef struct _Correction {
+    const char* closest_word; ///< Closest word of the dictionary.
+    int distance;             ///< Edit distance between the word and `closest_word`.
+
+} Correction;
+
+/**
+ * @brief Initializes a corrector, building the index of its engine.
+ *
+ * @param corrector Pointer to the corrector to initialize.
+ * @param dictionary Pointer to the dictionary, loaded by `load_dictionary`, which must outlive the corrector.
+ * @param engine Engine used to find the closest words.
+ * @return The number of words of the dictionary, or -1 if the index cannot be built.
+ */
+int corrector_init(CorrectorPtr corrector, const Dictionary* dictionary, Engine engine);
+
+/**
+ * @brief Enables the cache of the corrections of a corrector.
+ *
+ * @param corrector Pointer to the corrector, initialized by `corrector_init`.
+ * @param capacity Maximum number of words in the cache.
+ * @return The capacity of the cache, or -1 if the capacity is not positive or an error occurs.
+ */
+int corrector_enable_cache(CorrectorPtr corrector, int capacity);
+
+/**
+ * @brief Frees the memory allocated for the index and the cache of a corrector.
+ *
+ * @param corrector Pointer to the corrector.
+ */
+void corrector_free(CorrectorPtr corrector);
+
+/**
+ * @brief Finds the word of the dictionary closest to a given word.
+ *
+ * Words of the dictionary are answered by its hash set, the other ones by the cache when it holds
+ * them, and by the engine otherwise, the result being then stored in the cache. Every
+ * engine returns the result of a linear scan of the dictionary: among the words at the minimum
+ * distance, the first one in the file.
+ *
+ * @param corrector Pointer to the corrector.
+ * @param word The word to correct.
+ * @param correction Receives the closest word and its distance.
+ * @return The index of the closest word in the dictionary, or -1 if `word` is NULL.
+ */
+int correct_word(const Corrector* corrector, const char* word, Correction* correction);
+
+/**
+ * @brief Corrects a batch of words on several threads.
+ *
+ * The threads take the words by small chunks from a shared counter, so that a few expensive
+ * words do not hold back the others, and store each correction at the position of its word.
+ *
+ * @param corrector Pointer to the corrector.
+ * @param words Array of the words to correct.
+ * @param n_words Number of words to correct.
+ * @param n_threads Number of threads, 1 to correct the words on the calling thread.
+ * @param corrections Array of `n_words` entries receiving the corrections, in the order of `words`.
+ * @return The number of words corrected, or -1 if an error occurs.
+ */
+int correct_words(const Corrector* corrector, char** words, int n_words, int n_threads, Correction* corrections);
+
+#endif // _CORRECTOR_H
@@ -0,0 +1,66 @@
+/**
+ * @file dictionary_image.h
+ * @brief Interface for compiling a dictionary into a binary image, and loading it back without parsing.
+ *
+ * Loading a text dictionary reads it line by line, allocates every word and rebuilds its buckets,
+ * hash set and interleaved blocks. An image stores all of them as they are laid out in memory:
+ * a header, then the words as one blob of null-terminated strings, the offset of each word in the
+ * blob, and the arrays of the `Dictionary`, each section aligned on `DICTIONARY_IMAGE_ALIGNMENT`
+ * bytes. Loading an image maps the file in memory, checks the header and the bounds of every
+ * section, and points the dictionary into it: only the array of pointers to the words is built.
+ * Where `mmap` is not available, or fails, the file is read at once into an aligned buffer.
+ *
+ * An image stores integers in the byte order and sizes of the machine that compiled it, which
+ * the header records: it is meant to be compiled where it is used.
+ */
+
+#ifndef _DICTIONARY_IMAGE_H
+#define _DICTIONARY_IMAGE_H
+
+#include "text_io.h"
+
+
+#define DICTIONARY_IMAGE_MAGIC "EX2DICT"
+#define DICTIONARY_IMAGE_VERSION 1
+#define DICTIONARY_IMAGE_ALIGNMENT 64 // cache line, a multiple of the alignment of the interleaved blocks
+
+/**
+ * @brief Tells whether a file is a dictionary image, from its magic number.
+ *
+ * The file pointer is reset to the beginning of the file.
+ *
+ * @param file_fp File pointer to the file.
+ * @return 1 if the file starts with the magic number of an image, 0 otherwise.
+ */
+int is_dictionary_image(FILE* file_fp);
+
+/**
+ * @brief Writes a dictionary as a binary image.
+ *
+ * @param dictionary Pointer to the dictionary, loaded by `load_dictionary` or `load_dictionary_image`.
+ * @param image_fp File pointer to the image, opened for writing in binary mode.
+ * @return The size of the image in bytes, or -1 if an error occurs.
+ */
+long save_dictionary_image(const Dictionary* dictionary, FILE* image_fp);
+
+/**
+ * @brief Loads a dictionary from a binary image.
+ *
+ * The dictionary points into the image, which stays mapped, or allocated, until `free_dictionary`.
+ *
+ * @param image_fp File pointer to the image, opened for reading in binary mode.
+ * @param dictionary Pointer to the dictionary to fill.
+ * @return The number of words of the dictionary, or -1 if the file is not a valid image or an error occurs.
+ */
+int load_dictionary_image(FILE* image_fp, DictionaryPtr dictionary);
+
+/**
+ * @brief Releases the image of a dictionary loaded by `load_dictionary_image`.
+ *
+ * Called by `free_dictionary`, which should be used instead.
+ *
+ * @param dictionary Pointer to the dictionary.
+ */
+void free_dictionary_image(DictionaryPtr dictionary);
+
+#endif // _DICTIONARY_IMAGE_H
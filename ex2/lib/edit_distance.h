@@ -6,6 +6,10 @@
 #ifndef _EDIT_DISTANCE_H
 #define _EDIT_DISTANCE_H
 
+#define EDIT_DISTANCE_SCRATCH_SIZE 1024 // longest shorter string handled without allocation
+#define EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH 64 // longest pattern handled by the bit-parallel kernel
+#define EDIT_DISTANCE_BATCH_LANES 16 // words compared at once by the batch kernel
+
 /**
  * @brief Computes the edit distance between two strings using a recursive approach.
  * 
@@ -22,14 +26,67 @@ int edit_distance(const char *s1, const char* s2);
  * @brief Computes the edit distance between two strings using a dynamic programming approach.
  * 
  * The edit distance is the minimum number of operations (insertions, deletions, or substitutions)
- * required to transform one string into another. This implementation uses dynamic programming
- * to improve efficiency.
+ * required to transform one string into another. This implementation fills the table bottom-up,
+ * keeping a single row of it, which spans the shorter string. When that string is at most
+ * `EDIT_DISTANCE_SCRATCH_SIZE` characters long the row is a thread-local buffer, so the
+ * function performs no allocation and can be called concurrently from several threads.
  * 
  * @param s1 The first string.
  * @param s2 The second string.
- * @return The edit distance between the two strings.
+ * @return The edit distance between the two strings, or -1 if a string is NULL or
+ *         the row of a very long string cannot be allocated.
  */
 int edit_distance_dyn(const char *s1, const char* s2);
 
+/**
+ * @brief Computes the edit distance between a short pattern and a string with a bit-parallel algorithm.
+ * 
+ * The same distance as `edit_distance_dyn` is derived from the longest common subsequence of the
+ * two strings, whose table column is packed in a single 64-bit word: each character of `s2` costs
+ * a handful of word operations instead of one cell per character of `s1`, i.e. O(n) operations
+ * instead of O(m * n).
+ * 
+ * @param s1 The pattern, at most `EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH` characters long.
+ * @param s2 The string to compare the pattern with, of any length.
+ * @return The edit distance between the two strings, or -1 if a string is NULL or
+ *         the pattern is too long.
+ */
+int edit_distance_bitparallel(const char *s1, const char* s2);
+
+/**
+ * @brief Computes the edit distances between a short pattern and a block of words of the same length.
+ * 
+ * The words are interleaved: byte `j * EDIT_DISTANCE_BATCH_LANES + lane` of the block is the
+ * character `j` of the word of the given lane. Each lane keeps the column of the table of its word
+ * in a 64-bit word, as `edit_distance_bitparallel` does, and the lanes are advanced together one
+ * character at a time: the match masks of the pattern are built once for the whole block, and
+ * the updates of the lanes are independent of each other.
+ * 
+ * @param word The pattern, at most `EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH` characters long.
+ * @param block The interleaved words, `length * EDIT_DISTANCE_BATCH_LANES` bytes.
+ * @param length The length of the words of the block.
+ * @param distances Receives the edit distance between the pattern and the word of each lane.
+ * @return 0 on success, or -1 if the pattern is NULL or too long.
+ */
+int edit_distance_batch(const char *word, const unsigned char* block, int length, int* distances);
+
+/**
+ * @brief Computes the edit distance between two strings, as long as it does not exceed a bound.
+ * 
+ * Only the diagonal band of the dynamic programming table of width `2k + 1` is computed, and
+ * the computation stops as soon as every cell of a row exceeds `k`. Strings whose lengths differ
+ * by more than `k` are rejected without looking at their characters, and when the shorter string
+ * is at most `EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH` characters long the distance is computed by
+ * `edit_distance_bitparallel`, which is faster than the band on such strings.
+ * 
+ * @param s1 The first string.
+ * @param s2 The second string.
+ * @param k The bound on the distance.
+ * @return The edit distance between the two strings if it is at most `k`, `k + 1` otherwise,
+ *         or -1 if a string is NULL, `k` is negative or the row of a very long string cannot
+ *         be allocated.
+ */
+int edit_distance_bounded(const char *s1, const char* s2, int k);
+
 
 #endif // _EDIT_DISTANCE_H
\ No newline at end of file
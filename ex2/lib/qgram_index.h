@@ -0,0 +1,96 @@
+/**
+ * @file qgram_index.h
+ * @brief Interface for an inverted index of the q-grams of the words of a dictionary, filtering the candidates by count.
+ *
+ * The q-grams of a word are its substrings of `QGRAM_LENGTH` characters, the word being padded
+ * with `QGRAM_LENGTH - 1` characters on each side: a word of length `l` has `l + QGRAM_LENGTH - 1`
+ * of them. An insertion or a deletion changes at most `QGRAM_LENGTH` q-grams of a word, so two
+ * words within distance `k` of each other share at least `max(|G1|, |G2|) - k * QGRAM_LENGTH` of
+ * their q-grams, counted with their multiplicity. Conversely, the number of q-grams a dictionary
+ * word shares with a query bounds their distance from below.
+ *
+ * The index maps each q-gram to the sorted list of the words it occurs in, a word being listed
+ * once per occurrence. A search merges the lists of the q-grams of the query, which yields the
+ * words sharing at least one q-gram with it and how many, and only computes the edit distance of
+ * the words whose bound is below the best distance found so far, from the lowest bound. The words
+ * sharing no q-gram with the query are not visited: their bound, `ceil(|G| / QGRAM_LENGTH)` for
+ * a query of `|G|` q-grams, is the radius within which the index is exact. The longest lists of
+ * the query, up to `QGRAM_LENGTH - 1` q-grams, are not merged but counted as shared by every
+ * word, which lowers the radius by at most one.
+ *
+ * The distinct q-grams are stored sorted in a flat array, looked up by binary search, and point
+ * to a shared array of word indexes. The lengths of the words are kept next to them, so that
+ * bounding a candidate does not touch its characters.
+ */
+
+#ifndef _QGRAM_INDEX_H
+#define _QGRAM_INDEX_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+#define QGRAM_LENGTH 3
+#define QGRAM_MAX_WORD_LENGTH UINT16_MAX
+
+/**
+ * @brief Inverted index of the q-grams of the words of a dictionary.
+ */
+typedef struct _QGramIndex {
+    char** dictionary;       ///< Words of the dictionary (not owned by the index).
+    int words_in_dictionary; ///< Number of words in the dictionary.
+    uint16_t* lengths;       ///< Length of each word, read without touching the words themselves.
+    size_t n_grams;          ///< Number of distinct q-grams.
+    uint32_t* grams;         ///< Distinct q-grams, packed one character per byte, in increasing order.
+    uint32_t* starts;        ///< Position in `postings` of the words of each q-gram, `n_grams + 1` entries.
+    int* postings;           ///< Indexes of the words of every q-gram, in dictionary order, once per occurrence.
+    size_t n_postings;       ///< Number of entries of `postings`.
+
+} QGramIndex, *QGramIndexPtr;
+
+/**
+ * @brief Builds the q-gram index of a dictionary.
+ *
+ * The index refers to the words of the dictionary, which must outlive it.
+ * The words must be at most `QGRAM_MAX_WORD_LENGTH` characters long.
+ *
+ * @param index Pointer to the index to build.
+ * @param dictionary Array of the words of the dictionary.
+ * @param words_in_dictionary Number of words in the dictionary.
+ * @return The number of words indexed, or -1 if a word is too long or an error occurs.
+ */
+int qgram_build(QGramIndexPtr index, char** dictionary, int words_in_dictionary);
+
+/**
+ * @brief Frees the memory allocated for a q-gram index.
+ *
+ * @param index Pointer to the index.
+ */
+void qgram_free(QGramIndexPtr index);
+
+/**
+ * @brief Returns the memory used by a q-gram index, the words of the dictionary excluded.
+ *
+ * @param index Pointer to the index.
+ * @return The size of the q-grams, of the word indexes and of the lengths of the words, in bytes.
+ */
+size_t qgram_memory_usage(const QGramIndex* index);
+
+/**
+ * @brief Finds the word of the dictionary closest to a given word, if the count filter proves it.
+ *
+ * Among the words at the minimum distance, the first one in dictionary order is returned, as a
+ * linear scan of the dictionary would. When no word is found below the distance of the words
+ * sharing no q-gram with `word`, nothing is written and the caller is expected to fall back to
+ * another search.
+ *
+ * @param index Pointer to the index.
+ * @param word The word to look for.
+ * @param closest_word Receives the closest word of the dictionary.
+ * @param min_distance Receives the edit distance between `word` and `closest_word`.
+ * @return The index of the closest word in the dictionary, or -1 if the filter cannot rule out the words
+ *         sharing no q-gram with `word`, `word` is NULL or an error occurs.
+ */
+int qgram_find_closest(const QGramIndex* index, const char* word, const char** closest_word, int* min_distance);
+
+#endif // _QGRAM_INDEX_H
@@ -0,0 +1,89 @@
+/**
+ * @file symspell.h
+ * @brief Interface for a SymSpell-style deletion index over the words of a dictionary.
+ *
+ * Since the edit distance only allows insertions and deletions, two words are within distance
+ * `k` of each other exactly when deleting `d1` characters from the first one and `d2` from the
+ * second one, with `d1 + d2 <= k`, yields the same string (their longest common subsequence).
+ * The index maps every variant of the dictionary words obtained with at most `max_distance`
+ * deletions to the words it comes from: the words within `max_distance` of a query are then
+ * among the words listed under the deletion variants of the query, and are confirmed with the
+ * edit distance.
+ *
+ * The variants are stored by their 64-bit hash in a flat open-addressed table, whose slots point
+ * to a shared array of word indexes. A hash collision can only add candidates, which are then
+ * rejected by the edit distance.
+ */
+
+#ifndef _SYMSPELL_H
+#define _SYMSPELL_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+#define SYMSPELL_DEFAULT_MAX_DISTANCE 2
+
+/**
+ * @brief Deletion index over the words of a dictionary.
+ */
+typedef struct _SymSpellIndex {
+    char** dictionary;       ///< Words of the dictionary (not owned by the index).
+    int words_in_dictionary; ///< Number of words in the dictionary.
+    int max_distance;        ///< Maximum number of deletions of the variants, i.e. radius of the searches.
+    int max_word_length;     ///< Length of the longest word of the dictionary.
+    size_t capacity;         ///< Number of slots of the table, a power of two.
+    size_t n_variants;       ///< Number of distinct variants stored in the table.
+    uint64_t* keys;          ///< Hash of the variant of each slot, 0 for an empty slot.
+    uint32_t* starts;        ///< Position in `postings` of the words of each slot.
+    uint32_t* counts;        ///< Number of words of each slot.
+    int* postings;           ///< Indexes of the words of every variant, in dictionary order.
+    size_t n_postings;       ///< Number of entries of `postings`.
+
+} SymSpellIndex, *SymSpellIndexPtr;
+
+/**
+ * @brief Builds the deletion index of a dictionary.
+ *
+ * The index refers to the words of the dictionary, which must outlive it.
+ *
+ * @param index Pointer to the index to build.
+ * @param dictionary Array of the words of the dictionary.
+ * @param words_in_dictionary Number of words in the dictionary.
+ * @param max_distance Maximum number of deletions of the variants.
+ * @return The number of words indexed, or -1 if an error occurs.
+ */
+int symspell_build(SymSpellIndexPtr index, char** dictionary, int words_in_dictionary, int max_distance);
+
+/**
+ * @brief Frees the memory allocated for a deletion index.
+ *
+ * @param index Pointer to the index.
+ */
+void symspell_free(SymSpellIndexPtr index);
+
+/**
+ * @brief Returns the memory used by a deletion index, the words of the dictionary excluded.
+ *
+ * @param index Pointer to the index.
+ * @return The size of the table and of the word indexes, in bytes.
+ */
+size_t symspell_memory_usage(const SymSpellIndex* index);
+
+/**
+ * @brief Finds the word of the dictionary closest to a given word, if it is within the radius of the index.
+ *
+ * Among the words at the minimum distance, the first one in dictionary order is returned, as a
+ * linear scan of the dictionary would. When no word is within `max_distance` of `word`, nothing
+ * is written and the caller is expected to fall back to another search.
+ *
+ * @param index Pointer to the index.
+ * @param word The word to look for.
+ * @param closest_word Receives the closest word of the dictionary.
+ * @param min_distance Receives the edit distance between `word` and `closest_word`.
+ * @return The index of the closest word in the dictionary, or -1 if no word is within `max_distance`
+ *         of `word` or `word` is NULL.
+ */
+int symspell_find_closest(const SymSpellIndex* index, const char* word, const char** closest_word, int* min_distance);
+
+#endif // _SYMSPELL_H
@@ -9,11 +9,39 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include "edit_distance.h"
 
 
 #define MAX_LINE_LENGTH 1024
 #define MAX_WORD_LENGTH 32
 
+/**
+ * @brief Words of a dictionary, grouped in buckets by length.
+ *
+ * The words of length `l` are `words[by_length[i]]` for `i` from `bucket_start[l]`
+ * (included) to `bucket_start[l + 1]` (excluded), in dictionary order. The words
+ * are also stored in an open-addressed hash set, which answers exact lookups, and
+ * interleaved by blocks of `EDIT_DISTANCE_BATCH_LANES` words of the same length, the
+ * layout of `edit_distance_batch`: the block `b` of the bucket of length `l` starts at
+ * `interleaved + interleaved_start[l] + b * l * EDIT_DISTANCE_BATCH_LANES`, and its
+ * lanes past the end of the bucket are filled with zeros.
+ */
+typedef struct _Dictionary {
+    char** words;      ///< Words in file order.
+    int n_words;       ///< Number of words.
+    int max_length;    ///< Length of the longest word.
+    int* bucket_start; ///< Start in `by_length` of the bucket of each length, `max_length + 2` entries.
+    int* by_length;    ///< Indexes of the words sorted by length, then by position in the file.
+    int* word_set;     ///< Hash set of the words: index of the first occurrence of a word, or -1 for an empty slot.
+    size_t set_mask;   ///< Number of slots of `word_set` minus one, the number of slots being a power of two.
+    unsigned char* interleaved; ///< Words interleaved by blocks, aligned on the size of a block row.
+    size_t* interleaved_start;  ///< Start in `interleaved` of the blocks of each length, `max_length + 1` entries.
+    void* image;       ///< Image the arrays point into, when loaded by `load_dictionary_image`, or NULL.
+    size_t image_size; ///< Size of `image`, in bytes.
+    int image_mapped;  ///< Non-zero if `image` is mapped in memory, zero if it is allocated.
+
+} Dictionary, *DictionaryPtr;
+
 /**
  * @brief Counts the number of lines in a file.
  *
@@ -54,6 +82,35 @@ int count_words(FILE* file);
  */
 int read_dictionary(FILE* dictionary_fp, char*** dictionary);
 
+/**
+ * @brief Reads a dictionary file into memory and groups its words by length.
+ *
+ * This function reads the words with `read_dictionary`, then builds the buckets
+ * of words of the same length, which let a search skip the words whose length
+ * alone puts them too far from the word looked for.
+ *
+ * @param dictionary_fp File pointer to the dictionary file.
+ * @param dictionary Pointer to the dictionary to fill.
+ * @return The number of words successfully read, or -1 if an error occurs.
+ */
+int load_dictionary(FILE* dictionary_fp, DictionaryPtr dictionary);
+
+/**
+ * @brief Looks a word up in a dictionary.
+ *
+ * @param dictionary Pointer to the dictionary, loaded by `load_dictionary`.
+ * @param word The word to look for.
+ * @return The index of the first occurrence of the word in the dictionary, or -1 if it is not in the dictionary.
+ */
+int dictionary_lookup(const Dictionary* dictionary, const char* word);
+
+/**
+ * @brief Frees the memory allocated for a dictionary by `load_dictionary` or `load_dictionary_image`.
+ *
+ * @param dictionary Pointer to the dictionary.
+ */
+void free_dictionary(DictionaryPtr dictionary);
+
 /**
  * @brief Reads a file to correct into memory.
  *
@@ -67,4 +124,20 @@ int read_dictionary(FILE* dictionary_fp, char*** dictionary);
  */
 int read_to_correct(FILE* to_correct_fp, char*** to_correct);
 
+/**
+ * @brief Reads the next word of a text to correct.
+ *
+ * This function reads the text character by character, skipping the delimiters of
+ * `read_to_correct`, and stores the next word in lowercase. It reads the text once,
+ * without rewinding it, so that it also works on pipes and standard input, and only
+ * needs the buffer of the word: a word that does not fit in the buffer is split in
+ * pieces of `size - 1` characters.
+ *
+ * @param text_fp File pointer to the text.
+ * @param word Buffer receiving the word.
+ * @param size Size of the buffer, at least 2.
+ * @return The length of the word, 0 at the end of the text, or -1 if an error occurs.
+ */
+int read_word(FILE* text_fp, char* word, size_t size);
+
 #endif // _TEXT_IO_H
\ No newline at end of file
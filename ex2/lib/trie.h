@@ -0,0 +1,78 @@
+/**
+ * @file trie.h
+ * @brief Interface for a trie over the words of a dictionary, searched with one row of the edit distance table per level.
+ *
+ * The edit distance between a word and a prefix only depends on the prefix, so the row of the
+ * table of a node of the trie is computed once from the row of its parent, and serves every
+ * word below the node. The trie is searched depth-first, and a subtree is pruned as soon as
+ * the minimum of its row exceeds the best distance found so far: extending the prefix can
+ * only add operations, so no word of the subtree can be closer.
+ *
+ * The trie is stored in flat arrays, its nodes in breadth-first order: the children of a node
+ * are contiguous and sorted by their character.
+ */
+
+#ifndef _TRIE_H
+#define _TRIE_H
+
+#include <stdlib.h>
+
+
+/**
+ * @brief Trie over the words of a dictionary.
+ */
+typedef struct _Trie {
+    char** dictionary;   ///< Words of the dictionary (not owned by the trie).
+    int n_nodes;         ///< Number of nodes, the root included.
+    int max_depth;       ///< Length of the longest word of the dictionary.
+    char* label;         ///< Last character of the prefix of each node.
+    int* word_index;     ///< First word of the dictionary equal to the prefix of each node, or -1.
+    int* min_index;      ///< First word of the dictionary below each node, the node included.
+    int* first_child;    ///< Node of the first child of each node.
+    int* n_children;     ///< Number of children of each node.
+
+} Trie, *TriePtr;
+
+/**
+ * @brief Builds a trie over the words of a dictionary.
+ *
+ * The trie refers to the words of the dictionary, which must outlive it.
+ *
+ * @param trie Pointer to the trie to build.
+ * @param dictionary Array of the words of the dictionary.
+ * @param words_in_dictionary Number of words in the dictionary.
+ * @return The number of nodes of the trie, or -1 if an error occurs.
+ */
+int trie_build(TriePtr trie, char** dictionary, int words_in_dictionary);
+
+/**
+ * @brief Frees the memory allocated for a trie.
+ *
+ * @param trie Pointer to the trie.
+ */
+void trie_free(TriePtr trie);
+
+/**
+ * @brief Returns the memory used by a trie, the words of the dictionary excluded.
+ *
+ * @param trie Pointer to the trie.
+ * @return The size of the arrays of the nodes, in bytes.
+ */
+size_t trie_memory_usage(const Trie* trie);
+
+/**
+ * @brief Finds the word of the dictionary closest to a given word.
+ *
+ * The result is the one of a linear scan of the dictionary: among the words at the minimum
+ * distance, the first one in dictionary order.
+ *
+ * @param trie Pointer to the trie.
+ * @param word The word to look for.
+ * @param closest_word Receives the closest word of the dictionary.
+ * @param min_distance Receives the edit distance between `word` and `closest_word`.
+ * @return The index of the closest word in the dictionary, or -1 if the trie is empty, `word` is NULL
+ *         or an error occurs.
+ */
+int trie_find_closest(const Trie* trie, const char* word, const char** closest_word, int* min_distance);
+
+#endif // _TRIE_H
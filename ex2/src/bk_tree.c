@@ -0,0 +1,268 @@
+/**
+ * @file bk_tree.c
+ * @brief Implementation of the BK-tree index over the words of a dictionary.
+ */
+
+#include "bk_tree.h"
+#include "edit_distance.h"
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+
+
+#define NO_PARENT (-1)
+
+// Exact edit distance, through the fastest kernel available for the two words
+static int distance(const char* s1, const char* s2) {
+    return edit_distance_bounded(s1, s2, INT_MAX);
+}
+
+static int compare_int(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * The tree is first grown with linked lists of siblings indexed by dictionary
+ * position (`first`, `next`, `label`), then laid out breadth-first: the queue
+ * of the visit is the final order of the nodes, and the children of a node are
+ * appended to it together, sorted by label.
+ */
+int bk_tree_build(BkTreePtr tree, char** dictionary, int words_in_dictionary) {
+    if (tree == NULL || dictionary == NULL || words_in_dictionary < 1)
+        return -1;
+
+    memset(tree, 0, sizeof(BkTree));
+
+    int* first = malloc(words_in_dictionary * sizeof(int));
+    int* next = malloc(words_in_dictionary * sizeof(int));
+    int* label = malloc(words_in_dictionary * sizeof(int));
+
+    tree -> word_index = malloc(words_in_dictionary * sizeof(int));
+    tree -> edge = malloc(words_in_dictionary * sizeof(int));
+    tree -> first_child = malloc(words_in_dictionary * sizeof(int));
+    tree -> n_children = malloc(words_in_dictionary * sizeof(int));
+
+    if (!first || !next || !label || !tree -> word_index || !tree -> edge || !tree -> first_child || !tree -> n_children) {
+        free(first);
+        free(next);
+        free(label);
+        bk_tree_free(tree);
+
+        return -1;
+    }
+
+    first[0] = -1;
+    label[0] = 0;
+
+    for (int i = 1; i < words_in_dictionary; i++) {
+        int node = 0;
+
+        first[i] = -1;
+
+        for (;;) {
+            int d = distance(dictionary[node], dictionary[i]);
+
+            int child = first[node];
+            while (child != -1 && label[child] != d)
+                child = next[child];
+
+            if (child == -1) {
+                label[i] = d;
+                next[i] = first[node];
+                first[node] = i;
+                break;
+            }
+
+            node = child;
+        }
+    }
+
+    tree -> dictionary = dictionary;
+    tree -> n_nodes = words_in_dictionary;
+    tree -> word_index[0] = 0;
+    tree -> edge[0] = 0;
+
+    int n_queued = 1;
+    for (int node = 0; node < n_queued; node++) {
+        int start = n_queued;
+
+        for (int child = first[tree -> word_index[node]]; child != -1; child = next[child]) {
+            // Insertion sort on the labels, a node has at most a few dozen children
+            int j = n_queued++;
+            while (j > start && tree -> edge[j - 1] > label[child]) {
+                tree -> word_index[j] = tree -> word_index[j - 1];
+                tree -> edge[j] = tree -> edge[j - 1];
+                j--;
+            }
+
+            tree -> word_index[j] = child;
+            tree -> edge[j] = label[child];
+        }
+
+        tree -> first_child[node] = start;
+        tree -> n_children[node] = n_queued - start;
+    }
+
+    free(first);
+    free(next);
+    free(label);
+
+    return tree -> n_nodes;
+}
+
+void bk_tree_free(BkTreePtr tree) {
+    if (tree == NULL)
+        return;
+
+    free(tree -> word_index);
+    free(tree -> edge);
+    free(tree -> first_child);
+    free(tree -> n_children);
+
+    memset(tree, 0, sizeof(BkTree));
+}
+
+size_t bk_tree_memory_usage(const BkTree* tree) {
+    return tree -> n_nodes * (sizeof(*tree -> word_index) + sizeof(*tree -> edge) + sizeof(*tree -> first_child) + sizeof(*tree -> n_children));
+}
+
+/**
+ * Depth-first visit with an explicit stack of (node, distance of the parent)
+ * pairs, so that a subtree queued under a looser bound is pruned again once
+ * the best distance has improved. The children closest to the label `d` are
+ * pushed last, to be visited first, as they most likely hold close words.
+ * A node is compared with a bound of `best + largest label of its children`:
+ * beyond that neither the node nor any of its children can qualify.
+ */
+int bk_tree_find_closest(const BkTree* tree, const char* word, const char** closest_word, int* min_distance) {
+    if (tree == NULL || tree -> n_nodes < 1 || word == NULL)
+        return -1;
+
+    int* stack = malloc(2 * tree -> n_nodes * sizeof(int));
+    if (stack == NULL)
+        return -1;
+
+    int best_distance = INT_MAX;
+    int best_index = INT_MAX;
+    int n_stacked = 0;
+
+    stack[n_stacked++] = 0;
+    stack[n_stacked++] = NO_PARENT;
+
+    while (n_stacked > 0) {
+        int parent_distance = stack[--n_stacked];
+        int node = stack[--n_stacked];
+
+        if (parent_distance != NO_PARENT && abs(tree -> edge[node] - parent_distance) > best_distance)
+            continue;
+
+        int start = tree -> first_child[node];
+        int end = start + tree -> n_children[node];
+        int max_edge = end > start ? tree -> edge[end - 1] : 0;
+        int bound = best_distance == INT_MAX ? INT_MAX : best_distance + max_edge;
+
+        int index = tree -> word_index[node];
+        int d = edit_distance_bounded(word, tree -> dictionary[index], bound);
+        if (d > bound)
+            continue;
+
+        if (d < best_distance || (d == best_distance && index < best_index)) {
+            best_distance = d;
+            best_index = index;
+
+            // The first exact match met is an ancestor of its duplicates
+            if (d == 0)
+                break;
+        }
+
+        // Push the children in the admissible range from both ends inwards
+        int low = start;
+        int high = end - 1;
+        while (low <= high && tree -> edge[low] < d - best_distance)
+            low++;
+        while (low <= high && tree -> edge[high] > d + best_distance)
+            high--;
+
+        while (low <= high) {
+            int child = abs(tree -> edge[low] - d) > abs(tree -> edge[high] - d) ? low++ : high--;
+
+            stack[n_stacked++] = child;
+            stack[n_stacked++] = d;
+        }
+    }
+
+    free(stack);
+
+    if (closest_word != NULL)
+        *closest_word = tree -> dictionary[best_index];
+
+    if (min_distance != NULL)
+        *min_distance = best_distance;
+
+    return best_index;
+}
+
+int bk_tree_find_within(const BkTree* tree, const char* word, int k, int** matches) {
+    if (tree == NULL || tree -> n_nodes < 1 || word == NULL || k < 0 || matches == NULL)
+        return -1;
+
+    int* stack = malloc(tree -> n_nodes * sizeof(int));
+    int capacity = 16;
+    int n_matches = 0;
+
+    *matches = malloc(capacity * sizeof(int));
+
+    if (stack == NULL || *matches == NULL) {
+        free(stack);
+        free(*matches);
+
+        return -1;
+    }
+
+    int n_stacked = 0;
+    stack[n_stacked++] = 0;
+
+    while (n_stacked > 0) {
+        int node = stack[--n_stacked];
+        int start = tree -> first_child[node];
+        int end = start + tree -> n_children[node];
+        int max_edge = end > start ? tree -> edge[end - 1] : 0;
+        int bound = k + max_edge;
+
+        int index = tree -> word_index[node];
+        int d = edit_distance_bounded(word, tree -> dictionary[index], bound);
+        if (d > bound)
+            continue;
+
+        if (d <= k) {
+            if (n_matches == capacity) {
+                capacity *= 2;
+
+                int* resized = realloc(*matches, capacity * sizeof(int));
+                if (resized == NULL) {
+                    free(stack);
+                    free(*matches);
+
+                    return -1;
+                }
+
+                *matches = resized;
+            }
+
+            (*matches)[n_matches++] = index;
+        }
+
+        for (int child = start; child < end; child++)
+            if (abs(tree -> edge[child] - d) <= k)
+                stack[n_stacked++] = child;
+    }
+
+    free(stack);
+
+    qsort(*matches, n_matches, sizeof(int), compare_int);
+
+    return n_matches;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file closest_word.c
+ * @brief Implementation of the search of the closest word in the length buckets of a dictionary.
+ */
+
+#include "closest_word.h"
+#include "edit_distance.h"
+#include <string.h>
+#include <limits.h>
+
+
+/**
+ * @brief Word found by a search, with its distance.
+ */
+typedef struct _Candidate {
+    int distance;
+    int index;
+
+} Candidate;
+
+/**
+ * @brief Best words found so far by a search, at most `capacity` of them.
+ */
+typedef struct _CandidateHeap {
+    Candidate* items;    ///< Max-heap on the distance, then the index: the worst word kept is at the root.
+    int size;
+    int capacity;
+
+} CandidateHeap;
+
+// Whether a word ranks after another one: farther, or as far but later in the file
+static int is_worse(Candidate a, Candidate b) {
+    return a.distance > b.distance || (a.distance == b.distance && a.index > b.index);
+}
+
+// Word that a new one must beat to be kept: the worst one once the heap is full, none before
+static Candidate threshold(const CandidateHeap* heap) {
+    if (heap -> size < heap -> capacity)
+        return (Candidate){ INT_MAX, INT_MAX };
+
+    return heap -> items[0];
+}
+
+// Moves the root of the heap down to its place
+static void sift_down(CandidateHeap* heap) {
+    Candidate* items = heap -> items;
+    int parent = 0;
+
+    for (;;) {
+        int worst = parent;
+        int left = 2 * parent + 1;
+        int right = left + 1;
+
+        if (left < heap -> size && is_worse(items[left], items[worst]))
+            worst = left;
+        if (right < heap -> size && is_worse(items[right], items[worst]))
+            worst = right;
+
+        if (worst == parent)
+            return;
+
+        Candidate swap = items[parent];
+        items[parent] = items[worst];
+        items[worst] = swap;
+        parent = worst;
+    }
+}
+
+// Keeps a word if the heap is not full or it beats the worst word kept, which it then replaces
+static void offer(CandidateHeap* heap, Candidate candidate) {
+    Candidate* items = heap -> items;
+
+    if (heap -> size < heap -> capacity) {
+        int child = heap -> size++;
+
+        while (child > 0 && is_worse(candidate, items[(child - 1) / 2])) {
+            items[child] = items[(child - 1) / 2];
+            child = (child - 1) / 2;
+        }
+
+        items[child] = candidate;
+    }
+    else if (is_worse(items[0], candidate)) {
+        items[0] = candidate;
+        sift_down(heap);
+    }
+}
+
+/**
+ * Compares the word with the words of one bucket, in file order. A word
+ * must beat the worst word kept, so it is either closer, or as close but
+ * earlier in the file, and the bound passed to the edit distance depends on
+ * its position. At a length gap equal to the distance of the worst word kept
+ * only ties are possible, so the bucket is left at the first word past it.
+ */
+static void scan_bucket(const char* word, const Dictionary* dictionary, int length, int gap, CandidateHeap* heap) {
+    for (int i = dictionary -> bucket_start[length]; i < dictionary -> bucket_start[length + 1]; i++) {
+        int index = dictionary -> by_length[i];
+        Candidate worst = threshold(heap);
+
+        if (gap == worst.distance && index > worst.index)
+            return;
+
+        int bound = worst.distance == INT_MAX ? INT_MAX
+            : index < worst.index ? worst.distance
+            : worst.distance - 1;
+
+        if (bound < 0)
+            continue;
+
+        int distance = edit_distance_bounded(word, dictionary -> words[index], bound);
+        if (distance > bound)
+            continue;
+
+        offer(heap, (Candidate){ distance, index });
+    }
+}
+
+/**
+ * Same as `scan_bucket`, with the distances computed a block of interleaved
+ * words at a time by `edit_distance_batch`. The distances being exact, the
+ * words of a block are then offered to the heap in file order, and the lanes
+ * past the end of the bucket are ignored.
+ */
+static void scan_bucket_batch(const char* word, const Dictionary* dictionary, int length, int gap, CandidateHeap* heap) {
+    const int lanes = EDIT_DISTANCE_BATCH_LANES;
+    const unsigned char* blocks = dictionary -> interleaved + dictionary -> interleaved_start[length];
+    int begin = dictionary -> bucket_start[length];
+    int end = dictionary -> bucket_start[length + 1];
+    int distances[EDIT_DISTANCE_BATCH_LANES];
+
+    for (int block = begin; block < end; block += lanes) {
+        Candidate worst = threshold(heap);
+
+        if (gap == worst.distance && dictionary -> by_length[block] > worst.index)
+            return;
+
+        edit_distance_batch(word, blocks + (size_t)(block - begin) * length, length, distances);
+
+        for (int lane = 0; lane < lanes && block + lane < end; lane++)
+            offer(heap, (Candidate){ distances[lane], dictionary -> by_length[block + lane] });
+    }
+}
+
+/**
+ * Scans the buckets from the length of the word outwards, until the length
+ * gap exceeds the distance of the worst word kept by the heap: the remaining
+ * buckets cannot hold a word that beats it.
+ */
+static void search_buckets(const char* word, const Dictionary* dictionary, CandidateHeap* heap) {
+    int length = (int)strlen(word);
+
+    // Words short enough for the bit-parallel kernel are compared with whole blocks of the dictionary
+    void (*scan)(const char*, const Dictionary*, int, int, CandidateHeap*) =
+        length <= EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH ? scan_bucket_batch : scan_bucket;
+
+    for (int gap = 0; threshold(heap).distance == INT_MAX || gap <= threshold(heap).distance; gap++) {
+        int shorter = length - gap;
+        int longer = length + gap;
+
+        if (shorter < 0 && longer > dictionary -> max_length)
+            break;
+
+        if (shorter >= 0 && shorter <= dictionary -> max_length)
+            scan(word, dictionary, shorter, gap, heap);
+
+        // The first exact matches of the file are in the bucket of the same length
+        if (threshold(heap).distance == 0)
+            break;
+
+        if (gap > 0 && longer <= dictionary -> max_length)
+            scan(word, dictionary, longer, gap, heap);
+    }
+}
+
+int find_closest_word(const char* word, const Dictionary* dictionary, const char** closest_word, int* min_distance) {
+    if (word == NULL || dictionary == NULL || dictionary -> n_words < 1)
+        return -1;
+
+    Candidate best;
+    CandidateHeap heap = { &best, 0, 1 };
+
+    search_buckets(word, dictionary, &heap);
+
+    if (closest_word != NULL)
+        *closest_word = dictionary -> words[best.index];
+
+    if (min_distance != NULL)
+        *min_distance = best.distance;
+
+    return best.index;
+}
+
+int find_closest_words(const char* word, const Dictionary* dictionary, int k, Suggestion* suggestions) {
+    if (word == NULL || dictionary == NULL || dictionary -> n_words < 1 || k < 1 || suggestions == NULL)
+        return -1;
+
+    CandidateHeap heap = { NULL, 0, k < dictionary -> n_words ? k : dictionary -> n_words };
+
+    heap.items = malloc(heap.capacity * sizeof(Candidate));
+    if (heap.items == NULL)
+        return -1;
+
+    search_buckets(word, dictionary, &heap);
+
+    // Popping the worst word first fills the suggestions from the end
+    int n_suggestions = heap.size;
+    while (heap.size > 0) {
+        Candidate worst = heap.items[0];
+        Suggestion* suggestion = &suggestions[heap.size - 1];
+
+        suggestion -> word = dictionary -> words[worst.index];
+        suggestion -> index = worst.index;
+        suggestion -> distance = worst.distance;
+
+        heap.items[0] = heap.items[--heap.size];
+        sift_down(&heap);
+    }
+
+    free(heap.items);
+
+    return n_suggestions;
+}
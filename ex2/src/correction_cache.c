@@ -0,0 +1,210 @@
+/**
+ * @file correction_cache.c
+ * @brief Implementation of the bounded cache of the corrections of words.
+ */
+
+#include "correction_cache.h"
+#include <string.h>
+#include <stdint.h>
+
+
+#define NO_ENTRY (-1)
+
+// FNV-1a hash of a word
+static size_t hash_key(const char* word) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (const unsigned char* c = (const unsigned char*)word; *c != '\0'; c++) {
+        hash ^= *c;
+        hash *= 1099511628211ULL;
+    }
+
+    return (size_t)(hash ^ (hash >> 32));
+}
+
+static int find_entry(const CorrectionCache* cache, const char* word, size_t bucket) {
+    int entry = cache -> buckets[bucket];
+
+    while (entry != NO_ENTRY && strcmp(cache -> keys[entry], word) != 0)
+        entry = cache -> chain_next[entry];
+
+    return entry;
+}
+
+// Removes an entry from the list of the recently used ones
+static void unlink_entry(CorrectionCachePtr cache, int entry) {
+    if (cache -> newer[entry] != NO_ENTRY)
+        cache -> older[cache -> newer[entry]] = cache -> older[entry];
+    else
+        cache -> most_recent = cache -> older[entry];
+
+    if (cache -> older[entry] != NO_ENTRY)
+        cache -> newer[cache -> older[entry]] = cache -> newer[entry];
+    else
+        cache -> least_recent = cache -> newer[entry];
+}
+
+// Inserts an entry at the head of the list of the recently used ones
+static void push_most_recent(CorrectionCachePtr cache, int entry) {
+    cache -> newer[entry] = NO_ENTRY;
+    cache -> older[entry] = cache -> most_recent;
+
+    if (cache -> most_recent != NO_ENTRY)
+        cache -> newer[cache -> most_recent] = entry;
+    else
+        cache -> least_recent = entry;
+
+    cache -> most_recent = entry;
+}
+
+// Removes an entry from the chain of its bucket
+static void unchain_entry(CorrectionCachePtr cache, int entry) {
+    int* link = &cache -> buckets[hash_key(cache -> keys[entry]) & cache -> bucket_mask];
+
+    while (*link != entry)
+        link = &cache -> chain_next[*link];
+
+    *link = cache -> chain_next[entry];
+}
+
+int correction_cache_init(CorrectionCachePtr cache, int capacity) {
+    if (cache == NULL || capacity < 1)
+        return -1;
+
+    memset(cache, 0, sizeof(CorrectionCache));
+
+    size_t n_buckets = 1;
+    while (n_buckets < (size_t)capacity)
+        n_buckets *= 2;
+
+    cache -> capacity = capacity;
+    cache -> bucket_mask = n_buckets - 1;
+    cache -> most_recent = NO_ENTRY;
+    cache -> least_recent = NO_ENTRY;
+
+    cache -> keys = malloc(capacity * sizeof(char*));
+    cache -> word_index = malloc(capacity * sizeof(int));
+    cache -> distance = malloc(capacity * sizeof(int));
+    cache -> chain_next = malloc(capacity * sizeof(int));
+    cache -> newer = malloc(capacity * sizeof(int));
+    cache -> older = malloc(capacity * sizeof(int));
+    cache -> buckets = malloc(n_buckets * sizeof(int));
+
+    if (!cache -> keys || !cache -> word_index || !cache -> distance || !cache -> chain_next || !cache -> newer ||
+        !cache -> older || !cache -> buckets || pthread_mutex_init(&cache -> lock, NULL) != 0) {
+        free(cache -> keys);
+        free(cache -> word_index);
+        free(cache -> distance);
+        free(cache -> chain_next);
+        free(cache -> newer);
+        free(cache -> older);
+        free(cache -> buckets);
+        memset(cache, 0, sizeof(CorrectionCache));
+
+        return -1;
+    }
+
+    for (size_t bucket = 0; bucket < n_buckets; bucket++)
+        cache -> buckets[bucket] = NO_ENTRY;
+
+    return capacity;
+}
+
+void correction_cache_free(CorrectionCachePtr cache) {
+    if (cache == NULL || cache -> capacity == 0)
+        return;
+
+    for (int entry = 0; entry < cache -> n_entries; entry++)
+        free(cache -> keys[entry]);
+
+    free(cache -> keys);
+    free(cache -> word_index);
+    free(cache -> distance);
+    free(cache -> chain_next);
+    free(cache -> newer);
+    free(cache -> older);
+    free(cache -> buckets);
+    pthread_mutex_destroy(&cache -> lock);
+
+    memset(cache, 0, sizeof(CorrectionCache));
+}
+
+int correction_cache_get(CorrectionCachePtr cache, const char* word, int* distance) {
+    if (cache == NULL || cache -> capacity == 0 || word == NULL)
+        return -1;
+
+    size_t bucket = hash_key(word) & cache -> bucket_mask;
+    int word_index = -1;
+
+    pthread_mutex_lock(&cache -> lock);
+
+    int entry = find_entry(cache, word, bucket);
+    if (entry != NO_ENTRY) {
+        unlink_entry(cache, entry);
+        push_most_recent(cache, entry);
+
+        word_index = cache -> word_index[entry];
+        if (distance != NULL)
+            *distance = cache -> distance[entry];
+
+        cache -> hits++;
+    }
+    else
+        cache -> misses++;
+
+    pthread_mutex_unlock(&cache -> lock);
+
+    return word_index;
+}
+
+/**
+ * A new word takes the next unused entry while the cache is not full, and
+ * the least recently used entry afterwards: the evicted word is unchained
+ * from its bucket and its copy freed. Two threads may miss the same word and
+ * store it one after the other, so the word is first looked up again.
+ */
+int correction_cache_put(CorrectionCachePtr cache, const char* word, int word_index, int distance) {
+    if (cache == NULL || cache -> capacity == 0 || word == NULL)
+        return 0;
+
+    size_t length = strlen(word);
+    size_t bucket = hash_key(word) & cache -> bucket_mask;
+
+    pthread_mutex_lock(&cache -> lock);
+
+    int entry = find_entry(cache, word, bucket);
+
+    if (entry != NO_ENTRY)
+        unlink_entry(cache, entry);
+    else {
+        char* key = malloc(length + 1);
+        if (key == NULL) {
+            pthread_mutex_unlock(&cache -> lock);
+            return 0;
+        }
+
+        memcpy(key, word, length + 1);
+
+        if (cache -> n_entries < cache -> capacity)
+            entry = cache -> n_entries++;
+        else {
+            entry = cache -> least_recent;
+
+            unlink_entry(cache, entry);
+            unchain_entry(cache, entry);
+            free(cache -> keys[entry]);
+        }
+
+        cache -> keys[entry] = key;
+        cache -> chain_next[entry] = cache -> buckets[bucket];
+        cache -> buckets[bucket] = entry;
+    }
+
+    cache -> word_index[entry] = word_index;
+    cache -> distance[entry] = distance;
+    push_most_recent(cache, entry);
+
+    pthread_mutex_unlock(&cache -> lock);
+
+    return 1;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file corrector.c
+ * @brief Implementation of the correction of words with one of the search engines over a dictionary.
+ */
+
+#include "corrector.h"
+#include "closest_word.h"
+#include <stdatomic.h>
+#include <pthread.h>
+
+
+#define WORDS_PER_CHUNK 16
+
+/**
+ * @brief Batch of words shared by the correction threads.
+ */
+typedef struct _CorrectionTask {
+    const Corrector* corrector;
+    char** words;
+    int n_words;
+    Correction* corrections;
+    atomic_int next_word; ///< First word of the next chunk to correct.
+
+} CorrectionTask;
+
+int corrector_init(CorrectorPtr corrector, const Dictionary* dictionary, Engine engine) {
+    if (corrector == NULL || dictionary == NULL || dictionary -> n_words < 1)
+        return -1;
+
+    memset(corrector, 0, sizeof(Corrector));
+
+    corrector -> dictionary = dictionary;
+    corrector -> engine = engine;
+
+    if (engine == ENGINE_BKTREE && bk_tree_build(&corrector -> tree, dictionary -> words, dictionary -> n_words) < 1)
+        return -1;
+
+    if (engine == ENGINE_SYMSPELL && symspell_build(&corrector -> symspell, dictionary -> words, dictionary -> n_words, SYMSPELL_DEFAULT_MAX_DISTANCE) < 1)
+        return -1;
+
+    if (engine == ENGINE_TRIE && trie_build(&corrector -> trie, dictionary -> words, dictionary -> n_words) < 1)
+        return -1;
+
+    if (engine == ENGINE_QGRAM && qgram_build(&corrector -> qgram, dictionary -> words, dictionary -> n_words) < 1)
+        return -1;
+
+    return dictionary -> n_words;
+}
+
+int corrector_enable_cache(CorrectorPtr corrector, int capacity) {
+    if (corrector == NULL || corrector -> cache != NULL)
+        return -1;
+
+    corrector -> cache = malloc(sizeof(CorrectionCache));
+    if (corrector -> cache == NULL)
+        return -1;
+
+    if (correction_cache_init(corrector -> cache, capacity) < 1) {
+        free(corrector -> cache);
+        corrector -> cache = NULL;
+
+        return -1;
+    }
+
+    return capacity;
+}
+
+void corrector_free(CorrectorPtr corrector) {
+    if (corrector == NULL)
+        return;
+
+    if (corrector -> cache != NULL) {
+        correction_cache_free(corrector -> cache);
+        free(corrector -> cache);
+        corrector -> cache = NULL;
+    }
+
+    if (corrector -> engine == ENGINE_BKTREE)
+        bk_tree_free(&corrector -> tree);
+
+    if (corrector -> engine == ENGINE_SYMSPELL)
+        symspell_free(&corrector -> symspell);
+
+    if (corrector -> engine == ENGINE_TRIE)
+        trie_free(&corrector -> trie);
+
+    if (corrector -> engine == ENGINE_QGRAM)
+        qgram_free(&corrector -> qgram);
+}
+
+// Closest word of the dictionary found by the engine of the corrector
+static int search_engine(const Corrector* corrector, const char* word, Correction* correction) {
+    int index;
+
+    switch (corrector -> engine) {
+        case ENGINE_BKTREE:
+            return bk_tree_find_closest(&corrector -> tree, word, &correction -> closest_word, &correction -> distance);
+
+        case ENGINE_SYMSPELL:
+            index = symspell_find_closest(&corrector -> symspell, word, &correction -> closest_word, &correction -> distance);
+            if (index != -1)
+                return index;
+
+            // No word within the radius of the index
+            return find_closest_word(word, corrector -> dictionary, &correction -> closest_word, &correction -> distance);
+
+        case ENGINE_TRIE:
+            return trie_find_closest(&corrector -> trie, word, &correction -> closest_word, &correction -> distance);
+
+        case ENGINE_QGRAM:
+            index = qgram_find_closest(&corrector -> qgram, word, &correction -> closest_word, &correction -> distance);
+            if (index != -1)
+                return index;
+
+            // Too few q-grams in the word to rule out the words sharing none
+            return find_closest_word(word, corrector -> dictionary, &correction -> closest_word, &correction -> distance);
+
+        default:
+            return find_closest_word(word, corrector -> dictionary, &correction -> closest_word, &correction -> distance);
+    }
+}
+
+int correct_word(const Corrector* corrector, const char* word, Correction* correction) {
+    if (corrector == NULL || word == NULL || correction == NULL)
+        return -1;
+
+    // Words spelled correctly need no approximate search
+    int index = dictionary_lookup(corrector -> dictionary, word);
+    if (index != -1) {
+        correction -> closest_word = corrector -> dictionary -> words[index];
+        correction -> distance = 0;
+
+        return index;
+    }
+
+    // Repeated misspellings are answered by the cache
+    if (corrector -> cache != NULL) {
+        index = correction_cache_get(corrector -> cache, word, &correction -> distance);
+        if (index != -1) {
+            correction -> closest_word = corrector -> dictionary -> words[index];
+            return index;
+        }
+    }
+
+    index = search_engine(corrector, word, correction);
+
+    if (corrector -> cache != NULL && index != -1)
+        correction_cache_put(corrector -> cache, word, index, correction -> distance);
+
+    return index;
+}
+
+// Body of a correction thread: corrects chunks of words until none is left
+static void* correction_task_run(void* arg) {
+    CorrectionTask* task = arg;
+
+    for (;;) {
+        int begin = atomic_fetch_add(&task -> next_word, WORDS_PER_CHUNK);
+        if (begin >= task -> n_words)
+            break;
+
+        int end = begin + WORDS_PER_CHUNK < task -> n_words ? begin + WORDS_PER_CHUNK : task -> n_words;
+        for (int i = begin; i < end; i++)
+            correct_word(task -> corrector, task -> words[i], &task -> corrections[i]);
+    }
+
+    return NULL;
+}
+
+int correct_words(const Corrector* corrector, char** words, int n_words, int n_threads, Correction* corrections) {
+    if (corrector == NULL || words == NULL || corrections == NULL || n_words < 0)
+        return -1;
+
+    if (n_threads < 1)
+        n_threads = 1;
+
+    CorrectionTask task = { corrector, words, n_words, corrections, 0 };
+
+    if (n_threads == 1) {
+        correction_task_run(&task);
+        return n_words;
+    }
+
+    pthread_t* threads = malloc(n_threads * sizeof(pthread_t));
+    if (threads == NULL)
+        return -1;
+
+    int n_started = 0;
+    while (n_started < n_threads && pthread_create(&threads[n_started], NULL, correction_task_run, &task) == 0)
+        n_started++;
+
+    // Threads that could not be started leave their share to the others, or to this one
+    if (n_started == 0)
+        correction_task_run(&task);
+
+    for (int t = 0; t < n_started; t++)
+        pthread_join(threads[t], NULL);
+
+    free(threads);
+
+    return n_words;
+}
@@ -0,0 +1,321 @@
+/**
+ * @file dictionary_image.c
+ * @brief Implementation of the binary images of dictionaries.
+ */
+
+#include "dictionary_image.h"
+#include <stdint.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DICTIONARY_IMAGE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+/**
+ * @brief Header at the beginning of an image: the sizes of the dictionary and the position of each section.
+ */
+typedef struct _DictionaryImageHeader {
+    char magic[8];                     ///< `DICTIONARY_IMAGE_MAGIC`, null-terminated.
+    uint32_t version;                  ///< `DICTIONARY_IMAGE_VERSION`.
+    uint32_t size_t_size;              ///< Size of `size_t` on the machine that compiled the image.
+    uint64_t file_size;                ///< Size of the whole image, in bytes.
+    int32_t n_words;
+    int32_t max_length;
+    uint64_t set_mask;
+    uint64_t blob_offset;              ///< Words, null-terminated, in file order.
+    uint64_t blob_size;
+    uint64_t offsets_offset;           ///< Offset of each word in the blob, `n_words` entries of 32 bits.
+    uint64_t bucket_start_offset;
+    uint64_t by_length_offset;
+    uint64_t word_set_offset;
+    uint64_t interleaved_start_offset;
+    uint64_t interleaved_offset;
+    uint64_t interleaved_size;
+
+} DictionaryImageHeader;
+
+// Size of the interleaved blocks of a dictionary, the last bucket being padded to whole blocks
+static size_t interleaved_size(const Dictionary* dictionary) {
+    size_t lanes = EDIT_DISTANCE_BATCH_LANES;
+    int length = dictionary -> max_length;
+    size_t n_words = dictionary -> bucket_start[length + 1] - dictionary -> bucket_start[length];
+
+    return dictionary -> interleaved_start[length] + (n_words + lanes - 1) / lanes * lanes * length;
+}
+
+// Pads a file with zeros up to the next aligned position, which receives the offset of the next section
+static int align_file(FILE* file_fp, uint64_t* offset) {
+    long position = ftell(file_fp);
+    if (position < 0)
+        return 0;
+
+    while (position % DICTIONARY_IMAGE_ALIGNMENT != 0) {
+        if (fputc(0, file_fp) == EOF)
+            return 0;
+        position++;
+    }
+
+    *offset = (uint64_t)position;
+
+    return 1;
+}
+
+// Writes a section at the next aligned position of a file
+static int write_section(FILE* file_fp, const void* data, size_t size, uint64_t* offset) {
+    return align_file(file_fp, offset) && fwrite(data, 1, size, file_fp) == size;
+}
+
+int is_dictionary_image(FILE* file_fp) {
+    if (file_fp == NULL)
+        return 0;
+
+    char magic[sizeof(DICTIONARY_IMAGE_MAGIC)];
+    int is_image = fread(magic, 1, sizeof(magic), file_fp) == sizeof(magic) &&
+                   memcmp(magic, DICTIONARY_IMAGE_MAGIC, sizeof(magic)) == 0;
+
+    rewind(file_fp);
+
+    return is_image;
+}
+
+/**
+ * The header is written first with the sizes only, then rewritten once the
+ * sections have been written and their offsets are known.
+ */
+long save_dictionary_image(const Dictionary* dictionary, FILE* image_fp) {
+    if (dictionary == NULL || image_fp == NULL || dictionary -> n_words < 1 || dictionary -> word_set == NULL ||
+        dictionary -> interleaved == NULL)
+        return -1;
+
+    DictionaryImageHeader header;
+    memset(&header, 0, sizeof(DictionaryImageHeader));
+
+    memcpy(header.magic, DICTIONARY_IMAGE_MAGIC, sizeof(DICTIONARY_IMAGE_MAGIC));
+    header.version = DICTIONARY_IMAGE_VERSION;
+    header.size_t_size = sizeof(size_t);
+    header.n_words = dictionary -> n_words;
+    header.max_length = dictionary -> max_length;
+    header.set_mask = dictionary -> set_mask;
+
+    uint32_t* offsets = malloc(dictionary -> n_words * sizeof(uint32_t));
+    if (offsets == NULL)
+        return -1;
+
+    for (int i = 0; i < dictionary -> n_words; i++) {
+        size_t length = strlen(dictionary -> words[i]) + 1;
+
+        if (header.blob_size + length > UINT32_MAX) {
+            free(offsets);
+            return -1;
+        }
+
+        offsets[i] = (uint32_t)header.blob_size;
+        header.blob_size += length;
+    }
+
+    size_t n_slots = dictionary -> set_mask + 1;
+    int written = fwrite(&header, sizeof(DictionaryImageHeader), 1, image_fp) == 1 &&
+                  align_file(image_fp, &header.blob_offset);
+
+    for (int i = 0; written && i < dictionary -> n_words; i++) {
+        size_t length = strlen(dictionary -> words[i]) + 1;
+        written = fwrite(dictionary -> words[i], 1, length, image_fp) == length;
+    }
+
+    header.interleaved_size = interleaved_size(dictionary);
+
+    written = written &&
+        write_section(image_fp, offsets, dictionary -> n_words * sizeof(uint32_t), &header.offsets_offset) &&
+        write_section(image_fp, dictionary -> bucket_start, (dictionary -> max_length + 2) * sizeof(int), &header.bucket_start_offset) &&
+        write_section(image_fp, dictionary -> by_length, dictionary -> n_words * sizeof(int), &header.by_length_offset) &&
+        write_section(image_fp, dictionary -> word_set, n_slots * sizeof(int), &header.word_set_offset) &&
+        write_section(image_fp, dictionary -> interleaved_start, (dictionary -> max_length + 1) * sizeof(size_t), &header.interleaved_start_offset) &&
+        write_section(image_fp, dictionary -> interleaved, header.interleaved_size, &header.interleaved_offset) &&
+        align_file(image_fp, &header.file_size);
+
+    free(offsets);
+
+    if (!written || fseek(image_fp, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(DictionaryImageHeader), 1, image_fp) != 1 ||
+        fseek(image_fp, 0, SEEK_END) != 0)
+        return -1;
+
+    return (long)header.file_size;
+}
+
+/**
+ * @brief Maps a file in memory, or reads it into an aligned buffer when it cannot be mapped.
+ *
+ * @param file_fp File pointer to the file.
+ * @param size Receives the size of the file.
+ * @param mapped Receives 1 if the file is mapped, 0 if it is read.
+ * @return The content of the file, or NULL if an error occurs or the file is too small to be an image.
+ */
+static void* map_image(FILE* file_fp, size_t* size, int* mapped) {
+#ifdef DICTIONARY_IMAGE_MMAP
+    struct stat status;
+
+    if (fstat(fileno(file_fp), &status) == 0 && status.st_size >= (off_t)sizeof(DictionaryImageHeader)) {
+        void* image = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fileno(file_fp), 0);
+
+        if (image != MAP_FAILED) {
+            *size = status.st_size;
+            *mapped = 1;
+
+            return image;
+        }
+    }
+#endif
+
+    if (fseek(file_fp, 0, SEEK_END) != 0)
+        return NULL;
+
+    long file_size = ftell(file_fp);
+    rewind(file_fp);
+
+    if (file_size < (long)sizeof(DictionaryImageHeader))
+        return NULL;
+
+    // aligned_alloc requires a size multiple of the alignment
+    size_t buffer_size = (file_size + DICTIONARY_IMAGE_ALIGNMENT - 1) / DICTIONARY_IMAGE_ALIGNMENT * DICTIONARY_IMAGE_ALIGNMENT;
+    void* image = aligned_alloc(DICTIONARY_IMAGE_ALIGNMENT, buffer_size);
+    if (image == NULL)
+        return NULL;
+
+    if (fread(image, 1, file_size, file_fp) != (size_t)file_size) {
+        free(image);
+        return NULL;
+    }
+
+    *size = file_size;
+    *mapped = 0;
+
+    return image;
+}
+
+// Whether `count` elements of `element_size` bytes at an aligned offset lie within the image
+static int section_fits(uint64_t offset, uint64_t count, size_t element_size, size_t image_size) {
+    return offset % DICTIONARY_IMAGE_ALIGNMENT == 0 && offset <= image_size &&
+           count <= (image_size - offset) / element_size;
+}
+
+/**
+ * Checks that every section lies within the image and that every index or
+ * offset stored in it stays within its target, so that a damaged or foreign
+ * image is rejected rather than read out of bounds. The words themselves
+ * are not checked beyond the termination of the blob.
+ */
+static int check_image(const unsigned char* image, size_t size) {
+    const DictionaryImageHeader* header = (const DictionaryImageHeader*)image;
+
+    if (memcmp(header -> magic, DICTIONARY_IMAGE_MAGIC, sizeof(DICTIONARY_IMAGE_MAGIC)) != 0 ||
+        header -> version != DICTIONARY_IMAGE_VERSION || header -> size_t_size != sizeof(size_t) || header -> file_size != size)
+        return 0;
+
+    int n_words = header -> n_words;
+    int max_length = header -> max_length;
+    uint64_t n_slots = header -> set_mask + 1;
+
+    if (n_words < 1 || max_length < 0 || (uint64_t)max_length >= header -> blob_size ||
+        n_slots <= (uint64_t)n_words || (n_slots & header -> set_mask) != 0)
+        return 0;
+
+    if (!section_fits(header -> blob_offset, header -> blob_size, 1, size) ||
+        !section_fits(header -> offsets_offset, n_words, sizeof(uint32_t), size) ||
+        !section_fits(header -> bucket_start_offset, max_length + 2, sizeof(int), size) ||
+        !section_fits(header -> by_length_offset, n_words, sizeof(int), size) ||
+        !section_fits(header -> word_set_offset, n_slots, sizeof(int), size) ||
+        !section_fits(header -> interleaved_start_offset, max_length + 1, sizeof(size_t), size) ||
+        !section_fits(header -> interleaved_offset, header -> interleaved_size, 1, size))
+        return 0;
+
+    const char* blob = (const char*)image + header -> blob_offset;
+    const uint32_t* offsets = (const uint32_t*)(image + header -> offsets_offset);
+    const int* bucket_start = (const int*)(image + header -> bucket_start_offset);
+    const int* by_length = (const int*)(image + header -> by_length_offset);
+    const int* word_set = (const int*)(image + header -> word_set_offset);
+    const size_t* interleaved_start = (const size_t*)(image + header -> interleaved_start_offset);
+
+    if (blob[header -> blob_size - 1] != '\0' || bucket_start[0] != 0 || bucket_start[max_length + 1] != n_words)
+        return 0;
+
+    for (int i = 0; i < n_words; i++)
+        if (offsets[i] >= header -> blob_size || by_length[i] < 0 || by_length[i] >= n_words)
+            return 0;
+
+    for (uint64_t slot = 0; slot < n_slots; slot++)
+        if (word_set[slot] < -1 || word_set[slot] >= n_words)
+            return 0;
+
+    for (int length = 0; length <= max_length; length++) {
+        if (bucket_start[length + 1] < bucket_start[length])
+            return 0;
+
+        size_t n_blocks = (bucket_start[length + 1] - bucket_start[length] + EDIT_DISTANCE_BATCH_LANES - 1) / EDIT_DISTANCE_BATCH_LANES;
+        if (interleaved_start[length] > header -> interleaved_size ||
+            n_blocks * EDIT_DISTANCE_BATCH_LANES * length > header -> interleaved_size - interleaved_start[length])
+            return 0;
+    }
+
+    return 1;
+}
+
+int load_dictionary_image(FILE* image_fp, DictionaryPtr dictionary) {
+    if (image_fp == NULL || dictionary == NULL)
+        return -1;
+
+    memset(dictionary, 0, sizeof(Dictionary));
+
+    dictionary -> image = map_image(image_fp, &dictionary -> image_size, &dictionary -> image_mapped);
+    if (dictionary -> image == NULL)
+        return -1;
+
+    unsigned char* image = dictionary -> image;
+    const DictionaryImageHeader* header = dictionary -> image;
+
+    if (!check_image(image, dictionary -> image_size)) {
+        free_dictionary_image(dictionary);
+        return -1;
+    }
+
+    dictionary -> n_words = header -> n_words;
+    dictionary -> max_length = header -> max_length;
+    dictionary -> set_mask = header -> set_mask;
+    dictionary -> bucket_start = (int*)(image + header -> bucket_start_offset);
+    dictionary -> by_length = (int*)(image + header -> by_length_offset);
+    dictionary -> word_set = (int*)(image + header -> word_set_offset);
+    dictionary -> interleaved_start = (size_t*)(image + header -> interleaved_start_offset);
+    dictionary -> interleaved = image + header -> interleaved_offset;
+
+    // The only array built at load time: the words themselves stay in the blob
+    dictionary -> words = malloc(dictionary -> n_words * sizeof(char*));
+    if (dictionary -> words == NULL) {
+        free_dictionary_image(dictionary);
+        return -1;
+    }
+
+    const uint32_t* offsets = (const uint32_t*)(image + header -> offsets_offset);
+    for (int i = 0; i < dictionary -> n_words; i++)
+        dictionary -> words[i] = (char*)image + header -> blob_offset + offsets[i];
+
+    return dictionary -> n_words;
+}
+
+void free_dictionary_image(DictionaryPtr dictionary) {
+    if (dictionary == NULL || dictionary -> image == NULL)
+        return;
+
+    free(dictionary -> words);
+
+#ifdef DICTIONARY_IMAGE_MMAP
+    if (dictionary -> image_mapped)
+        munmap(dictionary -> image, dictionary -> image_size);
+    else
+        free(dictionary -> image);
+#else
+    free(dictionary -> image);
+#endif
+
+    memset(dictionary, 0, sizeof(Dictionary));
+}
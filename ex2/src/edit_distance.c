@@ -8,11 +8,17 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <stdio.h>
+#include <stdint.h>
 
 
-#define NOT_SET_IN_MEMO (-1)
 #define min(a, b) ((a) <= (b) ? (a) : (b))
 
+// Row of the dynamic programming table reused by every call of the thread
+static _Thread_local int scratch_row[EDIT_DISTANCE_SCRATCH_SIZE + 1];
+
+// Match masks of the bit-parallel kernel, all zero between two calls
+static _Thread_local uint64_t match_masks[UCHAR_MAX + 1];
+
 /**
  * If the length of s1 is 0, then edit_distance(s1, s2) = length of s2;
  * If the length of s2 is 0, then edit_distance(s1, s2) = length of s1;
@@ -71,87 +77,238 @@ int edit_distance(const char* s1, const char* s2) {
     );
 }
 
-int** init_edit_distance_dyn_memo(int len_s1, int len_s2) {
-    if (len_s1 == 0 || len_s2 == 0)
-        return NULL;
+/**
+ * Bottom-up version of the same recurrence, on a single row of the table:
+ * before `row[j]` is overwritten with D(i, j) it holds D(i - 1, j), and `diagonal`
+ * holds D(i - 1, j - 1). The row spans the shorter string.
+ */
+int edit_distance_dyn(const char* s1, const char* s2) {
+    if (s1 == NULL || s2 == NULL)
+        return -1;
 
-    int** memo = (int**) malloc((len_s1 + 1) * sizeof(int*));
+    size_t len_s1 = strlen(s1);
+    size_t len_s2 = strlen(s2);
 
-    for (size_t i = 0; i < len_s1 + 1; i++) {
-        memo[i] = (int*) malloc((len_s2 + 1) * sizeof(int));
+    if (len_s2 > len_s1) {
+        const char* swap_s = s1;
+        s1 = s2;
+        s2 = swap_s;
 
-        memset(memo[i], NOT_SET_IN_MEMO, (len_s2 + 1) * sizeof(int));
+        size_t swap_len = len_s1;
+        len_s1 = len_s2;
+        len_s2 = swap_len;
     }
 
-    return memo;
-}
+    // Strings fitting in the scratch row of the thread need no allocation
+    int* row = len_s2 <= EDIT_DISTANCE_SCRATCH_SIZE
+        ? scratch_row
+        : (int*) malloc((len_s2 + 1) * sizeof(int));
+    if (row == NULL)
+        return -1;
 
-int edit_distance_dyn_recursive(
-    const char* s1, const int len_s1, size_t i,
-    const char* s2, const int len_s2, size_t j,
-    int** memo
-) {
-    if (memo != NULL && memo[i] != NULL && memo[i][j] != NOT_SET_IN_MEMO)
-        return memo[i][j];
+    for (size_t j = 0; j <= len_s2; j++)
+        row[j] = (int)j;
 
-    if (*s1 == '\0')
-        return len_s2;
+    for (size_t i = 1; i <= len_s1; i++) {
+        int diagonal = row[0];
+        char c = s1[i - 1];
 
-    if (*s2 == '\0')
-        return len_s1;
+        row[0] = (int)i;
 
-    int d_no_op = (*s1 == *s2)
-        ? edit_distance_dyn_recursive(
-            s1 + 1, len_s1 - 1, i + 1,
-            s2 + 1, len_s2 - 1, j + 1,
-            memo
-        )
-        : INT_MAX;
+        for (size_t j = 1; j <= len_s2; j++) {
+            int up = row[j];
 
-    int d_canc = 1 + edit_distance_dyn_recursive(
-        s1, len_s1, i,
-        s2 + 1, len_s2 - 1, j + 1,
-        memo
-    );
+            row[j] = (c == s2[j - 1])
+                ? diagonal
+                : 1 + min(up, row[j - 1]);
 
-    int d_ins = 1 + edit_distance_dyn_recursive(
-        s1 + 1, len_s1 - 1, i + 1,
-        s2, len_s2, j,
-        memo
-    );
+            diagonal = up;
+        }
+    }
 
-    memo[i][j] = min(d_no_op, min(d_canc, d_ins));
-    return memo[i][j];
+    int distance = row[len_s2];
+
+    if (row != scratch_row)
+        free(row);
+
+    return distance;
 }
 
-int edit_distance_dyn(const char* s1, const char* s2) {
+/**
+ * Since only insertions and deletions are allowed, the edit distance is
+ * `len_s1 + len_s2 - 2 * LCS(s1, s2)`. The length of the longest common
+ * subsequence is computed with the bit-parallel algorithm of Allison-Dix /
+ * Hyyro: bit `i` of `row` is cleared when the LCS row grows at position `i`
+ * of s1, so after scanning s2 the LCS is the number of cleared bits.
+ */
+int edit_distance_bitparallel(const char* s1, const char* s2) {
     if (s1 == NULL || s2 == NULL)
         return -1;
 
-    int len_s1 = (int)strlen(s1);
-    int len_s2 = (int)strlen(s2);
+    size_t len_s1 = strlen(s1);
+    if (len_s1 > EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH)
+        return -1;
+
+    for (size_t i = 0; i < len_s1; i++)
+        match_masks[(unsigned char)s1[i]] |= (uint64_t)1 << i;
+
+    uint64_t row = ~(uint64_t)0;
+    size_t len_s2 = 0;
+
+    for (; s2[len_s2] != '\0'; len_s2++) {
+        uint64_t matches = row & match_masks[(unsigned char)s2[len_s2]];
+        row = (row + matches) | (row - matches);
+    }
+
+    // Leave the masks clear for the next call
+    for (size_t i = 0; i < len_s1; i++)
+        match_masks[(unsigned char)s1[i]] = 0;
+
+    uint64_t used = len_s1 == 64 ? ~(uint64_t)0 : ((uint64_t)1 << len_s1) - 1;
+    int lcs = __builtin_popcountll(~row & used);
+
+    return (int)(len_s1 + len_s2) - 2 * lcs;
+}
+
+/**
+ * Same algorithm as `edit_distance_bitparallel`, with one column per lane.
+ * The lanes of a block being independent, the compiler is free to interleave
+ * or vectorize their updates.
+ */
+int edit_distance_batch(const char* word, const unsigned char* block, int length, int* distances) {
+    if (word == NULL || block == NULL || distances == NULL)
+        return -1;
+
+    size_t len_word = strlen(word);
+    if (len_word > EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH)
+        return -1;
+
+    for (size_t i = 0; i < len_word; i++)
+        match_masks[(unsigned char)word[i]] |= (uint64_t)1 << i;
+
+    uint64_t rows[EDIT_DISTANCE_BATCH_LANES];
+    for (int lane = 0; lane < EDIT_DISTANCE_BATCH_LANES; lane++)
+        rows[lane] = ~(uint64_t)0;
+
+    for (int j = 0; j < length; j++) {
+        const unsigned char* characters = block + (size_t)j * EDIT_DISTANCE_BATCH_LANES;
+
+        for (int lane = 0; lane < EDIT_DISTANCE_BATCH_LANES; lane++) {
+            uint64_t matches = rows[lane] & match_masks[characters[lane]];
+            rows[lane] = (rows[lane] + matches) | (rows[lane] - matches);
+        }
+    }
 
-    if (len_s1 == 0 || len_s2 == 0)
-        return edit_distance_dyn_recursive(
-            s1, len_s1, 0,
-            s2, len_s2, 0,
-            NULL
-        );
+    for (size_t i = 0; i < len_word; i++)
+        match_masks[(unsigned char)word[i]] = 0;
 
-    int** memo = init_edit_distance_dyn_memo(len_s1, len_s2);
-    if (memo == NULL)
+    uint64_t used = len_word == 64 ? ~(uint64_t)0 : ((uint64_t)1 << len_word) - 1;
+    for (int lane = 0; lane < EDIT_DISTANCE_BATCH_LANES; lane++)
+        distances[lane] = (int)len_word + length - 2 * __builtin_popcountll(~rows[lane] & used);
+
+    return 0;
+}
+
+/**
+ * Same recurrence as `edit_distance_dyn`, restricted to the cells with
+ * `|i - j| <= k`: since every cell is at least `|i - j|`, the others
+ * cannot lead to a distance within the bound. The cell right after the
+ * band of a row is kept at `k + 1`, so the next row can read it as "out
+ * of band" without checking. Stops as soon as a whole band row exceeds k,
+ * as the cells of the next rows can only be larger.
+ */
+int edit_distance_bounded(const char* s1, const char* s2, int k) {
+    if (s1 == NULL || s2 == NULL || k < 0)
         return -1;
 
-    int distance = edit_distance_dyn_recursive(
-        s1, len_s1, 0,
-        s2, len_s2, 0,
-        memo
-    );
+    size_t len_s1 = strlen(s1);
+    size_t len_s2 = strlen(s2);
+
+    if (len_s2 > len_s1) {
+        const char* swap_s = s1;
+        s1 = s2;
+        s2 = swap_s;
+
+        size_t swap_len = len_s1;
+        len_s1 = len_s2;
+        len_s2 = swap_len;
+    }
 
-    for (size_t i = 0; i < len_s1 + 1; i++)
-        free(memo[i]);
-    
-    free(memo);
+    // Each character of the longer string must at least be deleted
+    if (len_s1 - len_s2 > (size_t)k)
+        return k + 1;
+
+    // No distance exceeds len_s1 + len_s2, a larger bound only widens the band
+    if ((size_t)k > len_s1 + len_s2)
+        k = (int)(len_s1 + len_s2);
+
+    // A short string is compared at once by the bit-parallel kernel, faster than the band
+    if (len_s2 <= EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH)
+        return min(edit_distance_bitparallel(s2, s1), k + 1);
+
+    int out_of_band = k + 1;
+    size_t band = (size_t)k;
+
+    int* row = len_s2 <= EDIT_DISTANCE_SCRATCH_SIZE
+        ? scratch_row
+        : (int*) malloc((len_s2 + 1) * sizeof(int));
+    if (row == NULL)
+        return -1;
+
+    size_t high = min(len_s2, band);
+    for (size_t j = 0; j <= high; j++)
+        row[j] = (int)j;
+    if (high < len_s2)
+        row[high + 1] = out_of_band;
+
+    int distance = -1;
+
+    for (size_t i = 1; i <= len_s1 && distance == -1; i++) {
+        size_t low = i > band ? i - band : 0;
+        char c = s1[i - 1];
+
+        int diagonal;
+        int left;
+        int row_min;
+        size_t j = low;
+
+        if (low == 0) {
+            diagonal = row[0];
+            row[0] = (int)i;
+            left = (int)i;
+            row_min = (int)i;
+            j = 1;
+        } else {
+            diagonal = row[low - 1];
+            left = out_of_band;
+            row_min = out_of_band;
+        }
+
+        high = min(len_s2, i + band);
+        for (; j <= high; j++) {
+            int up = row[j];
+            int cell = (c == s2[j - 1])
+                ? diagonal
+                : 1 + min(up, left);
+
+            diagonal = up;
+            row[j] = cell;
+            left = cell;
+            row_min = min(row_min, cell);
+        }
+
+        if (high < len_s2)
+            row[high + 1] = out_of_band;
+
+        if (row_min > k)
+            distance = k + 1;
+    }
+
+    if (distance == -1)
+        distance = min(row[len_s2], k + 1);
+
+    if (row != scratch_row)
+        free(row);
 
     return distance;
-}
\ No newline at end of file
+}
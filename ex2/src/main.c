@@ -10,32 +10,61 @@
  * @section usage Usage
  * The application is executed with the following command:
  * ```
- * ./bin/main_ex2(.exe) <dictionary_path> <to_correct_path>
+ * ./bin/main_ex2(.exe) <dictionary_path> <to_correct_path> [--engine=scan|bktree|symspell|trie|qgram] [--threads=N] [--cache=N] [--top=K] [--stream] [--stats]
+ * ./bin/main_ex2(.exe) --compile <dictionary_path> <image_path>
  * ```
- * - `<dictionary_path>`: Path to the dictionary file containing valid words.
+ * - `<dictionary_path>`: Path to the dictionary file containing valid words, or to its image compiled with `--compile`, recognized by its header.
+ * - `--compile`: Compiles the dictionary into a binary image, which later runs map in memory instead of parsing the dictionary.
  * - `<to_correct_path>`: Path to the file containing the words that need correction.
+ * - `--engine`: Search structure used to find the closest words: a scan of the dictionary by length buckets (default), a BK-tree built over it,
+ *   a SymSpell deletion index answering the words within distance 2 (the other words fall back to the scan), a trie sharing the rows of the
+ *   table between the words with a common prefix, or an inverted index of the trigrams of the words, which only verifies the words sharing
+ *   enough trigrams with the word to correct (short words, whose few trigrams cannot rule out the other words, fall back to the scan).
+ * - `--threads`: Number of threads the words to correct are split across (default: 1). The results are printed in the order of the words.
+ * - `--cache`: Maximum number of misspelled words whose correction is remembered, the least recently used one being evicted first
+ *   (default: 65536, 0 to disable the cache). The next occurrences of a remembered word skip the search.
+ * - `--top`: Prints, under each correction, the `K` closest words of the dictionary (at most 100), from the closest one, ties broken by
+ *   their position in the dictionary.
+ * - `--stream`: Reads the text once, a word at a time, and prints the correction of each word as soon as it is found, in constant memory
+ *   whatever the size of the text. `<to_correct_path>` may then be `-` to read the standard input. With several threads, the words are
+ *   corrected by batches of `STREAM_BATCH_WORDS`.
+ * - `--stats`: Prints on the standard error the build time and memory of the search structure, and the time spent correcting the words.
  *
  * Example:
  * ```
  * ./bin/main_ex2(.exe) data/dictionary.txt data/correctme.txt
+ * ./bin/main_ex2(.exe) --compile data/dictionary.txt data/dictionary.img
+ * ./bin/main_ex2(.exe) data/dictionary.img data/correctme.txt
  * ```
  *
  * @section file_structure File Structure
  *
  * - **main.c**: Contains the main entry point of the application, which validates input arguments, reads dictionary and to-correct files, and performs the word correction using the edit distance algorithm.
  * - **text_io.h**: Provides functions for reading files, such as reading the dictionary and the words to be corrected, as well as counting lines in a file and reading words.
- * - **edit_distance.h**: Declares the `edit_distance_dyn` function used to compute the edit distance between two words.
+ * - **corrector.h**: Declares the `correct_words` function, which corrects the words on several threads with the chosen search engine.
+ * - **closest_word.h**: Declares the `find_closest_word` and `find_closest_words` functions, which scan the dictionary by length buckets, from the length of the word to correct outwards.
+ * - **bk_tree.h**: Provides the BK-tree index over the dictionary, which skips the words that the triangle inequality proves too far from the word to correct.
+ * - **symspell.h**: Provides the SymSpell deletion index over the dictionary, which finds the words within a small distance from the deletion variants of the word to correct.
+ * - **dictionary_image.h**: Provides the compilation of a dictionary into a binary image, and its loading through `mmap`.
+ * - **correction_cache.h**: Provides the bounded cache of the corrections, which evicts the least recently used word once full.
+ * - **trie.h**: Provides the trie over the dictionary, which computes the rows of the table of a common prefix once for all the words sharing it.
+ * - **qgram_index.h**: Provides the inverted index of the q-grams of the dictionary, which bounds the distance of a word from the number of q-grams it shares with the word to correct.
+ * - **edit_distance.h**: Declares the `edit_distance_bounded` function (and the other edit distance algorithms) used to compute the edit distance between two words.
  *
  * @section modules Modules and Functions
  *
  * - **Input Validation**: The function `validate_input` checks the validity of the input files, ensuring that the dictionary and to-correct files are different and can be opened.
  * - **Word Correction**:
- *   - `find_closest_word`: Uses the `edit_distance_dyn` algorithm to find the closest word from the dictionary for a given word.
+ *   - `correct_words`: Splits the words to correct across a pool of threads, which share the read-only dictionary and store the results in an array in the order of the words.
+ *   - `find_closest_word`: Uses the `edit_distance_batch` algorithm on the interleaved blocks of the dictionary, or `edit_distance_bounded` for words longer than 64 characters, to find the closest word from the dictionary for a given word, and stops once the length gap of the remaining buckets exceeds the best distance found so far.
+ *   - `find_closest_words`: Runs the same search keeping the `k` closest words in a bounded max-heap, whose worst word sets the bound of the distances and the length gap at which the search stops.
  * - **File Operations**:
  *   - `count_lines`: Counts the number of lines (words) in a file.
- *   - `read_dictionary`: Reads words from the dictionary file into an array.
+ *   - `load_dictionary`: Reads words from the dictionary file into an array, grouped in buckets by length.
+ *   - `save_dictionary_image` and `load_dictionary_image`: Write a loaded dictionary as a binary image, and map it back in memory without parsing it.
  *   - `read_to_correct`: Reads words from the file to be corrected.
- * - **Edit Distance Algorithm**: The `edit_distance_dyn` function is used to compute the distance between two words, guiding the correction process.
+ *   - `read_word`: Reads the next word of the text to correct, for the stream mode, which corrects a text of any size in one pass.
+ * - **Edit Distance Algorithm**: The `edit_distance_bounded` function is used to compute the distance between two words, guiding the correction process.
  *
  * @section error_handling Error Handling
  *
@@ -48,7 +77,8 @@
  * If any validation fails, the application prints an error message and exits with `EXIT_FAILURE`.
  *
  * @section performance Performance
- * The edit distance algorithm has a time complexity of O(m * n), where `m` is the length of the first word and `n` is the length of the second word. This means that the algorithm performs efficiently on words of average length but may experience slower performance on longer words.
+ * Words spelled correctly are found in a hash set of the dictionary, built when it is loaded, without computing any edit distance: only the other words go through the search engine, and a misspelled word met again is answered by the cache of the corrections.
+ * The edit distance algorithm has a time complexity of O(m * n), where `m` is the length of the first word and `n` is the length of the second word. Words of at most 64 characters are instead compared with a bit-parallel kernel, which packs a whole column of the table in a 64-bit word and runs in O(n) word operations. The scan compares them with 16 dictionary words of the same length at once, stored interleaved when the dictionary is loaded, so that the independent updates of the 16 columns overlap. Since each distance is bounded by the best one found so far, dictionary words whose length differs too much from the word to correct are skipped without being compared, and longer words only compute a diagonal band of the table until every cell of a row exceeds the bound.
  *
  * @section compilation Compilation Instructions
  * To compile the application, use:
@@ -66,11 +96,34 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <time.h>
 #include "text_io.h"
-#include "edit_distance.h"
+#include "corrector.h"
+#include "closest_word.h"
+#include "dictionary_image.h"
 #include "error_logger.h"
 
 
+#define MAX_THREADS 1024
+#define MAX_SUGGESTIONS 100
+#define STREAM_BATCH_WORDS 4096
+
+
+/**
+ * @brief Options given after the positional arguments.
+ */
+typedef struct _Options {
+    Engine engine;      ///< Search structure used to find the closest words.
+    int n_threads;      ///< Number of threads correcting the words.
+    int cache_capacity; ///< Maximum number of words in the cache of the corrections, 0 to disable it.
+    int n_suggestions;  ///< Number of suggestions printed for each word, 0 to print none.
+    int stream;         ///< Non-zero to correct the words as they are read, in constant memory.
+    int print_stats;    ///< Non-zero to print the build time and memory of the search structure.
+
+} Options;
+
+
 /**
  * @brief Validates the input arguments.
  *
@@ -79,11 +132,11 @@
  * if the dictionary file exists and if the to_correct file can be created.
  *
  * @param dictionary Path to the dictionary file.
- * @param to_correct Path to the to_correct file.
+ * @param to_correct Path to the to_correct file, or NULL for the standard input.
  * @throw `EXIT_FAILURE` if any of the input arguments is invalid.
  */
 void validate_input(const char* dictionary, const char* to_correct) {
-    if (strcmp(dictionary, to_correct) == 0) {
+    if (to_correct != NULL && strcmp(dictionary, to_correct) == 0) {
         print_error("dictionary and to_correct cannot be the same " \
                     "-> dictionary: %s, to_correct: %s", dictionary, to_correct);
 
@@ -96,6 +149,11 @@ void validate_input(const char* dictionary, const char* to_correct) {
         exit(EXIT_FAILURE);
     }
 
+    if (to_correct == NULL) {
+        fclose(dictionary_fp);
+        return;
+    }
+
     FILE* to_correct_fp = fopen(to_correct, "r");
     if (!to_correct_fp) {
         fclose(dictionary_fp);
@@ -108,19 +166,227 @@ void validate_input(const char* dictionary, const char* to_correct) {
     fclose(to_correct_fp);
 }
 
-void find_closest_word(const char* word, char** dictionary, int words_in_dictionary, const char** closest_word, int* min_distance) {
-    for (int i = 0; i < words_in_dictionary; i++) {
-        const char* dict_word = dictionary[i];
-        int distance = edit_distance_dyn(word, dict_word);
+/**
+ * @brief Parses the options following the positional arguments.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line arguments.
+ * @param options Receives the options.
+ * @return 1 if every option is valid, 0 otherwise.
+ */
+int parse_options(int argc, const char* argv[], Options* options) {
+    options -> engine = ENGINE_SCAN;
+    options -> n_threads = 1;
+    options -> cache_capacity = CORRECTION_CACHE_DEFAULT_CAPACITY;
+    options -> n_suggestions = 0;
+    options -> stream = 0;
+    options -> print_stats = 0;
+
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--engine=scan") == 0)
+            options -> engine = ENGINE_SCAN;
+        else if (strcmp(argv[i], "--engine=bktree") == 0)
+            options -> engine = ENGINE_BKTREE;
+        else if (strcmp(argv[i], "--engine=symspell") == 0)
+            options -> engine = ENGINE_SYMSPELL;
+        else if (strcmp(argv[i], "--engine=trie") == 0)
+            options -> engine = ENGINE_TRIE;
+        else if (strcmp(argv[i], "--engine=qgram") == 0)
+            options -> engine = ENGINE_QGRAM;
+        else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            char* end;
+            long n_threads = strtol(argv[i] + 10, &end, 10);
+            if (end == argv[i] + 10 || *end != '\0' || n_threads < 1 || n_threads > MAX_THREADS)
+                return 0;
+
+            options -> n_threads = (int)n_threads;
+        }
+        else if (strncmp(argv[i], "--cache=", 8) == 0) {
+            char* end;
+            long cache_capacity = strtol(argv[i] + 8, &end, 10);
+            if (end == argv[i] + 8 || *end != '\0' || cache_capacity < 0 || cache_capacity > INT_MAX)
+                return 0;
+
+            options -> cache_capacity = (int)cache_capacity;
+        }
+        else if (strncmp(argv[i], "--top=", 6) == 0) {
+            char* end;
+            long n_suggestions = strtol(argv[i] + 6, &end, 10);
+            if (end == argv[i] + 6 || *end != '\0' || n_suggestions < 1 || n_suggestions > MAX_SUGGESTIONS)
+                return 0;
+
+            options -> n_suggestions = (int)n_suggestions;
+        }
+        else if (strcmp(argv[i], "--stream") == 0)
+            options -> stream = 1;
+        else if (strcmp(argv[i], "--stats") == 0)
+            options -> print_stats = 1;
+        else
+            return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Returns the milliseconds elapsed since a given instant.
+ *
+ * @param start The instant, read from `CLOCK_MONOTONIC`.
+ * @return The elapsed time in milliseconds.
+ */
+double elapsed_ms(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (now.tv_sec - start -> tv_sec) * 1e3 + (now.tv_nsec - start -> tv_nsec) / 1e6;
+}
+
+/**
+ * @brief Prints the closest words of the dictionary for a word.
+ *
+ * @param word The word to correct.
+ * @param dictionary Pointer to the dictionary.
+ * @param n_suggestions Number of words to print, at most `MAX_SUGGESTIONS`.
+ */
+void print_suggestions(const char* word, const Dictionary* dictionary, int n_suggestions) {
+    Suggestion suggestions[MAX_SUGGESTIONS];
+
+    int n_found = find_closest_words(word, dictionary, n_suggestions, suggestions);
 
-        if (*min_distance == -1 || distance < *min_distance) {
-            *min_distance = distance;
-            *closest_word = dict_word;
+    printf("  Suggestions:");
+    for (int i = 0; i < n_found; i++)
+        printf("%s \"%s\" (%d)", i > 0 ? "," : "", suggestions[i].word, suggestions[i].distance);
+    printf("\n");
+}
 
-            if (distance == 0)
-                break;
+/**
+ * @brief Prints the correction of a word, and its suggestions if requested.
+ *
+ * @param word The word to correct.
+ * @param correction Correction of the word.
+ * @param dictionary Pointer to the dictionary.
+ * @param options Options of the program.
+ */
+void print_correction(const char* word, const Correction* correction, const Dictionary* dictionary, const Options* options) {
+    printf(
+        "Word: \"%s\", closest word: \"%s\", distance: %d (%s)\n", 
+        word, 
+        correction -> closest_word, 
+        correction -> distance,
+        correction -> distance == 0 ? "exact match" : "approximate match"
+    );
+
+    if (options -> n_suggestions > 0)
+        print_suggestions(word, dictionary, options -> n_suggestions);
+}
+
+/**
+ * @brief Corrects the words of a text as they are read, in constant memory.
+ *
+ * The text is read once with `read_word`, without counting its words first nor storing them: on
+ * one thread, each word is corrected and printed as soon as it is read; on several threads, the
+ * words are read by batches of `STREAM_BATCH_WORDS`, corrected by `correct_words` and printed
+ * before the next batch is read. Only the batch and the bounded cache of the corrections are kept
+ * in memory, whatever the size of the text.
+ *
+ * @param corrector Pointer to the corrector.
+ * @param to_correct_fp File pointer to the text to correct.
+ * @param options Options of the program.
+ * @return The number of words corrected, or -1 if an error occurs.
+ */
+long correct_stream(const Corrector* corrector, FILE* to_correct_fp, const Options* options) {
+    int batch_size = options -> n_threads > 1 ? STREAM_BATCH_WORDS : 1;
+
+    char* buffer = malloc((size_t)batch_size * MAX_LINE_LENGTH);
+    char** words = malloc(batch_size * sizeof(char*));
+    Correction* corrections = malloc(batch_size * sizeof(Correction));
+
+    if (buffer == NULL || words == NULL || corrections == NULL) {
+        free(buffer);
+        free(words);
+        free(corrections);
+
+        return -1;
+    }
+
+    for (int i = 0; i < batch_size; i++)
+        words[i] = buffer + (size_t)i * MAX_LINE_LENGTH;
+
+    long words_corrected = 0;
+    int n_words, length = 0;
+
+    do {
+        n_words = 0;
+        while (n_words < batch_size && (length = read_word(to_correct_fp, words[n_words], MAX_LINE_LENGTH)) > 0)
+            n_words++;
+
+        if (length < 0 || correct_words(corrector, words, n_words, options -> n_threads, corrections) < 0) {
+            words_corrected = -1;
+            break;
         }
+
+        for (int i = 0; i < n_words; i++)
+            print_correction(words[i], &corrections[i], corrector -> dictionary, options);
+
+        words_corrected += n_words;
+    } while (length > 0);
+
+    free(buffer);
+    free(words);
+    free(corrections);
+
+    return words_corrected;
+}
+
+/**
+ * @brief Compiles a dictionary into a binary image.
+ *
+ * The image is loaded by the next runs in place of the text dictionary, without parsing it.
+ *
+ * @param dictionary Path to the text dictionary.
+ * @param image Path to the image to write.
+ * @return `EXIT_SUCCESS` if the image is written, `EXIT_FAILURE` otherwise.
+ */
+int compile_dictionary(const char* dictionary, const char* image) {
+    FILE* dictionary_fp = fopen(dictionary, "r");
+    if (dictionary_fp == NULL) {
+        print_error("Error: dictionary file does not exist -> %s", dictionary);
+        return EXIT_FAILURE;
+    }
+
+    Dictionary loaded;
+    if (load_dictionary(dictionary_fp, &loaded) < 1) {
+        fclose(dictionary_fp);
+
+        print_error("No words read from dictionary.");
+        return EXIT_FAILURE;
     }
+
+    fclose(dictionary_fp);
+
+    FILE* image_fp = fopen(image, "wb");
+    if (image_fp == NULL) {
+        free_dictionary(&loaded);
+
+        print_error("Unable to create the dictionary image -> %s", image);
+        return EXIT_FAILURE;
+    }
+
+    long image_size = save_dictionary_image(&loaded, image_fp);
+    int closed = fclose(image_fp) == 0;
+
+    if (image_size < 0 || !closed) {
+        free_dictionary(&loaded);
+        remove(image);
+
+        print_error("Unable to write the dictionary image -> %s", image);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "Compiled %d words into %s (%ld bytes)\n", loaded.n_words, image, image_size);
+    free_dictionary(&loaded);
+
+    return EXIT_SUCCESS;
 }
 
 /**
@@ -136,20 +402,35 @@ void find_closest_word(const char* word, char** dictionary, int words_in_diction
  *         `EXIT_FAILURE` if the input arguments are invalid.
  */
 int main(int argc, const char* argv[]) {
-    if (argc != 3) {
+    if (argc == 4 && strcmp(argv[1], "--compile") == 0)
+        return compile_dictionary(argv[2], argv[3]);
+
+    Options options;
+    if (argc < 3 || !parse_options(argc, argv, &options)) {
         print_error(
             "Usage:\n"
-            "  %s <dictionary_path> <to_correct_path>\n"
+            "  %s <dictionary_path> <to_correct_path> [--engine=scan|bktree|symspell|trie|qgram] [--threads=N] [--cache=N] [--top=K] [--stream] [--stats]\n"
+            "  %s --compile <dictionary_path> <image_path>\n"
             "Options:\n"
-            "  <dictionary_path> Path to the dictionary file.\n"
+            "  <dictionary_path> Path to the dictionary file, or to its compiled image.\n"
             "  <to_correct_path> Path to the file containing the text to correct.\n"
+            "  --engine          Search structure: scan of the dictionary by length (default), BK-tree,\n"
+            "                    SymSpell deletion index (within distance 2, then scan), trie or\n"
+            "                    trigram index (count filter, then scan for short words).\n"
+            "  --threads         Number of threads correcting the words (default: 1).\n"
+            "  --cache           Number of corrections remembered (default: 65536, 0 to disable).\n"
+            "  --top             Print the K closest words of the dictionary for each word (at most 100).\n"
+            "  --stream          Correct the words as they are read, in constant memory ('-' reads the standard input).\n"
+            "  --stats           Print the build time and memory of the search structure.\n"
             "Example:\n"
-            "  %s data/dictionary.txt data/correctme.txt\n", argv[0], argv[0]
+            "  %s data/dictionary.txt data/correctme.txt\n", argv[0], argv[0], argv[0]
         );
         exit(EXIT_FAILURE);
     }
 
-    validate_input(argv[1], argv[2]);
+    // The standard input can only be read once, by the stream
+    int from_stdin = options.stream && strcmp(argv[2], "-") == 0;
+    validate_input(argv[1], from_stdin ? NULL : argv[2]);
 
     FILE* dictionary_fp = fopen(argv[1], "r");
     if (dictionary_fp == NULL) {
@@ -157,16 +438,34 @@ int main(int argc, const char* argv[]) {
         exit(EXIT_FAILURE);
     }
 
-    char** dictionary;
-    int words_in_dictionary = read_dictionary(dictionary_fp, &dictionary);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    Dictionary dictionary;
+    int is_image = is_dictionary_image(dictionary_fp);
+    int words_in_dictionary;
+
+    // Compiled images are read in binary mode
+    if (is_image) {
+        dictionary_fp = freopen(argv[1], "rb", dictionary_fp);
+        words_in_dictionary = dictionary_fp != NULL ? load_dictionary_image(dictionary_fp, &dictionary) : -1;
+    }
+    else
+        words_in_dictionary = load_dictionary(dictionary_fp, &dictionary);
+
     if (words_in_dictionary < 1) {
-        fclose(dictionary_fp);
+        if (dictionary_fp != NULL)
+            fclose(dictionary_fp);
 
-        print_error("No words read from dictionary.");
+        print_error(is_image ? "Invalid dictionary image." : "No words read from dictionary.");
         exit(EXIT_FAILURE);
     }
 
-    FILE* to_correct_fp = fopen(argv[2], "r");
+    if (options.print_stats)
+        fprintf(stderr, "Dictionary: %d words loaded from %s in %.1f ms\n",
+            words_in_dictionary, is_image ? "its image" : "text", elapsed_ms(&start));
+
+    FILE* to_correct_fp = from_stdin ? stdin : fopen(argv[2], "r");
     if (to_correct_fp == NULL) {
         fclose(dictionary_fp);
 
@@ -174,53 +473,108 @@ int main(int argc, const char* argv[]) {
         exit(EXIT_FAILURE);
     }
 
-    int words_in_to_correct = count_words(to_correct_fp);
-    if (words_in_to_correct < 1) {
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    Corrector corrector;
+    if (corrector_init(&corrector, &dictionary, options.engine) < 1) {
         fclose(dictionary_fp);
         fclose(to_correct_fp);
 
-        print_error("No words read from to_correct file.");
+        print_error("Unable to build the index of the dictionary.");
         exit(EXIT_FAILURE);
     }
 
-    char** to_correct;
-    int words_read = read_to_correct(to_correct_fp, &to_correct);
-    if (words_read < 1) {
+    if (options.cache_capacity > 0 && corrector_enable_cache(&corrector, options.cache_capacity) < 1) {
         fclose(dictionary_fp);
         fclose(to_correct_fp);
 
-        print_error("No words read from to_correct file.");
+        print_error("Unable to allocate the cache of the corrections.");
         exit(EXIT_FAILURE);
     }
-    
-    const char* word;
-    int min_distance;
-    const char* closest_word;
-    for (int i = 0; i < words_in_to_correct; i++) {
-        word = to_correct[i];
-        min_distance = -1;
-        closest_word = NULL;
-
-        find_closest_word(word, dictionary, words_in_dictionary, &closest_word, &min_distance);
-
-        printf(
-            "Word: \"%s\", closest word: \"%s\", distance: %d (%s)\n", 
-            word, 
-            closest_word, 
-            min_distance,
-            min_distance == 0 ? "exact match" : "approximate match"
-        );
+
+    if (options.print_stats) {
+        double build_ms = elapsed_ms(&start);
+
+        if (options.engine == ENGINE_BKTREE)
+            fprintf(stderr, "BK-tree: %d nodes, %zu bytes, built in %.1f ms\n",
+                corrector.tree.n_nodes, bk_tree_memory_usage(&corrector.tree), build_ms);
+        else if (options.engine == ENGINE_SYMSPELL)
+            fprintf(stderr, "SymSpell index: %zu variants, %zu word indexes, %zu bytes, built in %.1f ms\n",
+                corrector.symspell.n_variants, corrector.symspell.n_postings, symspell_memory_usage(&corrector.symspell), build_ms);
+        else if (options.engine == ENGINE_TRIE)
+            fprintf(stderr, "Trie: %d nodes, %zu bytes, built in %.1f ms\n",
+                corrector.trie.n_nodes, trie_memory_usage(&corrector.trie), build_ms);
+        else if (options.engine == ENGINE_QGRAM)
+            fprintf(stderr, "Q-gram index: %zu grams, %zu word indexes, %zu bytes, built in %.1f ms\n",
+                corrector.qgram.n_grams, corrector.qgram.n_postings, qgram_memory_usage(&corrector.qgram), build_ms);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
     }
 
-    for (int i = 0; i < words_in_dictionary; i++)
-        free(dictionary[i]);
+    if (options.stream) {
+        long words_corrected = correct_stream(&corrector, to_correct_fp, &options);
+        if (words_corrected < 0) {
+            fclose(dictionary_fp);
+            fclose(to_correct_fp);
+
+            print_error("Unable to correct the words.");
+            exit(EXIT_FAILURE);
+        }
+
+        if (options.print_stats)
+            fprintf(stderr, "Corrected %ld words in %.1f ms with %d thread(s), streamed\n", words_corrected, elapsed_ms(&start), options.n_threads);
+    }
+    else {
+        int words_in_to_correct = count_words(to_correct_fp);
+        if (words_in_to_correct < 1) {
+            fclose(dictionary_fp);
+            fclose(to_correct_fp);
 
-    free(dictionary);
+            print_error("No words read from to_correct file.");
+            exit(EXIT_FAILURE);
+        }
+
+        char** to_correct;
+        int words_read = read_to_correct(to_correct_fp, &to_correct);
+        if (words_read < 1) {
+            fclose(dictionary_fp);
+            fclose(to_correct_fp);
+
+            print_error("No words read from to_correct file.");
+            exit(EXIT_FAILURE);
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        Correction* corrections = malloc(words_in_to_correct * sizeof(Correction));
+        if (corrections == NULL || correct_words(&corrector, to_correct, words_in_to_correct, options.n_threads, corrections) < 0) {
+            fclose(dictionary_fp);
+            fclose(to_correct_fp);
+
+            print_error("Unable to correct the words.");
+            exit(EXIT_FAILURE);
+        }
+
+        if (options.print_stats)
+            fprintf(stderr, "Corrected %d words in %.1f ms with %d thread(s)\n", words_in_to_correct, elapsed_ms(&start), options.n_threads);
+
+        for (int i = 0; i < words_in_to_correct; i++)
+            print_correction(to_correct[i], &corrections[i], &dictionary, &options);
+
+        free(corrections);
+
+        for (int i = 0; i < words_in_to_correct; i++)
+            free(to_correct[i]);
+
+        free(to_correct);
+    }
 
-    for (int i = 0; i < words_in_to_correct; i++)
-        free(to_correct[i]);
+    if (options.print_stats && corrector.cache != NULL)
+        fprintf(stderr, "Cache: %d words, %zu hits, %zu misses\n",
+            corrector.cache -> n_entries, corrector.cache -> hits, corrector.cache -> misses);
 
-    free(to_correct);
+    corrector_free(&corrector);
+    free_dictionary(&dictionary);
 
     fclose(to_correct_fp);
     fclose(dictionary_fp);
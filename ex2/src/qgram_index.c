@@ -0,0 +1,410 @@
+/**
+ * @file qgram_index.c
+ * @brief Implementation of the inverted index of the q-grams of the words of a dictionary.
+ */
+
+#include "qgram_index.h"
+#include "edit_distance.h"
+#include <string.h>
+
+
+#define PADDING '\0' // never part of a word, so the padded q-grams only match at the ends of the words
+#define MAX_SKIPPED_GRAMS (QGRAM_LENGTH - 1) // lowers the radius of a search by at most one
+
+/**
+ * @brief Position in the list of words of a q-gram of the query, merged with the other ones.
+ */
+typedef struct _PostingCursor {
+    int word;         ///< Word at the current position.
+    uint32_t position;
+    uint32_t end;
+    int multiplicity; ///< Number of occurrences of the q-gram in the query.
+
+} PostingCursor;
+
+/**
+ * @brief Word sharing q-grams with the query, and the lower bound of its distance.
+ */
+typedef struct _Candidate {
+    int bound;
+    int index;
+
+} Candidate;
+
+// Writes the q-grams of a word padded on both sides, returns their number
+static int word_qgrams(const char* word, int length, uint32_t* grams) {
+    int n_grams = length + QGRAM_LENGTH - 1;
+
+    for (int i = 0; i < n_grams; i++) {
+        uint32_t gram = 0;
+
+        // The q-gram at `i` spans the characters from `i - (QGRAM_LENGTH - 1)` to `i` of the word
+        for (int j = i - (QGRAM_LENGTH - 1); j <= i; j++)
+            gram = (gram << 8) | (unsigned char)(j >= 0 && j < length ? word[j] : PADDING);
+
+        grams[i] = gram;
+    }
+
+    return n_grams;
+}
+
+/**
+ * Sorts the pairs (q-gram, word), the q-gram in the high 32 bits, by their
+ * q-gram with a least significant digit radix sort, one pass per character:
+ * each pass is stable, so the pairs of a q-gram stay in the order they were
+ * generated, which is dictionary order.
+ */
+static int sort_pairs(uint64_t* pairs, size_t n_pairs) {
+    uint64_t* buffer = malloc(n_pairs * sizeof(uint64_t));
+    if (buffer == NULL)
+        return -1;
+
+    uint64_t* from = pairs;
+    uint64_t* to = buffer;
+
+    for (int shift = 32; shift < 32 + 8 * QGRAM_LENGTH; shift += 8) {
+        size_t starts[257] = { 0 };
+
+        for (size_t p = 0; p < n_pairs; p++)
+            starts[((from[p] >> shift) & 0xFF) + 1]++;
+
+        for (int digit = 0; digit < 256; digit++)
+            starts[digit + 1] += starts[digit];
+
+        for (size_t p = 0; p < n_pairs; p++)
+            to[starts[(from[p] >> shift) & 0xFF]++] = from[p];
+
+        uint64_t* swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != pairs)
+        memcpy(pairs, from, n_pairs * sizeof(uint64_t));
+
+    free(buffer);
+
+    return 0;
+}
+
+static int compare_uint32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Position of a q-gram in the sorted array of the index, or -1
+static long find_gram(const QGramIndex* index, uint32_t gram) {
+    size_t low = 0, high = index -> n_grams;
+
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+
+        if (index -> grams[middle] < gram)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low < index -> n_grams && index -> grams[low] == gram ? (long)low : -1;
+}
+
+// Restores the heap of cursors, ordered by word, below a cursor
+static void sift_down(PostingCursor* heap, int size, int i) {
+    for (;;) {
+        int smallest = i;
+        int left = 2 * i + 1, right = 2 * i + 2;
+
+        if (left < size && heap[left].word < heap[smallest].word)
+            smallest = left;
+        if (right < size && heap[right].word < heap[smallest].word)
+            smallest = right;
+
+        if (smallest == i)
+            return;
+
+        PostingCursor swap = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = swap;
+        i = smallest;
+    }
+}
+
+/**
+ * The pairs (q-gram, word) of every word are sorted together by q-gram: the
+ * words of each q-gram then come in dictionary order, a word repeated once
+ * per occurrence of the q-gram, and the q-grams are in increasing order.
+ */
+int qgram_build(QGramIndexPtr index, char** dictionary, int words_in_dictionary) {
+    if (index == NULL || dictionary == NULL || words_in_dictionary < 1)
+        return -1;
+
+    memset(index, 0, sizeof(QGramIndex));
+
+    size_t n_pairs = 0;
+    int max_length = 0;
+
+    for (int i = 0; i < words_in_dictionary; i++) {
+        size_t length = strlen(dictionary[i]);
+        if (length > QGRAM_MAX_WORD_LENGTH)
+            return -1;
+
+        n_pairs += length + QGRAM_LENGTH - 1;
+        if ((int)length > max_length)
+            max_length = (int)length;
+    }
+
+    uint64_t* pairs = malloc(n_pairs * sizeof(uint64_t));
+    uint32_t* grams = malloc((max_length + QGRAM_LENGTH - 1) * sizeof(uint32_t));
+    index -> lengths = malloc(words_in_dictionary * sizeof(uint16_t));
+
+    if (pairs == NULL || grams == NULL || index -> lengths == NULL) {
+        free(pairs);
+        free(grams);
+        qgram_free(index);
+
+        return -1;
+    }
+
+    size_t n_filled = 0;
+    for (int i = 0; i < words_in_dictionary; i++) {
+        index -> lengths[i] = (uint16_t)strlen(dictionary[i]);
+        int n_grams = word_qgrams(dictionary[i], index -> lengths[i], grams);
+
+        for (int g = 0; g < n_grams; g++)
+            pairs[n_filled++] = ((uint64_t)grams[g] << 32) | (uint32_t)i;
+    }
+
+    free(grams);
+
+    if (sort_pairs(pairs, n_pairs) != 0) {
+        free(pairs);
+        qgram_free(index);
+
+        return -1;
+    }
+
+    size_t n_distinct = 0;
+    for (size_t p = 0; p < n_pairs; p++)
+        if (p == 0 || (pairs[p] >> 32) != (pairs[p - 1] >> 32))
+            n_distinct++;
+
+    index -> grams = malloc(n_distinct * sizeof(uint32_t));
+    index -> starts = malloc((n_distinct + 1) * sizeof(uint32_t));
+    index -> postings = malloc(n_pairs * sizeof(int));
+
+    if (index -> grams == NULL || index -> starts == NULL || index -> postings == NULL) {
+        free(pairs);
+        qgram_free(index);
+
+        return -1;
+    }
+
+    for (size_t p = 0; p < n_pairs; p++) {
+        uint32_t gram = (uint32_t)(pairs[p] >> 32);
+
+        if (p == 0 || gram != index -> grams[index -> n_grams - 1]) {
+            index -> grams[index -> n_grams] = gram;
+            index -> starts[index -> n_grams++] = (uint32_t)p;
+        }
+
+        index -> postings[p] = (int)(uint32_t)pairs[p];
+    }
+
+    index -> starts[index -> n_grams] = (uint32_t)n_pairs;
+    index -> n_postings = n_pairs;
+    index -> dictionary = dictionary;
+    index -> words_in_dictionary = words_in_dictionary;
+
+    free(pairs);
+
+    return words_in_dictionary;
+}
+
+void qgram_free(QGramIndexPtr index) {
+    if (index == NULL)
+        return;
+
+    free(index -> lengths);
+    free(index -> grams);
+    free(index -> starts);
+    free(index -> postings);
+
+    memset(index, 0, sizeof(QGramIndex));
+}
+
+size_t qgram_memory_usage(const QGramIndex* index) {
+    if (index == NULL)
+        return 0;
+
+    return index -> n_grams * sizeof(uint32_t) + (index -> n_grams + 1) * sizeof(uint32_t) + index -> n_postings * sizeof(int)
+        + index -> words_in_dictionary * sizeof(uint16_t);
+}
+
+/**
+ * The lists of the distinct q-grams of the query are merged with a heap of
+ * cursors ordered by word: each word comes out once, with the number of
+ * q-grams it shares with the query, each q-gram counted as many times as it
+ * occurs in both words. The longest lists, up to `MAX_SKIPPED_GRAMS` q-grams,
+ * often the padded first and last characters, are not merged: their q-grams
+ * are counted as shared by every word, which keeps the bounds below valid.
+ *
+ * A word of `|Gw|` q-grams sharing `c` of them with a query of `|G|` q-grams
+ * is at least `ceil((max(|G|, |Gw|) - c) / q)` away, and at least the
+ * difference of their lengths. A word out of the merged lists shares at most
+ * the skipped q-grams, so it is at least `ceil((|G| - skipped) / q)` away:
+ * only the words whose bound is below this radius are kept. They come out of
+ * the merge in dictionary order, and are verified by increasing bound until
+ * the bound exceeds the best distance found.
+ */
+int qgram_find_closest(const QGramIndex* index, const char* word, const char** closest_word, int* min_distance) {
+    if (index == NULL || index -> n_grams == 0 || word == NULL)
+        return -1;
+
+    int length = (int)strlen(word);
+    int n_query = length + QGRAM_LENGTH - 1;
+
+    uint32_t* query = malloc(n_query * sizeof(uint32_t));
+    PostingCursor* heap = malloc(n_query * sizeof(PostingCursor));
+    if (query == NULL || heap == NULL) {
+        free(query);
+        free(heap);
+
+        return -1;
+    }
+
+    word_qgrams(word, length, query);
+    qsort(query, n_query, sizeof(uint32_t), compare_uint32);
+
+    int heap_size = 0;
+
+    for (int g = 0; g < n_query; ) {
+        int multiplicity = 1;
+        while (g + multiplicity < n_query && query[g + multiplicity] == query[g])
+            multiplicity++;
+
+        long position = find_gram(index, query[g]);
+        if (position != -1) {
+            PostingCursor* cursor = &heap[heap_size++];
+
+            cursor -> position = index -> starts[position];
+            cursor -> end = index -> starts[position + 1];
+            cursor -> word = index -> postings[cursor -> position];
+            cursor -> multiplicity = multiplicity;
+        }
+
+        g += multiplicity;
+    }
+
+    free(query);
+
+    // Skips the longest lists, by selection among the few q-grams of the query
+    int skipped = 0;
+    for (;;) {
+        int longest = -1;
+
+        for (int i = 0; i < heap_size; i++)
+            if (longest == -1 || heap[i].end - heap[i].position > heap[longest].end - heap[longest].position)
+                longest = i;
+
+        if (longest == -1 || skipped + heap[longest].multiplicity > MAX_SKIPPED_GRAMS)
+            break;
+
+        skipped += heap[longest].multiplicity;
+        heap[longest] = heap[--heap_size];
+    }
+
+    size_t n_listed = 0;
+    for (int i = 0; i < heap_size; i++)
+        n_listed += heap[i].end - heap[i].position;
+
+    int radius = (n_query - skipped + QGRAM_LENGTH - 1) / QGRAM_LENGTH;
+
+    for (int i = heap_size / 2 - 1; i >= 0; i--)
+        sift_down(heap, heap_size, i);
+
+    Candidate* candidates = malloc((n_listed > 0 ? n_listed : 1) * sizeof(Candidate));
+    if (candidates == NULL) {
+        free(heap);
+        return -1;
+    }
+
+    int n_candidates = 0;
+
+    while (heap_size > 0) {
+        int candidate = heap[0].word;
+        int shared = skipped;
+
+        while (heap_size > 0 && heap[0].word == candidate) {
+            PostingCursor* cursor = &heap[0];
+            int occurrences = 0;
+
+            while (cursor -> position < cursor -> end && index -> postings[cursor -> position] == candidate) {
+                cursor -> position++;
+                occurrences++;
+            }
+
+            shared += occurrences < cursor -> multiplicity ? occurrences : cursor -> multiplicity;
+
+            if (cursor -> position < cursor -> end)
+                cursor -> word = index -> postings[cursor -> position];
+            else
+                heap[0] = heap[--heap_size];
+
+            sift_down(heap, heap_size, 0);
+        }
+
+        int candidate_length = index -> lengths[candidate];
+        int n_candidate = candidate_length + QGRAM_LENGTH - 1;
+        int most = n_query > n_candidate ? n_query : n_candidate;
+
+        int bound = (most - shared + QGRAM_LENGTH - 1) / QGRAM_LENGTH;
+        int length_gap = abs(length - candidate_length);
+        if (length_gap > bound)
+            bound = length_gap;
+
+        if (bound < radius) {
+            candidates[n_candidates].bound = bound;
+            candidates[n_candidates++].index = candidate;
+        }
+    }
+
+    free(heap);
+
+    int best_distance = radius;
+    int best_index = -1;
+
+    // One pass over the candidates per bound, each in dictionary order
+    for (int bound = 0; bound <= best_distance && bound < radius; bound++) {
+        for (int c = 0; c < n_candidates; c++) {
+            if (candidates[c].bound != bound)
+                continue;
+
+            if (bound == best_distance && candidates[c].index > best_index)
+                break;
+
+            // Without a word found yet, only the distances below the radius are of interest
+            int limit = best_index == -1 ? radius - 1 : best_distance;
+            int distance = edit_distance_bounded(word, index -> dictionary[candidates[c].index], limit);
+
+            if (distance < 0) {
+                free(candidates);
+                return -1;
+            }
+
+            if (distance <= limit && (best_index == -1 || distance < best_distance || candidates[c].index < best_index)) {
+                best_distance = distance;
+                best_index = candidates[c].index;
+            }
+        }
+    }
+
+    free(candidates);
+
+    if (best_index != -1 && closest_word != NULL)
+        *closest_word = index -> dictionary[best_index];
+
+    if (best_index != -1 && min_distance != NULL)
+        *min_distance = best_distance;
+
+    return best_index;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file symspell.c
+ * @brief Implementation of the SymSpell-style deletion index over the words of a dictionary.
+ */
+
+#include "symspell.h"
+#include "edit_distance.h"
+#include <string.h>
+#include <limits.h>
+
+
+#define EMPTY_SLOT 0
+#define MIN_CAPACITY 1024
+#define MAX_LOAD_NUMERATOR 7    // the table is sized for a load factor of at most 7/10
+#define MAX_LOAD_DENOMINATOR 10
+#define NO_WORD UINT32_MAX
+
+/**
+ * @brief Function called on every deletion variant of a word.
+ */
+typedef void (*VariantVisitor)(uint64_t hash, void* context);
+
+/**
+ * @brief State of the first pass of the construction: counting the words of each variant.
+ */
+typedef struct _CountContext {
+    SymSpellIndexPtr index;
+    uint32_t* last_word; ///< Last word counted in each slot, so that a word is counted once per variant.
+    uint32_t word;       ///< Word whose variants are being visited.
+
+} CountContext;
+
+/**
+ * @brief State of the second pass of the construction: filling the word indexes of each variant.
+ */
+typedef struct _FillContext {
+    SymSpellIndexPtr index;
+    int word;            ///< Word whose variants are being visited.
+
+} FillContext;
+
+/**
+ * @brief State of a search: the best word found so far.
+ */
+typedef struct _SearchContext {
+    const SymSpellIndex* index;
+    const char* word;    ///< The word to look for.
+    int best_distance;
+    int best_index;
+
+} SearchContext;
+
+// FNV-1a hash of a variant, never equal to EMPTY_SLOT
+static uint64_t hash_variant(const char* variant, int length) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (int i = 0; i < length; i++) {
+        hash ^= (unsigned char)variant[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash == EMPTY_SLOT ? 1 : hash;
+}
+
+// Slot holding a hash, or the empty slot where it would be inserted
+static size_t find_slot(const uint64_t* keys, size_t capacity, uint64_t hash) {
+    size_t mask = capacity - 1;
+    size_t slot = (size_t)(hash ^ (hash >> 32)) & mask;
+
+    while (keys[slot] != EMPTY_SLOT && keys[slot] != hash)
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+/**
+ * Visits the variant held by the first `length` characters of `buffer`, then
+ * the ones obtained by deleting up to `deletions_left` more characters at
+ * positions from `start` on: deleting positions in increasing order visits
+ * each set of deleted positions once. `buffer` is restored before returning.
+ */
+static void visit_deletions(char* buffer, int length, int start, int deletions_left, VariantVisitor visit, void* context) {
+    visit(hash_variant(buffer, length), context);
+
+    if (deletions_left == 0)
+        return;
+
+    for (int i = start; i < length; i++) {
+        char deleted = buffer[i];
+
+        memmove(buffer + i, buffer + i + 1, length - i - 1);
+        visit_deletions(buffer, length - 1, i, deletions_left - 1, visit, context);
+        memmove(buffer + i + 1, buffer + i, length - i - 1);
+
+        buffer[i] = deleted;
+    }
+}
+
+static void for_each_variant(const char* word, int max_deletions, VariantVisitor visit, void* context) {
+    int length = (int)strlen(word);
+    char buffer[length + 1];
+
+    memcpy(buffer, word, length + 1);
+    visit_deletions(buffer, length, 0, max_deletions, visit, context);
+}
+
+// Number of variants of a word of the given length, duplicates included
+static size_t count_variants(int length, int max_deletions) {
+    size_t total = 0;
+    size_t combinations = 1;
+
+    for (int d = 0; d <= max_deletions && d <= length; d++) {
+        total += combinations;
+        combinations = combinations * (length - d) / (d + 1);
+    }
+
+    return total;
+}
+
+static void count_variant(uint64_t hash, void* context) {
+    CountContext* count = context;
+    SymSpellIndexPtr index = count -> index;
+
+    size_t slot = find_slot(index -> keys, index -> capacity, hash);
+
+    if (index -> keys[slot] == EMPTY_SLOT) {
+        index -> keys[slot] = hash;
+        count -> last_word[slot] = NO_WORD;
+        index -> n_variants++;
+    }
+
+    // A word may yield the same variant several times, e.g. "bok" from "book"
+    if (count -> last_word[slot] != count -> word) {
+        count -> last_word[slot] = count -> word;
+        index -> counts[slot]++;
+    }
+}
+
+static void fill_variant(uint64_t hash, void* context) {
+    FillContext* fill = context;
+    SymSpellIndexPtr index = fill -> index;
+
+    size_t slot = find_slot(index -> keys, index -> capacity, hash);
+    uint32_t filled = index -> counts[slot];
+
+    if (filled > 0 && index -> postings[index -> starts[slot] + filled - 1] == fill -> word)
+        return;
+
+    index -> postings[index -> starts[slot] + filled] = fill -> word;
+    index -> counts[slot]++;
+}
+
+/**
+ * The table is built in two passes over the variants of the words: the first
+ * one inserts the variants and counts their words, which gives the position
+ * of each variant in `postings`, and the second one appends the words to them.
+ * The words being visited in dictionary order, each variant lists its words
+ * in dictionary order, which lets the searches break ties as a linear scan.
+ */
+int symspell_build(SymSpellIndexPtr index, char** dictionary, int words_in_dictionary, int max_distance) {
+    if (index == NULL || dictionary == NULL || words_in_dictionary < 1 || max_distance < 0)
+        return -1;
+
+    memset(index, 0, sizeof(SymSpellIndex));
+
+    index -> dictionary = dictionary;
+    index -> words_in_dictionary = words_in_dictionary;
+    index -> max_distance = max_distance;
+    index -> capacity = MIN_CAPACITY;
+
+    // Counting the variants with their duplicates bounds the number of distinct ones, so the table never grows
+    size_t expected_variants = 0;
+    for (int i = 0; i < words_in_dictionary; i++)
+        expected_variants += count_variants((int)strlen(dictionary[i]), max_distance);
+
+    while (expected_variants * MAX_LOAD_DENOMINATOR > index -> capacity * MAX_LOAD_NUMERATOR)
+        index -> capacity *= 2;
+
+    index -> keys = calloc(index -> capacity, sizeof(uint64_t));
+    index -> counts = calloc(index -> capacity, sizeof(uint32_t));
+
+    CountContext count = { index, malloc(index -> capacity * sizeof(uint32_t)), 0 };
+
+    if (!index -> keys || !index -> counts || !count.last_word) {
+        free(count.last_word);
+        symspell_free(index);
+
+        return -1;
+    }
+
+    for (int i = 0; i < words_in_dictionary; i++) {
+        int length = (int)strlen(dictionary[i]);
+        if (length > index -> max_word_length)
+            index -> max_word_length = length;
+
+        count.word = (uint32_t)i;
+        for_each_variant(dictionary[i], max_distance, count_variant, &count);
+    }
+
+    free(count.last_word);
+
+    index -> starts = malloc(index -> capacity * sizeof(uint32_t));
+    if (!index -> starts) {
+        symspell_free(index);
+        return -1;
+    }
+
+    for (size_t slot = 0; slot < index -> capacity; slot++) {
+        index -> starts[slot] = (uint32_t)index -> n_postings;
+        index -> n_postings += index -> counts[slot];
+        index -> counts[slot] = 0;
+    }
+
+    index -> postings = malloc(index -> n_postings * sizeof(int));
+    if (!index -> postings) {
+        symspell_free(index);
+        return -1;
+    }
+
+    FillContext fill = { index, 0 };
+    for (int i = 0; i < words_in_dictionary; i++) {
+        fill.word = i;
+        for_each_variant(dictionary[i], max_distance, fill_variant, &fill);
+    }
+
+    return words_in_dictionary;
+}
+
+void symspell_free(SymSpellIndexPtr index) {
+    if (index == NULL)
+        return;
+
+    free(index -> keys);
+    free(index -> starts);
+    free(index -> counts);
+    free(index -> postings);
+
+    memset(index, 0, sizeof(SymSpellIndex));
+}
+
+size_t symspell_memory_usage(const SymSpellIndex* index) {
+    return index -> capacity * (sizeof(uint64_t) + 2 * sizeof(uint32_t)) + index -> n_postings * sizeof(int);
+}
+
+static void check_variant(uint64_t hash, void* context) {
+    SearchContext* search = context;
+    const SymSpellIndex* index = search -> index;
+
+    size_t slot = find_slot(index -> keys, index -> capacity, hash);
+    if (index -> keys[slot] == EMPTY_SLOT)
+        return;
+
+    const int* words = index -> postings + index -> starts[slot];
+    for (uint32_t i = 0; i < index -> counts[slot]; i++) {
+        int d = edit_distance_bounded(search -> word, index -> dictionary[words[i]], search -> best_distance);
+
+        if (d < search -> best_distance || (d == search -> best_distance && words[i] < search -> best_index)) {
+            search -> best_distance = d;
+            search -> best_index = words[i];
+        }
+    }
+}
+
+int symspell_find_closest(const SymSpellIndex* index, const char* word, const char** closest_word, int* min_distance) {
+    if (index == NULL || index -> keys == NULL || word == NULL)
+        return -1;
+
+    // Each character beyond the longest word of the dictionary must be deleted
+    if ((int)strlen(word) > index -> max_word_length + index -> max_distance)
+        return -1;
+
+    SearchContext search = { index, word, index -> max_distance, INT_MAX };
+    for_each_variant(word, index -> max_distance, check_variant, &search);
+
+    if (search.best_index == INT_MAX)
+        return -1;
+
+    if (closest_word != NULL)
+        *closest_word = index -> dictionary[search.best_index];
+
+    if (min_distance != NULL)
+        *min_distance = search.best_distance;
+
+    return search.best_index;
+}
@@ -4,6 +4,8 @@
  */
 
 #include "text_io.h"
+#include "dictionary_image.h"
+#include <stdint.h>
 
 
 int count_lines(FILE* file_fp) {
@@ -113,6 +115,186 @@ int read_dictionary(FILE* dictionary_fp, char*** dictionary) {
     return words_read;
 }
 
+/**
+ * @brief Hashes a word with FNV-1a.
+ *
+ * @param word The word to hash.
+ * @return The hash of the word.
+ */
+static size_t hash_word(const char* word) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    while (*word) {
+        hash ^= (unsigned char)*word++;
+        hash *= 1099511628211ULL;
+    }
+
+    return (size_t)(hash ^ (hash >> 32));
+}
+
+/**
+ * @brief Slot of a word in the hash set of a dictionary.
+ *
+ * Linear probing from the slot of the hash of the word, up to the slot holding
+ * the word or the first empty one.
+ *
+ * @param dictionary Pointer to the dictionary.
+ * @param word The word to look for.
+ * @return The slot holding the word, or the empty slot where it would be inserted.
+ */
+static size_t find_word_slot(const Dictionary* dictionary, const char* word) {
+    size_t slot = hash_word(word) & dictionary -> set_mask;
+
+    while (dictionary -> word_set[slot] != -1 && strcmp(dictionary -> words[dictionary -> word_set[slot]], word) != 0)
+        slot = (slot + 1) & dictionary -> set_mask;
+
+    return slot;
+}
+
+/**
+ * @brief Lays the words of each bucket out by blocks for `edit_distance_batch`.
+ *
+ * The blocks of a bucket are padded to a whole number of lanes, so every block
+ * row is `EDIT_DISTANCE_BATCH_LANES` bytes long and stays aligned on that size.
+ *
+ * @param dictionary Pointer to the dictionary, whose buckets are built.
+ * @return 1 on success, 0 if an error occurs during memory allocation.
+ */
+static int interleave_words(DictionaryPtr dictionary) {
+    const size_t lanes = EDIT_DISTANCE_BATCH_LANES;
+    size_t size = 0;
+
+    dictionary -> interleaved_start = malloc((dictionary -> max_length + 1) * sizeof(size_t));
+    if (dictionary -> interleaved_start == NULL)
+        return 0;
+
+    for (int length = 0; length <= dictionary -> max_length; length++) {
+        size_t n_words = dictionary -> bucket_start[length + 1] - dictionary -> bucket_start[length];
+        size_t n_blocks = (n_words + lanes - 1) / lanes;
+
+        dictionary -> interleaved_start[length] = size;
+        size += n_blocks * lanes * length;
+    }
+
+    // The size of a block row is a multiple of the alignment, as aligned_alloc requires
+    dictionary -> interleaved = aligned_alloc(lanes, size > 0 ? size : lanes);
+    if (dictionary -> interleaved == NULL)
+        return 0;
+
+    memset(dictionary -> interleaved, 0, size);
+
+    for (int length = 1; length <= dictionary -> max_length; length++) {
+        unsigned char* blocks = dictionary -> interleaved + dictionary -> interleaved_start[length];
+
+        for (int i = dictionary -> bucket_start[length]; i < dictionary -> bucket_start[length + 1]; i++) {
+            size_t position = i - dictionary -> bucket_start[length];
+            unsigned char* block = blocks + (position / lanes) * lanes * length;
+            const char* word = dictionary -> words[dictionary -> by_length[i]];
+
+            for (int j = 0; j < length; j++)
+                block[j * lanes + position % lanes] = (unsigned char)word[j];
+        }
+    }
+
+    return 1;
+}
+
+int load_dictionary(FILE* dictionary_fp, DictionaryPtr dictionary) {
+    if (dictionary == NULL)
+        return -1;
+
+    memset(dictionary, 0, sizeof(Dictionary));
+
+    dictionary -> n_words = read_dictionary(dictionary_fp, &dictionary -> words);
+    if (dictionary -> n_words < 1)
+        return -1;
+
+    for (int i = 0; i < dictionary -> n_words; i++) {
+        int length = (int)strlen(dictionary -> words[i]);
+        if (length > dictionary -> max_length)
+            dictionary -> max_length = length;
+    }
+
+    dictionary -> bucket_start = calloc(dictionary -> max_length + 2, sizeof(int));
+    dictionary -> by_length = malloc(dictionary -> n_words * sizeof(int));
+    if (dictionary -> bucket_start == NULL || dictionary -> by_length == NULL) {
+        free_dictionary(dictionary);
+        return -1;
+    }
+
+    // Counting sort on the lengths, which keeps the file order within a bucket
+    for (int i = 0; i < dictionary -> n_words; i++)
+        dictionary -> bucket_start[strlen(dictionary -> words[i]) + 1]++;
+
+    for (int length = 1; length <= dictionary -> max_length + 1; length++)
+        dictionary -> bucket_start[length] += dictionary -> bucket_start[length - 1];
+
+    for (int i = 0; i < dictionary -> n_words; i++)
+        dictionary -> by_length[dictionary -> bucket_start[strlen(dictionary -> words[i])]++] = i;
+
+    // Filling the buckets moved each start to the next one
+    for (int length = dictionary -> max_length + 1; length > 0; length--)
+        dictionary -> bucket_start[length] = dictionary -> bucket_start[length - 1];
+
+    dictionary -> bucket_start[0] = 0;
+
+    // At most half of the slots of the set are used
+    size_t n_slots = 2;
+    while (n_slots < 2 * (size_t)dictionary -> n_words)
+        n_slots *= 2;
+
+    dictionary -> set_mask = n_slots - 1;
+    dictionary -> word_set = malloc(n_slots * sizeof(int));
+    if (dictionary -> word_set == NULL) {
+        free_dictionary(dictionary);
+        return -1;
+    }
+
+    memset(dictionary -> word_set, -1, n_slots * sizeof(int));
+
+    // A duplicated word keeps the slot of its first occurrence
+    for (int i = 0; i < dictionary -> n_words; i++) {
+        size_t slot = find_word_slot(dictionary, dictionary -> words[i]);
+
+        if (dictionary -> word_set[slot] == -1)
+            dictionary -> word_set[slot] = i;
+    }
+
+    if (!interleave_words(dictionary)) {
+        free_dictionary(dictionary);
+        return -1;
+    }
+
+    return dictionary -> n_words;
+}
+
+int dictionary_lookup(const Dictionary* dictionary, const char* word) {
+    if (dictionary == NULL || dictionary -> word_set == NULL || word == NULL)
+        return -1;
+
+    return dictionary -> word_set[find_word_slot(dictionary, word)];
+}
+
+void free_dictionary(DictionaryPtr dictionary) {
+    if (dictionary == NULL)
+        return;
+
+    // The arrays of an image live in it
+    if (dictionary -> image != NULL) {
+        free_dictionary_image(dictionary);
+        return;
+    }
+
+    free_matrix(dictionary -> words, dictionary -> n_words);
+    free(dictionary -> bucket_start);
+    free(dictionary -> by_length);
+    free(dictionary -> word_set);
+    free(dictionary -> interleaved);
+    free(dictionary -> interleaved_start);
+
+    memset(dictionary, 0, sizeof(Dictionary));
+}
+
 int read_to_correct(FILE* to_correct_fp, char*** to_correct) {
     if (to_correct_fp == NULL || to_correct == NULL)
         return -1;
@@ -149,4 +331,31 @@ int read_to_correct(FILE* to_correct_fp, char*** to_correct) {
     }
 
     return words_read;
-}
\ No newline at end of file
+}
+// Delimiters of the words of a text to correct, those of `read_to_correct`
+static int is_delimiter(int c) {
+    return c == '\0' || strchr(" \t\n,.!?;:\"()[]{}<>-", c) != NULL;
+}
+
+int read_word(FILE* text_fp, char* word, size_t size) {
+    if (text_fp == NULL || word == NULL || size < 2)
+        return -1;
+
+    int c = getc(text_fp);
+    while (c != EOF && is_delimiter(c))
+        c = getc(text_fp);
+
+    size_t length = 0;
+    while (c != EOF && !is_delimiter(c)) {
+        word[length++] = (c >= 'A' && c <= 'Z') ? c + 'a' - 'A' : c;
+
+        if (length == size - 1)
+            break;
+
+        c = getc(text_fp);
+    }
+
+    word[length] = '\0';
+
+    return ferror(text_fp) ? -1 : (int)length;
+}
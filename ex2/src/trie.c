@@ -0,0 +1,246 @@
+/**
+ * @file trie.c
+ * @brief Implementation of the trie over the words of a dictionary.
+ */
+
+#include "trie.h"
+#include <string.h>
+#include <limits.h>
+
+
+/**
+ * @brief Word of the dictionary, sorted with the others to lay out the trie.
+ */
+typedef struct _TrieEntry {
+    const char* word;
+    int index;
+
+} TrieEntry;
+
+/**
+ * @brief State of a search: the word looked for, the rows of the levels and the best word found so far.
+ */
+typedef struct _TrieSearch {
+    const Trie* trie;
+    const char* word;
+    int length;          ///< Length of the word looked for.
+    int* rows;           ///< Row of the table of each level of the current path, `length + 1` entries each.
+    int best_distance;
+    int best_index;
+
+} TrieSearch;
+
+// Lexicographic order, duplicated words in dictionary order
+static int compare_entries(const void* a, const void* b) {
+    const TrieEntry* x = a;
+    const TrieEntry* y = b;
+
+    int order = strcmp(x -> word, y -> word);
+    if (order != 0)
+        return order;
+
+    return (x -> index > y -> index) - (x -> index < y -> index);
+}
+
+/**
+ * The words are sorted, so that the words below a node form a contiguous
+ * range of the sorted array. The nodes are then laid out breadth-first: the
+ * queue of the visit is the final order of the nodes, each node remembers its
+ * range and depth, and its children are the runs of words sharing the same
+ * character at that depth. The first index below a node is propagated from
+ * the last node upwards, children coming after their parent.
+ */
+int trie_build(TriePtr trie, char** dictionary, int words_in_dictionary) {
+    if (trie == NULL || dictionary == NULL || words_in_dictionary < 1)
+        return -1;
+
+    memset(trie, 0, sizeof(Trie));
+
+    // The root, plus at most one node per character of the dictionary
+    size_t max_nodes = 1;
+    for (int i = 0; i < words_in_dictionary; i++)
+        max_nodes += strlen(dictionary[i]);
+
+    if (max_nodes > INT_MAX)
+        return -1;
+
+    TrieEntry* entries = malloc(words_in_dictionary * sizeof(TrieEntry));
+    int* range_start = malloc(max_nodes * sizeof(int));
+    int* range_end = malloc(max_nodes * sizeof(int));
+    int* depth = malloc(max_nodes * sizeof(int));
+
+    trie -> label = malloc(max_nodes * sizeof(char));
+    trie -> word_index = malloc(max_nodes * sizeof(int));
+    trie -> min_index = malloc(max_nodes * sizeof(int));
+    trie -> first_child = malloc(max_nodes * sizeof(int));
+    trie -> n_children = malloc(max_nodes * sizeof(int));
+
+    if (!entries || !range_start || !range_end || !depth || !trie -> label || !trie -> word_index ||
+        !trie -> min_index || !trie -> first_child || !trie -> n_children) {
+        free(entries);
+        free(range_start);
+        free(range_end);
+        free(depth);
+        trie_free(trie);
+
+        return -1;
+    }
+
+    for (int i = 0; i < words_in_dictionary; i++) {
+        entries[i].word = dictionary[i];
+        entries[i].index = i;
+    }
+
+    qsort(entries, words_in_dictionary, sizeof(TrieEntry), compare_entries);
+
+    trie -> dictionary = dictionary;
+    trie -> label[0] = '\0';
+    range_start[0] = 0;
+    range_end[0] = words_in_dictionary;
+    depth[0] = 0;
+
+    int n_queued = 1;
+    for (int node = 0; node < n_queued; node++) {
+        int start = range_start[node];
+        int end = range_end[node];
+        int d = depth[node];
+
+        if (d > trie -> max_depth)
+            trie -> max_depth = d;
+
+        // The words ending at this node sort first, the earliest one in the dictionary leading
+        trie -> word_index[node] = start < end && entries[start].word[d] == '\0' ? entries[start].index : -1;
+        while (start < end && entries[start].word[d] == '\0')
+            start++;
+
+        trie -> first_child[node] = n_queued;
+
+        while (start < end) {
+            char c = entries[start].word[d];
+            int run_end = start + 1;
+            while (run_end < end && entries[run_end].word[d] == c)
+                run_end++;
+
+            trie -> label[n_queued] = c;
+            range_start[n_queued] = start;
+            range_end[n_queued] = run_end;
+            depth[n_queued] = d + 1;
+            n_queued++;
+
+            start = run_end;
+        }
+
+        trie -> n_children[node] = n_queued - trie -> first_child[node];
+    }
+
+    trie -> n_nodes = n_queued;
+
+    for (int node = trie -> n_nodes - 1; node >= 0; node--) {
+        int min_index = trie -> word_index[node] == -1 ? INT_MAX : trie -> word_index[node];
+
+        for (int child = trie -> first_child[node]; child < trie -> first_child[node] + trie -> n_children[node]; child++)
+            if (trie -> min_index[child] < min_index)
+                min_index = trie -> min_index[child];
+
+        trie -> min_index[node] = min_index;
+    }
+
+    free(entries);
+    free(range_start);
+    free(range_end);
+    free(depth);
+
+    return trie -> n_nodes;
+}
+
+void trie_free(TriePtr trie) {
+    if (trie == NULL)
+        return;
+
+    free(trie -> label);
+    free(trie -> word_index);
+    free(trie -> min_index);
+    free(trie -> first_child);
+    free(trie -> n_children);
+
+    memset(trie, 0, sizeof(Trie));
+}
+
+size_t trie_memory_usage(const Trie* trie) {
+    return trie -> n_nodes * (sizeof(char) + 4 * sizeof(int));
+}
+
+/**
+ * Visits the children of a node whose row is at level `level`. The row of a
+ * child is derived from the one of its parent by appending its character to
+ * the prefix: the cell of the first `i` characters of the word is either the
+ * cell above when the characters match, or one more than the smallest of its
+ * neighbours, as only insertions and deletions are allowed. A child is pruned
+ * when the minimum of its row exceeds the best distance, or equals it while
+ * every word below the child comes after the best one in the dictionary.
+ */
+static void search_children(TrieSearch* search, int node, int level) {
+    const Trie* trie = search -> trie;
+    const int* row = search -> rows + (size_t)level * (search -> length + 1);
+    int* child_row = search -> rows + (size_t)(level + 1) * (search -> length + 1);
+
+    for (int child = trie -> first_child[node]; child < trie -> first_child[node] + trie -> n_children[node]; child++) {
+        char c = trie -> label[child];
+        int row_min = child_row[0] = row[0] + 1;
+
+        for (int i = 1; i <= search -> length; i++) {
+            int left = child_row[i - 1] < row[i] ? child_row[i - 1] : row[i];
+            child_row[i] = search -> word[i - 1] == c ? row[i - 1] : left + 1;
+
+            if (child_row[i] < row_min)
+                row_min = child_row[i];
+        }
+
+        if (row_min > search -> best_distance ||
+            (row_min == search -> best_distance && trie -> min_index[child] > search -> best_index))
+            continue;
+
+        int index = trie -> word_index[child];
+        int distance = child_row[search -> length];
+
+        if (index != -1 && (distance < search -> best_distance || (distance == search -> best_distance && index < search -> best_index))) {
+            search -> best_distance = distance;
+            search -> best_index = index;
+        }
+
+        search_children(search, child, level + 1);
+    }
+}
+
+int trie_find_closest(const Trie* trie, const char* word, const char** closest_word, int* min_distance) {
+    if (trie == NULL || trie -> n_nodes < 1 || word == NULL)
+        return -1;
+
+    int length = (int)strlen(word);
+    TrieSearch search = { trie, word, length, NULL, INT_MAX, INT_MAX };
+
+    search.rows = malloc((size_t)(trie -> max_depth + 1) * (length + 1) * sizeof(int));
+    if (search.rows == NULL)
+        return -1;
+
+    for (int i = 0; i <= length; i++)
+        search.rows[i] = i;
+
+    // The empty word, at the root
+    if (trie -> word_index[0] != -1) {
+        search.best_distance = length;
+        search.best_index = trie -> word_index[0];
+    }
+
+    search_children(&search, 0, 0);
+
+    free(search.rows);
+
+    if (closest_word != NULL)
+        *closest_word = trie -> dictionary[search.best_index];
+
+    if (min_distance != NULL)
+        *min_distance = search.best_distance;
+
+    return search.best_index;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file test_bk_tree.c
+ * @brief Unit tests' implementation for the BK-tree index of a dictionary.
+ *
+ * This file contains the implementation of the unit tests for the BK-tree built over a dictionary.
+ */
+
+#include "test_bk_tree.h"
+#include "edit_distance.h"
+#include "test_utils.h"
+#include <stdlib.h>
+
+
+#define N_RANDOM_WORDS 2000
+#define RANDOM_WORD_LENGTH 10
+
+/**
+ * @brief Test the construction of a BK-tree.
+ *
+ * This test verifies that every word of the dictionary gets a node, that the children of each node
+ * are sorted by their distance from it, and that an empty dictionary is rejected.
+ */
+void test_bk_tree_build(void) {
+    char* dictionary[] = { "book", "books", "cake", "boo", "boon", "cook", "cape", "cart" };
+    int n_words = sizeof(dictionary) / sizeof(dictionary[0]);
+    BkTree tree;
+
+    TEST_ASSERT_EQUAL_INT(n_words, bk_tree_build(&tree, dictionary, n_words));
+    TEST_ASSERT_EQUAL_INT(0, tree.word_index[0]);
+    TEST_ASSERT_EQUAL_size_t(4 * n_words * sizeof(int), bk_tree_memory_usage(&tree));
+
+    int* seen = calloc(n_words, sizeof(int));
+    TEST_ASSERT_NOT_NULL(seen);
+
+    for (int node = 0; node < tree.n_nodes; node++) {
+        seen[tree.word_index[node]]++;
+
+        for (int child = tree.first_child[node]; child < tree.first_child[node] + tree.n_children[node]; child++) {
+            TEST_ASSERT_EQUAL_INT(
+                edit_distance_dyn(dictionary[tree.word_index[node]], dictionary[tree.word_index[child]]),
+                tree.edge[child]
+            );
+
+            if (child > tree.first_child[node])
+                TEST_ASSERT_TRUE(tree.edge[child - 1] < tree.edge[child]);
+        }
+    }
+
+    for (int i = 0; i < n_words; i++)
+        TEST_ASSERT_EQUAL_INT(1, seen[i]);
+
+    free(seen);
+    bk_tree_free(&tree);
+
+    TEST_ASSERT_EQUAL_INT(-1, bk_tree_build(&tree, dictionary, 0));
+}
+
+/**
+ * @brief Test that the closest word found with a BK-tree is the one of a linear scan.
+ *
+ * This test verifies, on a dictionary with duplicated words and several words at the same distance,
+ * that the BK-tree returns the first of the closest words in dictionary order.
+ */
+void test_bk_tree_find_closest(void) {
+    char** dictionary = create_random_words(N_RANDOM_WORDS, 1, RANDOM_WORD_LENGTH, 5, 42);
+    char** queries = create_random_words(200, 1, RANDOM_WORD_LENGTH, 5, 7);
+    BkTree tree;
+
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, bk_tree_build(&tree, dictionary, N_RANDOM_WORDS));
+
+    for (int q = 0; q < 200; q++) {
+        int expected_distance;
+        int expected_index = linear_scan_closest(queries[q], dictionary, N_RANDOM_WORDS, &expected_distance);
+
+        const char* closest_word = NULL;
+        int min_distance = -1;
+
+        TEST_ASSERT_EQUAL_INT(expected_index, bk_tree_find_closest(&tree, queries[q], &closest_word, &min_distance));
+        TEST_ASSERT_EQUAL_INT(expected_distance, min_distance);
+        TEST_ASSERT_EQUAL_PTR(dictionary[expected_index], closest_word);
+    }
+
+    bk_tree_free(&tree);
+    free_random_words(queries, 200);
+    free_random_words(dictionary, N_RANDOM_WORDS);
+}
+
+/**
+ * @brief Test the search of all the words within a given distance with a BK-tree.
+ *
+ * This test verifies that the BK-tree returns exactly the words of the dictionary within the distance,
+ * in dictionary order.
+ */
+void test_bk_tree_find_within(void) {
+    char** dictionary = create_random_words(N_RANDOM_WORDS, 1, RANDOM_WORD_LENGTH, 5, 42);
+    BkTree tree;
+
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, bk_tree_build(&tree, dictionary, N_RANDOM_WORDS));
+
+    const char* queries[] = { "abcde", "aa", "eeeeeeee", "bad" };
+    for (int q = 0; q < 4; q++) {
+        for (int k = 0; k <= 3; k++) {
+            int* matches;
+            int n_matches = bk_tree_find_within(&tree, queries[q], k, &matches);
+            int n_expected = 0;
+
+            for (int i = 0; i < N_RANDOM_WORDS; i++) {
+                if (edit_distance_dyn(queries[q], dictionary[i]) <= k) {
+                    TEST_ASSERT_TRUE(n_expected < n_matches);
+                    TEST_ASSERT_EQUAL_INT(i, matches[n_expected++]);
+                }
+            }
+
+            TEST_ASSERT_EQUAL_INT(n_expected, n_matches);
+            free(matches);
+        }
+    }
+
+    bk_tree_free(&tree);
+    free_random_words(dictionary, N_RANDOM_WORDS);
+}
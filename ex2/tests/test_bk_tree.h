@@ -0,0 +1,39 @@
+/**
+ * @file test_bk_tree.h
+ * @brief Unit tests' interface for the BK-tree index of a dictionary.
+ * 
+ * This file contains the declarations of the unit tests for the BK-tree built over a dictionary.
+ */
+
+#ifndef _TEST_BK_TREE_H
+#define _TEST_BK_TREE_H
+
+#include "unity.h"
+#include "bk_tree.h"
+
+
+/**
+ * @brief Test the construction of a BK-tree.
+ * 
+ * This test verifies that every word of the dictionary gets a node, that the children of each node
+ * are sorted by their distance from it, and that an empty dictionary is rejected.
+ */
+void test_bk_tree_build(void);
+
+/**
+ * @brief Test that the closest word found with a BK-tree is the one of a linear scan.
+ * 
+ * This test verifies, on a dictionary with duplicated words and several words at the same distance,
+ * that the BK-tree returns the first of the closest words in dictionary order.
+ */
+void test_bk_tree_find_closest(void);
+
+/**
+ * @brief Test the search of all the words within a given distance with a BK-tree.
+ * 
+ * This test verifies that the BK-tree returns exactly the words of the dictionary within the distance,
+ * in dictionary order.
+ */
+void test_bk_tree_find_within(void);
+
+#endif  // _TEST_BK_TREE_H
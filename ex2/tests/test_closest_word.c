@@ -0,0 +1,156 @@
+/**
+ * @file test_closest_word.c
+ * @brief Unit tests' implementation for the search of the closest word in a dictionary grouped by length.
+ *
+ * This file contains the implementation of the unit tests for `find_closest_word` and `find_closest_words`.
+ */
+
+#include "test_closest_word.h"
+#include "edit_distance.h"
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define N_RANDOM_WORDS 2000
+#define N_RANDOM_QUERIES 300
+#define RANDOM_WORD_LENGTH 12
+#define N_SUGGESTIONS 5
+
+/**
+ * @brief Test the ties between the words found by the search of the closest word.
+ *
+ * This test verifies that, among words at the same distance but of different lengths, the first one in the file is
+ * returned, and that an exact match is preferred to any other word.
+ */
+void test_find_closest_word_ties(void) {
+    const char* words[] = { "carts", "cat", "care", "car", "cart" };
+    Dictionary dictionary;
+    const char* closest_word;
+    int min_distance;
+
+    load_test_dictionary(&dictionary, words, 5);
+
+    // "carts" (longer, first in the file) and "car" (shorter) are both at distance 1 from "cars"
+    TEST_ASSERT_EQUAL_INT(0, find_closest_word("cars", &dictionary, &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_STRING("carts", closest_word);
+    TEST_ASSERT_EQUAL_INT(1, min_distance);
+
+    TEST_ASSERT_EQUAL_INT(3, find_closest_word("car", &dictionary, &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_INT(0, min_distance);
+
+    TEST_ASSERT_EQUAL_INT(1, find_closest_word("ct", &dictionary, &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_INT(1, min_distance);
+
+    TEST_ASSERT_EQUAL_INT(-1, find_closest_word(NULL, &dictionary, &closest_word, &min_distance));
+
+    free_dictionary(&dictionary);
+}
+
+/**
+ * @brief Test that the search by length buckets finds the closest word of a linear scan.
+ *
+ * This test verifies, on pseudo-random words, that the closest word and its distance are the ones of a linear scan
+ * of the dictionary in file order.
+ */
+void test_find_closest_word(void) {
+    static char words[N_RANDOM_WORDS][RANDOM_WORD_LENGTH + 1];
+    const char* word_list[N_RANDOM_WORDS];
+    unsigned seed = 42;
+    Dictionary dictionary;
+
+    for (int i = 0; i < N_RANDOM_WORDS; i++) {
+        random_word(words[i], 1, RANDOM_WORD_LENGTH, 6, &seed);
+        word_list[i] = words[i];
+    }
+
+    load_test_dictionary(&dictionary, word_list, N_RANDOM_WORDS);
+
+    for (int q = 0; q < N_RANDOM_QUERIES; q++) {
+        char query[RANDOM_WORD_LENGTH + 1];
+        random_word(query, 1, RANDOM_WORD_LENGTH, 6, &seed);
+
+        int expected_distance;
+        int expected_index = linear_scan_closest(query, dictionary.words, dictionary.n_words, &expected_distance);
+
+        const char* closest_word;
+        int min_distance;
+
+        TEST_ASSERT_EQUAL_INT(expected_index, find_closest_word(query, &dictionary, &closest_word, &min_distance));
+        TEST_ASSERT_EQUAL_INT(expected_distance, min_distance);
+        TEST_ASSERT_EQUAL_STRING(words[expected_index], closest_word);
+    }
+
+    free_dictionary(&dictionary);
+}
+
+/**
+ * @brief Test that the top-k search finds the k closest words of a linear scan.
+ *
+ * This test verifies, on pseudo-random words, that the suggestions are the first words of the dictionary sorted by
+ * distance then file order, that the first one is the closest word, and that `k` is capped by the number of words.
+ */
+void test_find_closest_words(void) {
+    static char words[N_RANDOM_WORDS][RANDOM_WORD_LENGTH + 1];
+    const char* word_list[N_RANDOM_WORDS];
+    unsigned seed = 7;
+    Dictionary dictionary;
+
+    for (int i = 0; i < N_RANDOM_WORDS; i++) {
+        random_word(words[i], 1, RANDOM_WORD_LENGTH, 6, &seed);
+        word_list[i] = words[i];
+    }
+
+    load_test_dictionary(&dictionary, word_list, N_RANDOM_WORDS);
+
+    for (int q = 0; q < N_RANDOM_QUERIES; q++) {
+        char query[RANDOM_WORD_LENGTH + 1];
+        random_word(query, 1, RANDOM_WORD_LENGTH, 6, &seed);
+
+        Suggestion suggestions[N_SUGGESTIONS];
+        TEST_ASSERT_EQUAL_INT(N_SUGGESTIONS, find_closest_words(query, &dictionary, N_SUGGESTIONS, suggestions));
+
+        // Selects the expected suggestions one at a time, each the first word after the previous one in (distance, index) order
+        int previous_distance = -1, previous_index = -1;
+
+        for (int s = 0; s < N_SUGGESTIONS; s++) {
+            int expected_index = -1, expected_distance = 0;
+
+            for (int i = 0; i < N_RANDOM_WORDS; i++) {
+                int distance = edit_distance_dyn(query, words[i]);
+
+                if (distance < previous_distance || (distance == previous_distance && i <= previous_index))
+                    continue;
+
+                if (expected_index == -1 || distance < expected_distance) {
+                    expected_distance = distance;
+                    expected_index = i;
+                }
+            }
+
+            TEST_ASSERT_EQUAL_INT(expected_index, suggestions[s].index);
+            TEST_ASSERT_EQUAL_INT(expected_distance, suggestions[s].distance);
+            TEST_ASSERT_EQUAL_STRING(words[expected_index], suggestions[s].word);
+
+            previous_distance = expected_distance;
+            previous_index = expected_index;
+        }
+
+        const char* closest_word;
+        int min_distance;
+        TEST_ASSERT_EQUAL_INT(suggestions[0].index, find_closest_word(query, &dictionary, &closest_word, &min_distance));
+    }
+
+    free_dictionary(&dictionary);
+
+    const char* small_words[] = { "cat", "dog", "bird" };
+    Suggestion suggestions[N_SUGGESTIONS];
+
+    load_test_dictionary(&dictionary, small_words, 3);
+
+    TEST_ASSERT_EQUAL_INT(3, find_closest_words("cart", &dictionary, N_SUGGESTIONS, suggestions));
+    TEST_ASSERT_EQUAL_STRING("cat", suggestions[0].word);
+    TEST_ASSERT_EQUAL_INT(-1, find_closest_words("cart", &dictionary, 0, suggestions));
+
+    free_dictionary(&dictionary);
+}
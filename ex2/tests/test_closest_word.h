@@ -0,0 +1,39 @@
+/**
+ * @file test_closest_word.h
+ * @brief Unit tests' interface for the search of the closest word in a dictionary grouped by length.
+ * 
+ * This file contains the declarations of the unit tests for `find_closest_word` and `find_closest_words`.
+ */
+
+#ifndef _TEST_CLOSEST_WORD_H
+#define _TEST_CLOSEST_WORD_H
+
+#include "unity.h"
+#include "closest_word.h"
+
+
+/**
+ * @brief Test the ties between the words found by the search of the closest word.
+ * 
+ * This test verifies that, among words at the same distance but of different lengths, the first one in the file is
+ * returned, and that an exact match is preferred to any other word.
+ */
+void test_find_closest_word_ties(void);
+
+/**
+ * @brief Test that the search by length buckets finds the closest word of a linear scan.
+ * 
+ * This test verifies, on pseudo-random words, that the closest word and its distance are the ones of a linear scan
+ * of the dictionary in file order.
+ */
+void test_find_closest_word(void);
+
+/**
+ * @brief Test that the top-k search finds the k closest words of a linear scan.
+ * 
+ * This test verifies, on pseudo-random words, that the suggestions are the first words of the dictionary sorted by
+ * distance then file order, that the first one is the closest word, and that `k` is capped by the number of words.
+ */
+void test_find_closest_words(void);
+
+#endif  // _TEST_CLOSEST_WORD_H
@@ -0,0 +1,90 @@
+/**
+ * @file test_correction_cache.c
+ * @brief Unit tests' implementation for the cache of the corrections of words.
+ *
+ * This file contains the implementation of the unit tests for the bounded cache of the corrections.
+ */
+
+#include "test_correction_cache.h"
+#include <stdio.h>
+
+
+/**
+ * @brief Test the lookups and insertions of a cache.
+ *
+ * This test verifies that a stored word is found with its correction, that storing it again replaces its
+ * correction, that missing words are not found, that the hits and misses are counted, and that a cache
+ * without capacity is rejected.
+ */
+void test_correction_cache_get_put(void) {
+    CorrectionCache cache;
+    int distance = -1;
+
+    TEST_ASSERT_EQUAL_INT(-1, correction_cache_init(&cache, 0));
+    TEST_ASSERT_EQUAL_INT(16, correction_cache_init(&cache, 16));
+
+    TEST_ASSERT_EQUAL_INT(-1, correction_cache_get(&cache, "helo", &distance));
+    TEST_ASSERT_EQUAL_INT(1, correction_cache_put(&cache, "helo", 7, 1));
+    TEST_ASSERT_EQUAL_INT(1, correction_cache_put(&cache, "wrld", 3, 2));
+
+    TEST_ASSERT_EQUAL_INT(7, correction_cache_get(&cache, "helo", &distance));
+    TEST_ASSERT_EQUAL_INT(1, distance);
+    TEST_ASSERT_EQUAL_INT(3, correction_cache_get(&cache, "wrld", &distance));
+    TEST_ASSERT_EQUAL_INT(2, distance);
+    TEST_ASSERT_EQUAL_INT(-1, correction_cache_get(&cache, "hel", &distance));
+
+    TEST_ASSERT_EQUAL_INT(1, correction_cache_put(&cache, "helo", 9, 3));
+    TEST_ASSERT_EQUAL_INT(9, correction_cache_get(&cache, "helo", &distance));
+    TEST_ASSERT_EQUAL_INT(3, distance);
+
+    TEST_ASSERT_EQUAL_INT(2, cache.n_entries);
+    TEST_ASSERT_EQUAL_INT(3, cache.hits);
+    TEST_ASSERT_EQUAL_INT(2, cache.misses);
+
+    TEST_ASSERT_EQUAL_INT(-1, correction_cache_get(&cache, NULL, &distance));
+    TEST_ASSERT_EQUAL_INT(0, correction_cache_put(&cache, NULL, 0, 0));
+
+    correction_cache_free(&cache);
+}
+
+/**
+ * @brief Test the eviction of the least recently used words of a full cache.
+ *
+ * This test verifies that a full cache evicts the word used least recently, a lookup counting as a use,
+ * and that it never holds more words than its capacity.
+ */
+void test_correction_cache_eviction(void) {
+    CorrectionCache cache;
+    char word[16];
+
+    TEST_ASSERT_EQUAL_INT(3, correction_cache_init(&cache, 3));
+
+    correction_cache_put(&cache, "one", 1, 1);
+    correction_cache_put(&cache, "two", 2, 1);
+    correction_cache_put(&cache, "three", 3, 1);
+
+    // "one" becomes the most recently used word, leaving "two" the least recently used one
+    TEST_ASSERT_EQUAL_INT(1, correction_cache_get(&cache, "one", NULL));
+    correction_cache_put(&cache, "four", 4, 1);
+
+    TEST_ASSERT_EQUAL_INT(-1, correction_cache_get(&cache, "two", NULL));
+    TEST_ASSERT_EQUAL_INT(1, correction_cache_get(&cache, "one", NULL));
+    TEST_ASSERT_EQUAL_INT(3, correction_cache_get(&cache, "three", NULL));
+    TEST_ASSERT_EQUAL_INT(4, correction_cache_get(&cache, "four", NULL));
+
+    for (int i = 0; i < 1000; i++) {
+        snprintf(word, sizeof(word), "w%d", i);
+        TEST_ASSERT_EQUAL_INT(1, correction_cache_put(&cache, word, i, 0));
+        TEST_ASSERT_TRUE(cache.n_entries <= 3);
+    }
+
+    for (int i = 997; i < 1000; i++) {
+        snprintf(word, sizeof(word), "w%d", i);
+        TEST_ASSERT_EQUAL_INT(i, correction_cache_get(&cache, word, NULL));
+    }
+
+    TEST_ASSERT_EQUAL_INT(-1, correction_cache_get(&cache, "w996", NULL));
+    TEST_ASSERT_EQUAL_INT(-1, correction_cache_get(&cache, "one", NULL));
+
+    correction_cache_free(&cache);
+}
@@ -0,0 +1,32 @@
+/**
+ * @file test_correction_cache.h
+ * @brief Unit tests' interface for the cache of the corrections of words.
+ * 
+ * This file contains the declarations of the unit tests for the bounded cache of the corrections.
+ */
+
+#ifndef _TEST_CORRECTION_CACHE_H
+#define _TEST_CORRECTION_CACHE_H
+
+#include "unity.h"
+#include "correction_cache.h"
+
+
+/**
+ * @brief Test the lookups and insertions of a cache.
+ * 
+ * This test verifies that a stored word is found with its correction, that storing it again replaces its
+ * correction, that missing words are not found, that the hits and misses are counted, and that a cache
+ * without capacity is rejected.
+ */
+void test_correction_cache_get_put(void);
+
+/**
+ * @brief Test the eviction of the least recently used words of a full cache.
+ * 
+ * This test verifies that a full cache evicts the word used least recently, a lookup counting as a use,
+ * and that it never holds more words than its capacity.
+ */
+void test_correction_cache_eviction(void);
+
+#endif  // _TEST_CORRECTION_CACHE_H
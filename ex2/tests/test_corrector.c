@@ -0,0 +1,162 @@
+/**
+ * @file test_corrector.c
+ * @brief Unit tests' implementation for the correction of words with the search engines.
+ *
+ * This file contains the implementation of the unit tests for `correct_word` and `correct_words`.
+ */
+
+#include "test_corrector.h"
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define N_RANDOM_WORDS 2000
+#define N_RANDOM_QUERIES 500
+#define RANDOM_WORD_LENGTH 12
+
+/* Helper function to load a pseudo-random dictionary and generate the words to correct, to be freed with free_random_words */
+static char** load_random_dictionary(DictionaryPtr dictionary) {
+    char** words = create_random_words(N_RANDOM_WORDS, 1, RANDOM_WORD_LENGTH, 6, 42);
+
+    // The dictionary keeps its own copy of the words
+    load_test_dictionary(dictionary, (const char**)words, N_RANDOM_WORDS);
+    free_random_words(words, N_RANDOM_WORDS);
+
+    return create_random_words(N_RANDOM_QUERIES, 1, RANDOM_WORD_LENGTH, 6, 7);
+}
+
+/**
+ * @brief Test that every engine corrects the words as the scan of the dictionary.
+ *
+ * This test verifies that the BK-tree, the SymSpell index, including its fallback for the words beyond
+ * its radius, the trie and the q-gram index, including its fallback for the short words, return the same
+ * closest word and distance as the scan.
+ */
+void test_correct_word_engines(void) {
+    Dictionary dictionary;
+    char** queries;
+    Corrector scan, bk_tree, symspell, trie, qgram;
+
+    queries = load_random_dictionary(&dictionary);
+
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, corrector_init(&scan, &dictionary, ENGINE_SCAN));
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, corrector_init(&bk_tree, &dictionary, ENGINE_BKTREE));
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, corrector_init(&symspell, &dictionary, ENGINE_SYMSPELL));
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, corrector_init(&trie, &dictionary, ENGINE_TRIE));
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, corrector_init(&qgram, &dictionary, ENGINE_QGRAM));
+
+    int n_beyond_radius = 0;
+
+    for (int q = 0; q < N_RANDOM_QUERIES; q++) {
+        Correction expected, correction;
+
+        int index = correct_word(&scan, queries[q], &expected);
+        TEST_ASSERT_TRUE(index >= 0);
+
+        TEST_ASSERT_EQUAL_INT(index, correct_word(&bk_tree, queries[q], &correction));
+        TEST_ASSERT_EQUAL_PTR(expected.closest_word, correction.closest_word);
+        TEST_ASSERT_EQUAL_INT(expected.distance, correction.distance);
+
+        TEST_ASSERT_EQUAL_INT(index, correct_word(&symspell, queries[q], &correction));
+        TEST_ASSERT_EQUAL_PTR(expected.closest_word, correction.closest_word);
+        TEST_ASSERT_EQUAL_INT(expected.distance, correction.distance);
+
+        TEST_ASSERT_EQUAL_INT(index, correct_word(&trie, queries[q], &correction));
+        TEST_ASSERT_EQUAL_PTR(expected.closest_word, correction.closest_word);
+        TEST_ASSERT_EQUAL_INT(expected.distance, correction.distance);
+
+        TEST_ASSERT_EQUAL_INT(index, correct_word(&qgram, queries[q], &correction));
+        TEST_ASSERT_EQUAL_PTR(expected.closest_word, correction.closest_word);
+        TEST_ASSERT_EQUAL_INT(expected.distance, correction.distance);
+
+        if (expected.distance > SYMSPELL_DEFAULT_MAX_DISTANCE)
+            n_beyond_radius++;
+    }
+
+    // The fallback of the SymSpell engine has been exercised
+    TEST_ASSERT_TRUE(n_beyond_radius > 0);
+
+    corrector_free(&qgram);
+    corrector_free(&trie);
+    corrector_free(&symspell);
+    corrector_free(&bk_tree);
+    corrector_free(&scan);
+    free_random_words(queries, N_RANDOM_QUERIES);
+    free_dictionary(&dictionary);
+}
+
+/**
+ * @brief Test the correction of a batch of words on several threads.
+ *
+ * This test verifies that the corrections computed on several threads are the ones computed on a single
+ * thread, stored in the order of the words.
+ */
+void test_correct_words_parallel(void) {
+    Dictionary dictionary;
+    char** queries;
+    Corrector corrector;
+    static Correction sequential[N_RANDOM_QUERIES];
+    static Correction parallel[N_RANDOM_QUERIES];
+
+    queries = load_random_dictionary(&dictionary);
+
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, corrector_init(&corrector, &dictionary, ENGINE_SCAN));
+
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_QUERIES, correct_words(&corrector, queries, N_RANDOM_QUERIES, 1, sequential));
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_QUERIES, correct_words(&corrector, queries, N_RANDOM_QUERIES, 7, parallel));
+
+    for (int q = 0; q < N_RANDOM_QUERIES; q++) {
+        TEST_ASSERT_EQUAL_PTR(sequential[q].closest_word, parallel[q].closest_word);
+        TEST_ASSERT_EQUAL_INT(sequential[q].distance, parallel[q].distance);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, correct_words(&corrector, queries, 0, 4, parallel));
+    TEST_ASSERT_EQUAL_INT(-1, correct_words(&corrector, NULL, N_RANDOM_QUERIES, 4, parallel));
+
+    corrector_free(&corrector);
+    free_random_words(queries, N_RANDOM_QUERIES);
+    free_dictionary(&dictionary);
+}
+
+/**
+ * @brief Test the correction of repeated words through a cache smaller than the vocabulary.
+ *
+ * This test verifies that the corrections computed on several threads with a cache, whose words keep being
+ * evicted, are the ones computed without a cache, and that the repeated words hit the cache.
+ */
+void test_correct_words_cache(void) {
+    Dictionary dictionary;
+    char** queries;
+    char* repeated[4 * N_RANDOM_QUERIES];
+    Corrector corrector;
+    static Correction expected[N_RANDOM_QUERIES];
+    static Correction cached[4 * N_RANDOM_QUERIES];
+
+    queries = load_random_dictionary(&dictionary);
+
+    // The same words, over and over, in a different order each time
+    for (int i = 0; i < 4 * N_RANDOM_QUERIES; i++)
+        repeated[i] = queries[(i * 7 + i / N_RANDOM_QUERIES) % N_RANDOM_QUERIES];
+
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, corrector_init(&corrector, &dictionary, ENGINE_SCAN));
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_QUERIES, correct_words(&corrector, queries, N_RANDOM_QUERIES, 1, expected));
+
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_QUERIES / 4, corrector_enable_cache(&corrector, N_RANDOM_QUERIES / 4));
+    TEST_ASSERT_EQUAL_INT(-1, corrector_enable_cache(&corrector, N_RANDOM_QUERIES / 4));
+    TEST_ASSERT_EQUAL_INT(4 * N_RANDOM_QUERIES, correct_words(&corrector, repeated, 4 * N_RANDOM_QUERIES, 3, cached));
+
+    for (int i = 0; i < 4 * N_RANDOM_QUERIES; i++) {
+        int q = (i * 7 + i / N_RANDOM_QUERIES) % N_RANDOM_QUERIES;
+
+        TEST_ASSERT_EQUAL_PTR(expected[q].closest_word, cached[i].closest_word);
+        TEST_ASSERT_EQUAL_INT(expected[q].distance, cached[i].distance);
+    }
+
+    TEST_ASSERT_TRUE(corrector.cache -> hits > 0);
+    TEST_ASSERT_TRUE(corrector.cache -> n_entries <= N_RANDOM_QUERIES / 4);
+
+    corrector_free(&corrector);
+    free_random_words(queries, N_RANDOM_QUERIES);
+    free_dictionary(&dictionary);
+}
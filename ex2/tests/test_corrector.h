@@ -0,0 +1,40 @@
+/**
+ * @file test_corrector.h
+ * @brief Unit tests' interface for the correction of words with the search engines.
+ * 
+ * This file contains the declarations of the unit tests for `correct_word` and `correct_words`.
+ */
+
+#ifndef _TEST_CORRECTOR_H
+#define _TEST_CORRECTOR_H
+
+#include "unity.h"
+#include "corrector.h"
+
+
+/**
+ * @brief Test that every engine corrects the words as the scan of the dictionary.
+ * 
+ * This test verifies that the BK-tree, the SymSpell index, including its fallback for the words beyond
+ * its radius, the trie and the q-gram index, including its fallback for the short words, return the same
+ * closest word and distance as the scan.
+ */
+void test_correct_word_engines(void);
+
+/**
+ * @brief Test the correction of a batch of words on several threads.
+ * 
+ * This test verifies that the corrections computed on several threads are the ones computed on a single
+ * thread, stored in the order of the words.
+ */
+void test_correct_words_parallel(void);
+
+/**
+ * @brief Test the correction of repeated words through a cache smaller than the vocabulary.
+ * 
+ * This test verifies that the corrections computed on several threads with a cache, whose words keep being
+ * evicted, are the ones computed without a cache, and that the repeated words hit the cache.
+ */
+void test_correct_words_cache(void);
+
+#endif  // _TEST_CORRECTOR_H
@@ -0,0 +1,152 @@
+/**
+ * @file test_dictionary_image.c
+ * @brief Unit tests' implementation for the binary images of dictionaries.
+ *
+ * This file contains the implementation of the unit tests for the compilation and loading of dictionary images.
+ */
+
+#include "test_dictionary_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+#define N_RANDOM_WORDS 1000
+#define RANDOM_WORD_LENGTH 12
+
+/* Helper function to load a pseudo-random dictionary, with duplicated words, through a temporary file */
+static void load_random_dictionary(DictionaryPtr dictionary) {
+    unsigned seed = 42;
+    char word[RANDOM_WORD_LENGTH + 1];
+    FILE* file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+
+    for (int i = 0; i < N_RANDOM_WORDS; i++) {
+        seed = seed * 1103515245 + 12345;
+        int length = 1 + (seed >> 16) % RANDOM_WORD_LENGTH;
+
+        for (int j = 0; j < length; j++) {
+            seed = seed * 1103515245 + 12345;
+            word[j] = 'a' + (seed >> 16) % 4;
+        }
+        word[length] = '\0';
+
+        fprintf(file, "%s\n", word);
+    }
+
+    rewind(file);
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, load_dictionary(file, dictionary));
+    fclose(file);
+}
+
+/* Helper function to compile a dictionary into a temporary file, left at its beginning */
+static FILE* compile_image(const Dictionary* dictionary, long* image_size) {
+    FILE* image_fp = tmpfile();
+    TEST_ASSERT_NOT_NULL(image_fp);
+
+    *image_size = save_dictionary_image(dictionary, image_fp);
+    TEST_ASSERT_TRUE(*image_size > 0);
+    TEST_ASSERT_EQUAL_INT(*image_size, ftell(image_fp));
+
+    rewind(image_fp);
+
+    return image_fp;
+}
+
+/* Helper function to copy the first bytes of an image into a temporary file, left at its beginning */
+static FILE* copy_image(FILE* image_fp, long size) {
+    FILE* copy_fp = tmpfile();
+    TEST_ASSERT_NOT_NULL(copy_fp);
+
+    rewind(image_fp);
+    for (long i = 0; i < size; i++)
+        fputc(fgetc(image_fp), copy_fp);
+
+    rewind(copy_fp);
+
+    return copy_fp;
+}
+
+/**
+ * @brief Test that a dictionary loaded from its image is the one it was compiled from.
+ *
+ * This test verifies that the image is recognized, and that the words, the buckets, the hash set and the
+ * interleaved blocks loaded from it are the ones of the text dictionary.
+ */
+void test_dictionary_image_round_trip(void) {
+    Dictionary text, image;
+    long image_size;
+
+    load_random_dictionary(&text);
+    FILE* image_fp = compile_image(&text, &image_size);
+
+    TEST_ASSERT_EQUAL_INT(1, is_dictionary_image(image_fp));
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, load_dictionary_image(image_fp, &image));
+    TEST_ASSERT_NOT_NULL(image.image);
+    TEST_ASSERT_EQUAL_INT(0, (uintptr_t)image.interleaved % EDIT_DISTANCE_BATCH_LANES);
+
+    TEST_ASSERT_EQUAL_INT(text.max_length, image.max_length);
+    TEST_ASSERT_EQUAL_INT_ARRAY(text.bucket_start, image.bucket_start, text.max_length + 2);
+    TEST_ASSERT_EQUAL_INT_ARRAY(text.by_length, image.by_length, N_RANDOM_WORDS);
+
+    for (int i = 0; i < N_RANDOM_WORDS; i++) {
+        TEST_ASSERT_EQUAL_STRING(text.words[i], image.words[i]);
+        TEST_ASSERT_EQUAL_INT(dictionary_lookup(&text, text.words[i]), dictionary_lookup(&image, text.words[i]));
+    }
+
+    TEST_ASSERT_EQUAL_INT(-1, dictionary_lookup(&image, "abcdefghijklm"));
+
+    for (int length = 0; length <= text.max_length; length++)
+        TEST_ASSERT_EQUAL_INT(text.interleaved_start[length], image.interleaved_start[length]);
+
+    size_t blocks_size = text.interleaved_start[text.max_length] + text.max_length * EDIT_DISTANCE_BATCH_LANES;
+    TEST_ASSERT_EQUAL_MEMORY(text.interleaved, image.interleaved, blocks_size);
+
+    free_dictionary(&image);
+    TEST_ASSERT_NULL(image.image);
+
+    fclose(image_fp);
+    free_dictionary(&text);
+}
+
+/**
+ * @brief Test that invalid images are rejected.
+ *
+ * This test verifies that a text dictionary is not taken for an image, and that truncated images and images
+ * with a damaged header are rejected.
+ */
+void test_dictionary_image_invalid(void) {
+    Dictionary text, image;
+    long image_size;
+
+    FILE* text_fp = tmpfile();
+    TEST_ASSERT_NOT_NULL(text_fp);
+    fprintf(text_fp, "apple\nbanana\n");
+    rewind(text_fp);
+
+    TEST_ASSERT_EQUAL_INT(0, is_dictionary_image(text_fp));
+    TEST_ASSERT_EQUAL_INT(-1, load_dictionary_image(text_fp, &image));
+    fclose(text_fp);
+
+    load_random_dictionary(&text);
+    FILE* image_fp = compile_image(&text, &image_size);
+
+    FILE* truncated_fp = copy_image(image_fp, image_size / 2);
+    TEST_ASSERT_EQUAL_INT(1, is_dictionary_image(truncated_fp));
+    TEST_ASSERT_EQUAL_INT(-1, load_dictionary_image(truncated_fp, &image));
+    fclose(truncated_fp);
+
+    // The version follows the magic number
+    FILE* damaged_fp = copy_image(image_fp, image_size);
+    fseek(damaged_fp, sizeof(DICTIONARY_IMAGE_MAGIC) + 1, SEEK_SET);
+    fputc(0xff, damaged_fp);
+    rewind(damaged_fp);
+
+    TEST_ASSERT_EQUAL_INT(-1, load_dictionary_image(damaged_fp, &image));
+    fclose(damaged_fp);
+
+    fclose(image_fp);
+    free_dictionary(&text);
+
+    TEST_ASSERT_EQUAL_INT(-1, load_dictionary_image(NULL, &image));
+}
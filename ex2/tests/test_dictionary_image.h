@@ -0,0 +1,31 @@
+/**
+ * @file test_dictionary_image.h
+ * @brief Unit tests' interface for the binary images of dictionaries.
+ * 
+ * This file contains the declarations of the unit tests for the compilation and loading of dictionary images.
+ */
+
+#ifndef _TEST_DICTIONARY_IMAGE_H
+#define _TEST_DICTIONARY_IMAGE_H
+
+#include "unity.h"
+#include "dictionary_image.h"
+
+
+/**
+ * @brief Test that a dictionary loaded from its image is the one it was compiled from.
+ * 
+ * This test verifies that the image is recognized, and that the words, the buckets, the hash set and the
+ * interleaved blocks loaded from it are the ones of the text dictionary.
+ */
+void test_dictionary_image_round_trip(void);
+
+/**
+ * @brief Test that invalid images are rejected.
+ * 
+ * This test verifies that a text dictionary is not taken for an image, and that truncated images and images
+ * with a damaged header are rejected.
+ */
+void test_dictionary_image_invalid(void);
+
+#endif  // _TEST_DICTIONARY_IMAGE_H
@@ -6,6 +6,10 @@
  */
 
 #include "test_edit_distance.h"
+#include <string.h>
+
+#define MAX_TEST_WORD_LENGTH 40
+#define MAX_TEST_LONG_STRING_LENGTH 96
 
 
 /* Tests for edit_distance (recursive approach) */
@@ -155,3 +159,218 @@ void test_edit_distance_null_string_dynamic(void) {
     TEST_ASSERT_EQUAL_INT(-1, edit_distance_dyn(NULL, "test"));
     TEST_ASSERT_EQUAL_INT(-1, edit_distance_dyn("test", NULL));
 }
+
+/**
+ * @brief Test the edit distance algorithm for strings longer than the scratch row using the dynamic programming approach.
+ * 
+ * This test verifies that the dynamic programming implementation gives the same distance whether the row of the table
+ * fits in the thread-local scratch buffer or has to be allocated.
+ */
+void test_edit_distance_long_strings_dynamic(void) {
+    static char long_s1[EDIT_DISTANCE_SCRATCH_SIZE + 11];
+    static char long_s2[EDIT_DISTANCE_SCRATCH_SIZE + 11];
+
+    memset(long_s1, 'a', EDIT_DISTANCE_SCRATCH_SIZE + 10);
+    memset(long_s2, 'a', EDIT_DISTANCE_SCRATCH_SIZE + 10);
+    long_s2[0] = 'b';
+    long_s2[EDIT_DISTANCE_SCRATCH_SIZE + 5] = '\0';
+
+    TEST_ASSERT_EQUAL_INT(7, edit_distance_dyn(long_s1, long_s2));
+    TEST_ASSERT_EQUAL_INT(7, edit_distance_dyn(long_s2, long_s1));
+    TEST_ASSERT_EQUAL_INT(0, edit_distance_dyn(long_s1, long_s1));
+}
+
+/**
+ * @brief Test that the dynamic programming approach agrees with the recursive approach.
+ * 
+ * This test verifies, on several pairs of short strings, that both implementations compute the same distance,
+ * with the arguments in either order.
+ */
+void test_edit_distance_dynamic_matches_recursive(void) {
+    const char* words[] = { "", "a", "ab", "ba", "abc", "cab", "kitten", "sitting", "flaw", "lawn", "abcabc" };
+    size_t n_words = sizeof(words) / sizeof(words[0]);
+
+    for (size_t i = 0; i < n_words; i++)
+        for (size_t j = 0; j < n_words; j++)
+            TEST_ASSERT_EQUAL_INT(edit_distance(words[i], words[j]), edit_distance_dyn(words[i], words[j]));
+}
+
+
+/* Tests for edit_distance_bitparallel (bit-parallel approach) */
+
+/**
+ * @brief Test the edit distance algorithm for basic operations using the bit-parallel approach.
+ * 
+ * This test verifies that the bit-parallel implementation correctly calculates the edit distance for identical strings,
+ * empty strings, insertions, deletions and mixed operations, and rejects null strings.
+ */
+void test_edit_distance_bitparallel(void) {
+    TEST_ASSERT_EQUAL_INT(0, edit_distance_bitparallel("hello", "hello"));
+    TEST_ASSERT_EQUAL_INT(5, edit_distance_bitparallel("", "hello"));
+    TEST_ASSERT_EQUAL_INT(5, edit_distance_bitparallel("hello", ""));
+    TEST_ASSERT_EQUAL_INT(1, edit_distance_bitparallel("hello", "helloo"));
+    TEST_ASSERT_EQUAL_INT(2, edit_distance_bitparallel("hello", "jello"));
+    TEST_ASSERT_EQUAL_INT(4, edit_distance_bitparallel("sunday", "saturday"));
+    TEST_ASSERT_EQUAL_INT(-1, edit_distance_bitparallel(NULL, "test"));
+    TEST_ASSERT_EQUAL_INT(-1, edit_distance_bitparallel("test", NULL));
+}
+
+/**
+ * @brief Test the edit distance algorithm for patterns at the length limit using the bit-parallel approach.
+ * 
+ * This test verifies that a pattern filling the whole 64-bit word is handled, and that longer patterns are rejected.
+ */
+void test_edit_distance_bitparallel_pattern_length(void) {
+    char pattern[EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH + 2];
+    char text[EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH + 2];
+
+    for (int i = 0; i <= EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH; i++) {
+        pattern[i] = 'a' + i % 7;
+        text[i] = 'a' + i % 5;
+    }
+    pattern[EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH] = '\0';
+    text[EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH + 1] = '\0';
+
+    TEST_ASSERT_EQUAL_INT(0, edit_distance_bitparallel(pattern, pattern));
+    TEST_ASSERT_EQUAL_INT(edit_distance_dyn(pattern, text), edit_distance_bitparallel(pattern, text));
+    TEST_ASSERT_EQUAL_INT(-1, edit_distance_bitparallel(text, pattern));
+}
+
+/**
+ * @brief Test that the bit-parallel approach agrees with the dynamic programming approach.
+ * 
+ * This test verifies, on pseudo-random words over a small alphabet, that both implementations compute the same distance.
+ */
+void test_edit_distance_bitparallel_matches_dynamic(void) {
+    char s1[MAX_TEST_WORD_LENGTH + 1];
+    char s2[MAX_TEST_WORD_LENGTH + 1];
+    unsigned state = 12345;
+
+    for (int n = 0; n < 500; n++) {
+        state = state * 1103515245 + 12345;
+        int len_s1 = (state >> 16) % (MAX_TEST_WORD_LENGTH + 1);
+        state = state * 1103515245 + 12345;
+        int len_s2 = (state >> 16) % (MAX_TEST_WORD_LENGTH + 1);
+
+        for (int i = 0; i < len_s1; i++) {
+            state = state * 1103515245 + 12345;
+            s1[i] = 'a' + (state >> 16) % 4;
+        }
+        for (int i = 0; i < len_s2; i++) {
+            state = state * 1103515245 + 12345;
+            s2[i] = 'a' + (state >> 16) % 4;
+        }
+        s1[len_s1] = '\0';
+        s2[len_s2] = '\0';
+
+        TEST_ASSERT_EQUAL_INT(edit_distance_dyn(s1, s2), edit_distance_bitparallel(s1, s2));
+    }
+}
+
+
+/* Tests for edit_distance_batch (batch approach) */
+
+/**
+ * @brief Test that the batch approach agrees with the dynamic programming approach.
+ * 
+ * This test verifies, on blocks of pseudo-random words of the same length interleaved by lanes, that the batch
+ * implementation computes the distance of every lane, and that it returns an error code (-1) for a pattern too long.
+ */
+void test_edit_distance_batch_matches_dynamic(void) {
+    char pattern[MAX_TEST_WORD_LENGTH + 1];
+    char words[EDIT_DISTANCE_BATCH_LANES][MAX_TEST_WORD_LENGTH + 1];
+    unsigned char block[MAX_TEST_WORD_LENGTH * EDIT_DISTANCE_BATCH_LANES];
+    int distances[EDIT_DISTANCE_BATCH_LANES];
+    unsigned state = 2468;
+
+    for (int n = 0; n < 100; n++) {
+        state = state * 1103515245 + 12345;
+        int len_pattern = (state >> 16) % (MAX_TEST_WORD_LENGTH + 1);
+        state = state * 1103515245 + 12345;
+        int length = (state >> 16) % (MAX_TEST_WORD_LENGTH + 1);
+
+        for (int i = 0; i < len_pattern; i++) {
+            state = state * 1103515245 + 12345;
+            pattern[i] = 'a' + (state >> 16) % 4;
+        }
+        pattern[len_pattern] = '\0';
+
+        for (int lane = 0; lane < EDIT_DISTANCE_BATCH_LANES; lane++) {
+            for (int j = 0; j < length; j++) {
+                state = state * 1103515245 + 12345;
+                words[lane][j] = 'a' + (state >> 16) % 4;
+                block[j * EDIT_DISTANCE_BATCH_LANES + lane] = words[lane][j];
+            }
+            words[lane][length] = '\0';
+        }
+
+        TEST_ASSERT_EQUAL_INT(0, edit_distance_batch(pattern, block, length, distances));
+
+        for (int lane = 0; lane < EDIT_DISTANCE_BATCH_LANES; lane++)
+            TEST_ASSERT_EQUAL_INT(edit_distance_dyn(pattern, words[lane]), distances[lane]);
+    }
+
+    char long_pattern[EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH + 2];
+    memset(long_pattern, 'a', EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH + 1);
+    long_pattern[EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH + 1] = '\0';
+
+    TEST_ASSERT_EQUAL_INT(-1, edit_distance_batch(long_pattern, block, 1, distances));
+    TEST_ASSERT_EQUAL_INT(-1, edit_distance_batch(NULL, block, 1, distances));
+}
+
+/* Tests for edit_distance_bounded (bounded approach) */
+
+/**
+ * @brief Test the bounded edit distance algorithm for short strings.
+ * 
+ * This test verifies that the bounded implementation returns the distance when it is within the bound,
+ * `k + 1` when it exceeds it, and an error code (-1) for null strings or a negative bound.
+ */
+void test_edit_distance_bounded(void) {
+    TEST_ASSERT_EQUAL_INT(4, edit_distance_bounded("sunday", "saturday", 4));
+    TEST_ASSERT_EQUAL_INT(4, edit_distance_bounded("sunday", "saturday", 100));
+    TEST_ASSERT_EQUAL_INT(4, edit_distance_bounded("sunday", "saturday", 3));
+    TEST_ASSERT_EQUAL_INT(2, edit_distance_bounded("hello", "helloworld", 1));
+    TEST_ASSERT_EQUAL_INT(0, edit_distance_bounded("hello", "hello", 0));
+    TEST_ASSERT_EQUAL_INT(1, edit_distance_bounded("hello", "jello", 0));
+    TEST_ASSERT_EQUAL_INT(-1, edit_distance_bounded(NULL, "test", 1));
+    TEST_ASSERT_EQUAL_INT(-1, edit_distance_bounded("test", NULL, 1));
+    TEST_ASSERT_EQUAL_INT(-1, edit_distance_bounded("test", "test", -1));
+}
+
+/**
+ * @brief Test that the bounded approach agrees with the dynamic programming approach on long strings.
+ * 
+ * This test verifies, on pseudo-random strings too long for the bit-parallel kernel and several bounds, that the
+ * diagonal band with early exit computes the same distance as the full table, capped at `k + 1`.
+ */
+void test_edit_distance_bounded_matches_dynamic(void) {
+    char s1[MAX_TEST_LONG_STRING_LENGTH + 1];
+    char s2[MAX_TEST_LONG_STRING_LENGTH + 1];
+    unsigned state = 54321;
+
+    for (int n = 0; n < 200; n++) {
+        state = state * 1103515245 + 12345;
+        int len_s1 = EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH + 1 + (state >> 16) % 16;
+        state = state * 1103515245 + 12345;
+        int len_s2 = EDIT_DISTANCE_BITPARALLEL_MAX_LENGTH + 1 + (state >> 16) % 16;
+
+        for (int i = 0; i < len_s1; i++) {
+            state = state * 1103515245 + 12345;
+            s1[i] = 'a' + (state >> 16) % 3;
+        }
+        for (int i = 0; i < len_s2; i++) {
+            state = state * 1103515245 + 12345;
+            s2[i] = 'a' + (state >> 16) % 3;
+        }
+        s1[len_s1] = '\0';
+        s2[len_s2] = '\0';
+
+        int distance = edit_distance_dyn(s1, s2);
+
+        for (int k = 0; k <= 40; k += 4) {
+            int expected = distance <= k ? distance : k + 1;
+            TEST_ASSERT_EQUAL_INT(expected, edit_distance_bounded(s1, s2, k));
+        }
+    }
+}
@@ -128,4 +128,65 @@ void test_edit_distance_mixed_operations_dynamic(void);
  */
 void test_edit_distance_null_string_dynamic(void);
 
+/**
+ * @brief Test the edit distance algorithm for strings longer than the scratch row using the dynamic programming approach.
+ * 
+ * This test verifies that the dynamic programming implementation gives the same distance whether the row of the table
+ * fits in the thread-local scratch buffer or has to be allocated.
+ */
+void test_edit_distance_long_strings_dynamic(void);
+
+/**
+ * @brief Test that the dynamic programming approach agrees with the recursive approach.
+ * 
+ * This test verifies, on several pairs of short strings, that both implementations compute the same distance.
+ */
+void test_edit_distance_dynamic_matches_recursive(void);
+
+/**
+ * @brief Test the edit distance algorithm for basic operations using the bit-parallel approach.
+ * 
+ * This test verifies that the bit-parallel implementation correctly calculates the edit distance for identical strings,
+ * empty strings, insertions, deletions and mixed operations, and rejects null strings.
+ */
+void test_edit_distance_bitparallel(void);
+
+/**
+ * @brief Test the edit distance algorithm for patterns at the length limit using the bit-parallel approach.
+ * 
+ * This test verifies that a pattern filling the whole 64-bit word is handled, and that longer patterns are rejected.
+ */
+void test_edit_distance_bitparallel_pattern_length(void);
+
+/**
+ * @brief Test that the bit-parallel approach agrees with the dynamic programming approach.
+ * 
+ * This test verifies, on pseudo-random words over a small alphabet, that both implementations compute the same distance.
+ */
+void test_edit_distance_bitparallel_matches_dynamic(void);
+
+/**
+ * @brief Test that the batch approach agrees with the dynamic programming approach.
+ * 
+ * This test verifies, on blocks of pseudo-random words of the same length interleaved by lanes, that the batch
+ * implementation computes the distance of every lane, and that it returns an error code (-1) for a pattern too long.
+ */
+void test_edit_distance_batch_matches_dynamic(void);
+
+/**
+ * @brief Test the bounded edit distance algorithm for short strings.
+ * 
+ * This test verifies that the bounded implementation returns the distance when it is within the bound,
+ * `k + 1` when it exceeds it, and an error code (-1) for null strings or a negative bound.
+ */
+void test_edit_distance_bounded(void);
+
+/**
+ * @brief Test that the bounded approach agrees with the dynamic programming approach on long strings.
+ * 
+ * This test verifies, on pseudo-random strings too long for the bit-parallel kernel and several bounds, that the
+ * diagonal band with early exit computes the same distance as the full table, capped at `k + 1`.
+ */
+void test_edit_distance_bounded_matches_dynamic(void);
+
 #endif  // _TEST_EDIT_DISTANCE_H
@@ -14,12 +14,29 @@
  * @note The `setUp` and `tearDown` functions are required by Unity but are empty in this file.
  * 
  * @see test_edit_distance.h
+ * @see test_closest_word.h
+ * @see test_bk_tree.h
+ * @see test_symspell.h
+ * @see test_trie.h
+ * @see test_qgram_index.h
+ * @see test_correction_cache.h
+ * @see test_dictionary_image.h
+ * @see test_corrector.h
  * @see test_text_io.h
  * @see Unity
  */
 
 #include "unity.h"
 #include "test_edit_distance.h"
+#include "test_closest_word.h"
+#include "test_bk_tree.h"
+#include "test_symspell.h"
+#include "test_trie.h"
+#include "test_qgram_index.h"
+#include "test_correction_cache.h"
+#include "test_dictionary_image.h"
+#include "test_corrector.h"
+#include "test_text_io.h"
 
 
 /**
@@ -59,7 +76,20 @@ void tearDown(void) {
  * 
  * The tests are grouped by the type of operation they test:
  * - Recursive version: Tests for identical strings, empty strings, insertions, deletions, substitutions, mixed operations, and null strings.
- * - Dynamic programming version: Tests for identical strings, empty strings, insertions, deletions, substitutions, mixed operations, and null strings.
+ * - Dynamic programming version: Tests for identical strings, empty strings, insertions, deletions, substitutions, mixed operations, null strings,
+ *   strings longer than the scratch row, and agreement with the recursive version.
+ * - Bit-parallel version: Tests for basic operations, patterns at the length limit, and agreement with the dynamic programming version.
+ * - Batch version: Tests for agreement with the dynamic programming version on every lane of interleaved blocks.
+ * - Bounded version: Tests for distances within and beyond the bound, and agreement with the dynamic programming version on long strings.
+ * - Reading of text files: Tests for the counts of lines and words, the reading of dictionaries and texts, and the buckets, the interleaved blocks and the exact lookups of a loaded dictionary, and the words read one at a time by the stream mode.
+ * - Search by length buckets: Tests for the ties between words, and the closest word and the k closest words compared with a linear scan.
+ * - BK-tree index: Tests for the construction of the tree, and the closest word and words within a distance compared with a linear scan.
+ * - SymSpell deletion index: Tests for the construction of the index, the ties between words, and the closest word compared with a linear scan.
+ * - Trie: Tests for the construction of the trie, and the closest word compared with a linear scan.
+ * - Q-gram index: Tests for the construction of the index, the ties between words, and the closest word compared with a linear scan.
+ * - Cache of the corrections: Tests for the lookups and insertions, and the eviction of the least recently used words.
+ * - Dictionary images: Tests for the dictionary loaded back from its image, and the rejection of invalid images.
+ * - Correction of words: Tests for the agreement of the engines, the correction of a batch of words on several threads, and the cache of the corrections of repeated words.
  * 
  * @return An integer indicating the result of the test run. Returns 0 if all tests pass, 
  *         or a non-zero value if any test fails.
@@ -84,6 +114,74 @@ int main(void) {
     RUN_TEST(test_edit_distance_substitution_dynamic);
     RUN_TEST(test_edit_distance_mixed_operations_dynamic);
     RUN_TEST(test_edit_distance_null_string_dynamic);
+    RUN_TEST(test_edit_distance_long_strings_dynamic);
+    RUN_TEST(test_edit_distance_dynamic_matches_recursive);
+
+    // Run tests for bit-parallel edit_distance_bitparallel
+    RUN_TEST(test_edit_distance_bitparallel);
+    RUN_TEST(test_edit_distance_bitparallel_pattern_length);
+    RUN_TEST(test_edit_distance_bitparallel_matches_dynamic);
+
+    // Run tests for batch edit_distance_batch
+    RUN_TEST(test_edit_distance_batch_matches_dynamic);
+
+    // Run tests for bounded edit_distance_bounded
+    RUN_TEST(test_edit_distance_bounded);
+    RUN_TEST(test_edit_distance_bounded_matches_dynamic);
+
+    // Run tests for the reading of text files
+    RUN_TEST(test_count_lines_valid_file);
+    RUN_TEST(test_count_lines_empty_file);
+    RUN_TEST(test_count_lines_invalid_file);
+    RUN_TEST(test_count_words_valid_file);
+    RUN_TEST(test_count_words_empty_file);
+    RUN_TEST(test_count_words_invalid_file);
+    RUN_TEST(test_read_dictionary_valid_file);
+    RUN_TEST(test_read_dictionary_invalid_file);
+    RUN_TEST(test_load_dictionary_buckets);
+    RUN_TEST(test_load_dictionary_interleaved);
+    RUN_TEST(test_dictionary_lookup);
+    RUN_TEST(test_read_to_correct_valid_file);
+    RUN_TEST(test_read_to_correct_invalid_file);
+    RUN_TEST(test_read_word);
+    cleanup_test_files();
+
+    // Run tests for the search by length buckets
+    RUN_TEST(test_find_closest_word_ties);
+    RUN_TEST(test_find_closest_word);
+    RUN_TEST(test_find_closest_words);
+
+    // Run tests for the BK-tree index
+    RUN_TEST(test_bk_tree_build);
+    RUN_TEST(test_bk_tree_find_closest);
+    RUN_TEST(test_bk_tree_find_within);
+
+    // Run tests for the SymSpell deletion index
+    RUN_TEST(test_symspell_build);
+    RUN_TEST(test_symspell_find_closest_ties);
+    RUN_TEST(test_symspell_find_closest);
+
+    // Run tests for the trie
+    RUN_TEST(test_trie_build);
+    RUN_TEST(test_trie_find_closest);
+
+    // Run tests for the q-gram index
+    RUN_TEST(test_qgram_build);
+    RUN_TEST(test_qgram_find_closest_ties);
+    RUN_TEST(test_qgram_find_closest);
+
+    // Run tests for the cache of the corrections
+    RUN_TEST(test_correction_cache_get_put);
+    RUN_TEST(test_correction_cache_eviction);
+
+    // Run tests for the binary images of dictionaries
+    RUN_TEST(test_dictionary_image_round_trip);
+    RUN_TEST(test_dictionary_image_invalid);
+
+    // Run tests for the correction of words
+    RUN_TEST(test_correct_word_engines);
+    RUN_TEST(test_correct_words_parallel);
+    RUN_TEST(test_correct_words_cache);
 
     return UNITY_END();
 }
@@ -0,0 +1,155 @@
+/**
+ * @file test_qgram_index.c
+ * @brief Unit tests' implementation for the q-gram index of a dictionary.
+ *
+ * This file contains the implementation of the unit tests for the inverted index of the q-grams of a dictionary.
+ */
+
+#include "test_qgram_index.h"
+#include "test_utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+#define N_RANDOM_WORDS 2000
+#define N_RANDOM_QUERIES 300
+#define RANDOM_WORD_LENGTH 20
+#define MAX_EDITS 3
+
+/* Helper function to derive a word to correct from a word of the dictionary, with a few insertions and deletions */
+static void mutate_word(const char* word, char* mutated, unsigned* seed) {
+    int length = (int)strlen(word);
+    memcpy(mutated, word, length + 1);
+
+    *seed = *seed * 1103515245 + 12345;
+    int n_edits = 1 + (*seed >> 16) % MAX_EDITS;
+
+    for (int e = 0; e < n_edits; e++) {
+        *seed = *seed * 1103515245 + 12345;
+        int position = (*seed >> 16) % (length + 1);
+
+        if (((*seed >> 8) & 1) && length > 1 && position < length) {
+            memmove(mutated + position, mutated + position + 1, length - position);
+            length--;
+        }
+        else {
+            memmove(mutated + position + 1, mutated + position, length - position + 1);
+            mutated[position] = 'a' + (*seed >> 24) % 6;
+            length++;
+        }
+    }
+}
+
+/**
+ * @brief Test the construction of a q-gram index.
+ *
+ * This test verifies the number of distinct q-grams and of word indexes stored for a small dictionary, in which
+ * several words share q-grams and a word repeats one, and that invalid arguments are rejected.
+ */
+void test_qgram_build(void) {
+    char* dictionary[] = { "ab", "ba", "abc", "aaaa" };
+    QGramIndex index;
+
+    TEST_ASSERT_EQUAL_INT(4, qgram_build(&index, dictionary, 4));
+
+    // With '#' for the padding, ab: ##a #ab ab# b##, ba: ##b #ba ba# a##, abc: ##a #ab abc bc# c##,
+    // aaaa: ##a #aa aaa aaa aa# a##
+    TEST_ASSERT_EQUAL_size_t(14, index.n_grams);
+    TEST_ASSERT_EQUAL_size_t(19, index.n_postings);
+    TEST_ASSERT_EQUAL_UINT32(19, index.starts[index.n_grams]);
+    TEST_ASSERT_EQUAL_UINT16(4, index.lengths[3]);
+    TEST_ASSERT_TRUE(qgram_memory_usage(&index) > 0);
+
+    for (size_t g = 1; g < index.n_grams; g++)
+        TEST_ASSERT_TRUE(index.grams[g - 1] < index.grams[g]);
+
+    qgram_free(&index);
+
+    TEST_ASSERT_EQUAL_INT(-1, qgram_build(&index, dictionary, 0));
+    TEST_ASSERT_EQUAL_INT(-1, qgram_build(NULL, dictionary, 4));
+}
+
+/**
+ * @brief Test the ties between the words found with a q-gram index.
+ *
+ * This test verifies that, among several words at the same distance, duplicated words included, the first one
+ * in dictionary order is returned, and that nothing is found when the q-grams of the word cannot rule out the
+ * words sharing none of them. The closest word and its distance may be left out.
+ */
+void test_qgram_find_closest_ties(void) {
+    char* dictionary[] = { "abcdefgh", "abcdefgx", "abcdefgy", "abcdefgx", "zzz" };
+    QGramIndex index;
+    const char* closest_word = NULL;
+    int min_distance = -1;
+
+    TEST_ASSERT_EQUAL_INT(5, qgram_build(&index, dictionary, 5));
+
+    TEST_ASSERT_EQUAL_INT(1, qgram_find_closest(&index, "abcdefgx", &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_STRING("abcdefgx", closest_word);
+    TEST_ASSERT_EQUAL_INT(0, min_distance);
+
+    TEST_ASSERT_EQUAL_INT(0, qgram_find_closest(&index, "abcdefg", &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_INT(1, min_distance);
+
+    TEST_ASSERT_EQUAL_INT(1, qgram_find_closest(&index, "abcdefgxy", &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_INT(1, min_distance);
+
+    // The closest word and its distance are optional
+    TEST_ASSERT_EQUAL_INT(1, qgram_find_closest(&index, "abcdefgxy", NULL, NULL));
+
+    // Too short to rule out the other words, or sharing no q-gram with the dictionary
+    closest_word = NULL;
+    min_distance = -1;
+    TEST_ASSERT_EQUAL_INT(-1, qgram_find_closest(&index, "zz", &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_INT(-1, qgram_find_closest(&index, "elephant", &closest_word, &min_distance));
+    TEST_ASSERT_NULL(closest_word);
+    TEST_ASSERT_EQUAL_INT(-1, min_distance);
+
+    TEST_ASSERT_EQUAL_INT(-1, qgram_find_closest(&index, NULL, &closest_word, &min_distance));
+
+    qgram_free(&index);
+}
+
+/**
+ * @brief Test that the closest word found with a q-gram index is the one of a linear scan.
+ *
+ * This test verifies, on pseudo-random words, that the index finds the closest word of a linear scan whenever it
+ * reports one, and always does when it is close enough for the count filter.
+ */
+void test_qgram_find_closest(void) {
+    char** dictionary = create_random_words(N_RANDOM_WORDS, 1, RANDOM_WORD_LENGTH, 6, 42);
+    QGramIndex index;
+    unsigned seed = 7;
+    int n_found = 0;
+
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, qgram_build(&index, dictionary, N_RANDOM_WORDS));
+
+    for (int q = 0; q < N_RANDOM_QUERIES; q++) {
+        char query[RANDOM_WORD_LENGTH + MAX_EDITS + 1];
+        mutate_word(dictionary[(q * 7) % N_RANDOM_WORDS], query, &seed);
+
+        int expected_distance;
+        int expected_index = linear_scan_closest(query, dictionary, N_RANDOM_WORDS, &expected_distance);
+
+        const char* closest_word = NULL;
+        int min_distance = -1;
+        int found = qgram_find_closest(&index, query, &closest_word, &min_distance);
+
+        // With |G| = length + q - 1 q-grams, at most q - 1 of them skipped, the radius is at least ceil(length / q)
+        int length = (int)strlen(query);
+        int radius = (length + QGRAM_LENGTH - 1) / QGRAM_LENGTH;
+
+        if (found != -1 || expected_distance < radius) {
+            TEST_ASSERT_EQUAL_INT(expected_index, found);
+            TEST_ASSERT_EQUAL_INT(expected_distance, min_distance);
+            TEST_ASSERT_EQUAL_PTR(dictionary[expected_index], closest_word);
+            n_found++;
+        }
+    }
+
+    // Most of the words are long enough to be found by the index
+    TEST_ASSERT_TRUE(n_found > N_RANDOM_QUERIES / 2);
+
+    qgram_free(&index);
+    free_random_words(dictionary, N_RANDOM_WORDS);
+}
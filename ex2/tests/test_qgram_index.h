@@ -0,0 +1,40 @@
+/**
+ * @file test_qgram_index.h
+ * @brief Unit tests' interface for the q-gram index of a dictionary.
+ * 
+ * This file contains the declarations of the unit tests for the inverted index of the q-grams of a dictionary.
+ */
+
+#ifndef _TEST_QGRAM_INDEX_H
+#define _TEST_QGRAM_INDEX_H
+
+#include "unity.h"
+#include "qgram_index.h"
+
+
+/**
+ * @brief Test the construction of a q-gram index.
+ * 
+ * This test verifies the number of distinct q-grams and of word indexes stored for a small dictionary, in which
+ * several words share q-grams and a word repeats one, and that invalid arguments are rejected.
+ */
+void test_qgram_build(void);
+
+/**
+ * @brief Test the ties between the words found with a q-gram index.
+ * 
+ * This test verifies that, among several words at the same distance, duplicated words included, the first one
+ * in dictionary order is returned, and that nothing is found when the q-grams of the word cannot rule out the
+ * words sharing none of them. The closest word and its distance may be left out.
+ */
+void test_qgram_find_closest_ties(void);
+
+/**
+ * @brief Test that the closest word found with a q-gram index is the one of a linear scan.
+ * 
+ * This test verifies, on pseudo-random words, that the index finds the closest word of a linear scan whenever it
+ * reports one, and always does when it is close enough for the count filter.
+ */
+void test_qgram_find_closest(void);
+
+#endif  // _TEST_QGRAM_INDEX_H
@@ -0,0 +1,110 @@
+/**
+ * @file test_symspell.c
+ * @brief Unit tests' implementation for the SymSpell deletion index of a dictionary.
+ *
+ * This file contains the implementation of the unit tests for the deletion index built over a dictionary.
+ */
+
+#include "test_symspell.h"
+#include "test_utils.h"
+#include <stdlib.h>
+
+
+#define N_RANDOM_WORDS 2000
+#define N_RANDOM_QUERIES 300
+#define RANDOM_WORD_LENGTH 10
+
+/**
+ * @brief Test the construction of a deletion index.
+ *
+ * This test verifies the number of variants stored for a small dictionary, in which several words
+ * share variants, and that invalid arguments are rejected.
+ */
+void test_symspell_build(void) {
+    char* dictionary[] = { "ab", "ba", "abc" };
+    SymSpellIndex index;
+
+    TEST_ASSERT_EQUAL_INT(3, symspell_build(&index, dictionary, 3, 1));
+
+    // "ab", "a", "b", "ba", "abc", "bc", "ac"
+    TEST_ASSERT_EQUAL_size_t(7, index.n_variants);
+    // ab: ab a b, ba: ba b a, abc: abc bc ac ab
+    TEST_ASSERT_EQUAL_size_t(10, index.n_postings);
+    TEST_ASSERT_EQUAL_INT(3, index.max_word_length);
+    TEST_ASSERT_TRUE(symspell_memory_usage(&index) > 0);
+
+    symspell_free(&index);
+
+    TEST_ASSERT_EQUAL_INT(-1, symspell_build(&index, dictionary, 0, 1));
+    TEST_ASSERT_EQUAL_INT(-1, symspell_build(&index, dictionary, 3, -1));
+}
+
+/**
+ * @brief Test the ties between the words found with a deletion index.
+ *
+ * This test verifies that, among several words at the same distance, duplicated words included,
+ * the first one in dictionary order is returned, and that nothing is found beyond the radius.
+ */
+void test_symspell_find_closest_ties(void) {
+    char* dictionary[] = { "care", "cart", "card", "cart", "dog" };
+    SymSpellIndex index;
+    const char* closest_word = NULL;
+    int min_distance = -1;
+
+    TEST_ASSERT_EQUAL_INT(5, symspell_build(&index, dictionary, 5, SYMSPELL_DEFAULT_MAX_DISTANCE));
+
+    TEST_ASSERT_EQUAL_INT(1, symspell_find_closest(&index, "cart", &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_STRING("cart", closest_word);
+    TEST_ASSERT_EQUAL_INT(0, min_distance);
+
+    TEST_ASSERT_EQUAL_INT(0, symspell_find_closest(&index, "car", &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_INT(1, min_distance);
+
+    TEST_ASSERT_EQUAL_INT(1, symspell_find_closest(&index, "carts", &closest_word, &min_distance));
+    TEST_ASSERT_EQUAL_INT(1, min_distance);
+
+    closest_word = NULL;
+    min_distance = -1;
+    TEST_ASSERT_EQUAL_INT(-1, symspell_find_closest(&index, "elephant", &closest_word, &min_distance));
+    TEST_ASSERT_NULL(closest_word);
+    TEST_ASSERT_EQUAL_INT(-1, min_distance);
+
+    TEST_ASSERT_EQUAL_INT(-1, symspell_find_closest(&index, NULL, &closest_word, &min_distance));
+
+    symspell_free(&index);
+}
+
+/**
+ * @brief Test that the closest word found with a deletion index is the one of a linear scan.
+ *
+ * This test verifies, on pseudo-random words, that the index finds the closest word of a linear scan
+ * whenever it is within the radius of the index, and reports that no word is found otherwise.
+ */
+void test_symspell_find_closest(void) {
+    char** dictionary = create_random_words(N_RANDOM_WORDS, 1, RANDOM_WORD_LENGTH, 6, 42);
+    char** queries = create_random_words(N_RANDOM_QUERIES, 1, RANDOM_WORD_LENGTH, 6, 7);
+    SymSpellIndex index;
+
+    TEST_ASSERT_EQUAL_INT(N_RANDOM_WORDS, symspell_build(&index, dictionary, N_RANDOM_WORDS, SYMSPELL_DEFAULT_MAX_DISTANCE));
+
+    for (int q = 0; q < N_RANDOM_QUERIES; q++) {
+        int expected_distance;
+        int expected_index = linear_scan_closest(queries[q], dictionary, N_RANDOM_WORDS, &expected_distance);
+
+        const char* closest_word = NULL;
+        int min_distance = -1;
+        int found = symspell_find_closest(&index, queries[q], &closest_word, &min_distance);
+
+        if (expected_distance <= SYMSPELL_DEFAULT_MAX_DISTANCE) {
+            TEST_ASSERT_EQUAL_INT(expected_index, found);
+            TEST_ASSERT_EQUAL_INT(expected_distance, min_distance);
+            TEST_ASSERT_EQUAL_PTR(dictionary[expected_index], closest_word);
+        } else {
+            TEST_ASSERT_EQUAL_INT(-1, found);
+        }
+    }
+
+    symspell_free(&index);
+    free_random_words(queries, N_RANDOM_QUERIES);
+    free_random_words(dictionary, N_RANDOM_WORDS);
+}
@@ -0,0 +1,39 @@
+/**
+ * @file test_symspell.h
+ * @brief Unit tests' interface for the SymSpell deletion index of a dictionary.
+ * 
+ * This file contains the declarations of the unit tests for the deletion index built over a dictionary.
+ */
+
+#ifndef _TEST_SYMSPELL_H
+#define _TEST_SYMSPELL_H
+
+#include "unity.h"
+#include "symspell.h"
+
+
+/**
+ * @brief Test the construction of a deletion index.
+ * 
+ * This test verifies the number of variants stored for a small dictionary, in which several words
+ * share variants, and that invalid arguments are rejected.
+ */
+void test_symspell_build(void);
+
+/**
+ * @brief Test the ties between the words found with a deletion index.
+ * 
+ * This test verifies that, among several words at the same distance, duplicated words included,
+ * the first one in dictionary order is returned, and that nothing is found beyond the radius.
+ */
+void test_symspell_find_closest_ties(void);
+
+/**
+ * @brief Test that the closest word found with a deletion index is the one of a linear scan.
+ * 
+ * This test verifies, on pseudo-random words, that the index finds the closest word of a linear scan
+ * whenever it is within the radius of the index, and reports that no word is found otherwise.
+ */
+void test_symspell_find_closest(void);
+
+#endif  // _TEST_SYMSPELL_H
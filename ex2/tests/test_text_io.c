@@ -5,14 +5,17 @@
  * This file contains the implementation of unit tests for the text_io interface functions.
  */
 
-#include "unity.h"
-#include "text_io.h"
+#include "test_text_io.h"
+#include "test_utils.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 
 #define TEST_FILE "test_file.txt"
 #define DICTIONARY_FILE "dictionary.txt"
 #define CORRECT_FILE "to_correct.txt"
+#define RANDOM_WORD_LENGTH 12
 
 /* Helper function to create a test file with some content */
 void create_test_file(const char* filename) {
@@ -71,7 +74,7 @@ void test_count_words_valid_file(void) {
     create_test_file(TEST_FILE);
     FILE* file = fopen(TEST_FILE, "r");
     TEST_ASSERT_NOT_NULL(file);
-    TEST_ASSERT_EQUAL_INT(6, count_words(file));  // "Hello", "world", "This", "is", "a", "test"
+    TEST_ASSERT_EQUAL_INT(7, count_words(file));  // "Hello", "world", "This", "is", "a", "test", "file"
     fclose(file);
 }
 
@@ -115,6 +118,79 @@ void test_read_dictionary_invalid_file(void) {
     TEST_ASSERT_EQUAL_INT(-1, count);
 }
 
+/* Test load_dictionary function */
+void test_load_dictionary_buckets(void) {
+    const char* words[] = { "tree", "a", "cat", "dog", "be", "stone", "an", "bird" };
+    Dictionary dictionary;
+
+    load_test_dictionary(&dictionary, words, 8);
+
+    TEST_ASSERT_EQUAL_INT(5, dictionary.max_length);
+
+    int expected_start[] = { 0, 0, 1, 3, 5, 7, 8 };
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected_start, dictionary.bucket_start, 7);
+
+    int expected_order[] = { 1, 4, 6, 2, 3, 0, 7, 5 };
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected_order, dictionary.by_length, 8);
+
+    free_dictionary(&dictionary);
+}
+
+void test_load_dictionary_interleaved(void) {
+    const char* words[RANDOM_WORD_LENGTH * 3];
+    char buffer[RANDOM_WORD_LENGTH * 3][RANDOM_WORD_LENGTH + 1];
+    Dictionary dictionary;
+    unsigned seed = 99;
+
+    for (int i = 0; i < RANDOM_WORD_LENGTH * 3; i++) {
+        random_word(buffer[i], 1, RANDOM_WORD_LENGTH, 6, &seed);
+        words[i] = buffer[i];
+    }
+
+    load_test_dictionary(&dictionary, words, RANDOM_WORD_LENGTH * 3);
+
+    TEST_ASSERT_EQUAL_INT(0, (uintptr_t)dictionary.interleaved % EDIT_DISTANCE_BATCH_LANES);
+
+    for (int length = 1; length <= dictionary.max_length; length++) {
+        const unsigned char* blocks = dictionary.interleaved + dictionary.interleaved_start[length];
+        int n_words = dictionary.bucket_start[length + 1] - dictionary.bucket_start[length];
+        int n_lanes = (n_words + EDIT_DISTANCE_BATCH_LANES - 1) / EDIT_DISTANCE_BATCH_LANES * EDIT_DISTANCE_BATCH_LANES;
+
+        for (int position = 0; position < n_lanes; position++) {
+            const unsigned char* block = blocks + position / EDIT_DISTANCE_BATCH_LANES * EDIT_DISTANCE_BATCH_LANES * length;
+            int lane = position % EDIT_DISTANCE_BATCH_LANES;
+
+            for (int j = 0; j < length; j++) {
+                int expected = position < n_words
+                    ? (unsigned char)words[dictionary.by_length[dictionary.bucket_start[length] + position]][j]
+                    : 0;
+                TEST_ASSERT_EQUAL_INT(expected, block[j * EDIT_DISTANCE_BATCH_LANES + lane]);
+            }
+        }
+    }
+
+    free_dictionary(&dictionary);
+}
+
+/* Test dictionary_lookup function */
+void test_dictionary_lookup(void) {
+    const char* words[] = { "tree", "a", "cat", "dog", "cat", "stone", "an", "tree" };
+    int expected_index[] = { 0, 1, 2, 3, 2, 5, 6, 0 };
+    Dictionary dictionary;
+
+    load_test_dictionary(&dictionary, words, 8);
+
+    for (int i = 0; i < 8; i++)
+        TEST_ASSERT_EQUAL_INT(expected_index[i], dictionary_lookup(&dictionary, words[i]));
+
+    TEST_ASSERT_EQUAL_INT(-1, dictionary_lookup(&dictionary, "ca"));
+    TEST_ASSERT_EQUAL_INT(-1, dictionary_lookup(&dictionary, "cats"));
+    TEST_ASSERT_EQUAL_INT(-1, dictionary_lookup(&dictionary, ""));
+    TEST_ASSERT_EQUAL_INT(-1, dictionary_lookup(&dictionary, NULL));
+
+    free_dictionary(&dictionary);
+}
+
 /* Test read_to_correct function */
 void test_read_to_correct_valid_file(void) {
     create_to_correct_file(CORRECT_FILE);
@@ -122,9 +198,9 @@ void test_read_to_correct_valid_file(void) {
     TEST_ASSERT_NOT_NULL(file);
     char** to_correct = NULL;
     int count = read_to_correct(file, &to_correct);
-    TEST_ASSERT_EQUAL_INT(7, count);  // "I", "have", "a", "aplle", "and", "a", "bananna"
+    TEST_ASSERT_EQUAL_INT(7, count);  // "i", "have", "a", "aplle", "and", "a", "bananna"
     TEST_ASSERT_NOT_NULL(to_correct);
-    TEST_ASSERT_EQUAL_STRING("I", to_correct[0]);
+    TEST_ASSERT_EQUAL_STRING("i", to_correct[0]);  // The words are lowercased
     TEST_ASSERT_EQUAL_STRING("have", to_correct[1]);
     TEST_ASSERT_EQUAL_STRING("a", to_correct[2]);
     TEST_ASSERT_EQUAL_STRING("aplle", to_correct[3]);
@@ -143,6 +219,50 @@ void test_read_to_correct_invalid_file(void) {
     TEST_ASSERT_EQUAL_INT(-1, count);
 }
 
+/* Test read_word function */
+void test_read_word(void) {
+    FILE* file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+
+    fprintf(file, "I have a aplle,and a (Bananna).\n\n  -- Longword!");
+    rewind(file);
+
+    char** expected;
+    int n_expected = read_to_correct(file, &expected);
+    TEST_ASSERT_EQUAL_INT(8, n_expected);
+    rewind(file);
+
+    char word[MAX_LINE_LENGTH];
+    for (int i = 0; i < n_expected; i++) {
+        TEST_ASSERT_EQUAL_INT((int)strlen(expected[i]), read_word(file, word, MAX_LINE_LENGTH));
+        TEST_ASSERT_EQUAL_STRING(expected[i], word);
+        free(expected[i]);
+    }
+    free(expected);
+
+    TEST_ASSERT_EQUAL_INT(0, read_word(file, word, MAX_LINE_LENGTH));
+    TEST_ASSERT_EQUAL_INT(0, read_word(file, word, MAX_LINE_LENGTH));
+
+    // A word longer than the buffer comes in pieces
+    fclose(file);
+    file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+
+    fprintf(file, "abcdefg hi");
+    rewind(file);
+
+    const char* pieces[] = { "abc", "def", "g", "hi" };
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT((int)strlen(pieces[i]), read_word(file, word, 4));
+        TEST_ASSERT_EQUAL_STRING(pieces[i], word);
+    }
+
+    TEST_ASSERT_EQUAL_INT(-1, read_word(file, word, 1));
+    TEST_ASSERT_EQUAL_INT(-1, read_word(NULL, word, MAX_LINE_LENGTH));
+
+    fclose(file);
+}
+
 /* Cleanup test files */
 void cleanup_test_files(void) {
     remove(TEST_FILE);
@@ -1,74 +1,104 @@
 /**
- * @file text_io.h
- * @brief Interface for reading text files and storing words in a hash table.
+ * @file test_text_io.h
+ * @brief Unit tests' interface for reading text files and loading dictionaries.
  * 
- * This header file provides the interface for reading text files and storing words
- * in a hash table. It includes functions for counting words in a file, reading text
- * from a file, and inserting words into a hash table.
+ * This file contains the declarations of the unit tests for `count_lines`, `count_words`, `read_dictionary`,
+ * `load_dictionary`, `dictionary_lookup`, `read_to_correct` and `read_word`.
  * 
- * @see text_io.c
+ * @see text_io.h
  */
 
-#ifndef _TEXT_IO_H
-#define _TEXT_IO_H
+#ifndef _TEST_TEXT_IO_H
+#define _TEST_TEXT_IO_H
 
-#include <stdio.h>
+#include "unity.h"
+#include "text_io.h"
 
 
-#define MAX_LINE_LENGTH 1024
-#define MAX_WORD_LENGTH 32
+/**
+ * @brief Test the count of the lines of a file with two lines.
+ */
+void test_count_lines_valid_file(void);
 
 /**
- * @brief Counts the number of lines in a file.
- *
- * This function reads a file character by character to count how many lines
- * it contains. It assumes that the file pointer is already opened and 
- * passed as an argument. The function resets the file pointer back to 
- * the beginning after counting.
- *
- * @param file_fp File pointer to the file.
- * @return The number of lines in the file, or -1 if an error occurs.
+ * @brief Test the count of the lines of an empty file.
  */
-int count_lines(FILE* file_fp);
+void test_count_lines_empty_file(void);
 
 /**
- * @brief Counts the number of words in a file.
- *
- * This function reads the file line by line and splits each line into words
- * using common delimiters such as spaces, punctuation, and newline characters.
- * It returns the total word count in the file. The file pointer is reset 
- * after counting the words.
- *
- * @param file File pointer to the file.
- * @return The number of words in the file, or -1 if an error occurs.
+ * @brief Test that counting the lines of a file that could not be opened fails.
  */
-int count_words(FILE* file);
+void test_count_lines_invalid_file(void);
 
 /**
- * @brief Reads a dictionary file into memory.
- *
- * This function reads words from a dictionary file and stores them in
- * a dynamically allocated array. Each word is stored as a separate string
- * in the array. The dictionary file is assumed to be plain text with one
- * word per line.
- *
- * @param dictionary_fp File pointer to the dictionary file.
- * @param dictionary A pointer to a pointer where the array of words will be stored.
- * @return The number of words successfully read, or -1 if an error occurs.
+ * @brief Test the count of the words of a file, split on spaces and punctuation.
  */
-int read_dictionary(FILE* dictionary_fp, char*** dictionary);
+void test_count_words_valid_file(void);
 
 /**
- * @brief Reads a file to correct into memory.
- *
- * This function reads a file containing text to correct and stores the words
- * in a dynamically allocated array. It assumes that the file is a plain text
- * file and separates words using common delimiters such as spaces and punctuation.
+ * @brief Test the count of the words of an empty file.
+ */
+void test_count_words_empty_file(void);
+
+/**
+ * @brief Test that counting the words of a file that could not be opened fails.
+ */
+void test_count_words_invalid_file(void);
+
+/**
+ * @brief Test that the words of a dictionary file are read one per line, in file order.
+ */
+void test_read_dictionary_valid_file(void);
+
+/**
+ * @brief Test that reading a dictionary file that could not be opened fails.
+ */
+void test_read_dictionary_invalid_file(void);
+
+/**
+ * @brief Test the length buckets of a dictionary.
+ * 
+ * This test verifies that `load_dictionary` groups the words by length, keeping the file order within a bucket.
+ */
+void test_load_dictionary_buckets(void);
+
+/**
+ * @brief Test the interleaved blocks of a dictionary.
  *
- * @param to_correct_fp File pointer to the file to correct.
- * @param to_correct A pointer to a pointer where the array of words will be stored.
- * @return The number of words successfully read, or -1 if an error occurs.
+ * This test verifies that the words of each length bucket are laid out by blocks of `EDIT_DISTANCE_BATCH_LANES`
+ * lanes in bucket order, that the lanes past the end of a bucket are zero, and that the blocks are aligned.
+ */
+void test_load_dictionary_interleaved(void);
+
+/**
+ * @brief Test the exact lookups in the hash set of a dictionary.
+ * 
+ * This test verifies that every word of the dictionary is found at the index of its first occurrence, and that
+ * words missing from the dictionary, prefixes included, are not found.
+ */
+void test_dictionary_lookup(void);
+
+/**
+ * @brief Test that the words of a text are split on spaces and punctuation, lowercased, in file order.
+ */
+void test_read_to_correct_valid_file(void);
+
+/**
+ * @brief Test that reading a text that could not be opened fails.
+ */
+void test_read_to_correct_invalid_file(void);
+
+/**
+ * @brief Test the words read one at a time for the stream mode.
+ * 
+ * This test verifies that `read_word` reads the words of `read_to_correct`, in lowercase, from a text read once,
+ * and splits a word longer than its buffer.
+ */
+void test_read_word(void);
+
+/**
+ * @brief Removes the files created by the tests of this file.
  */
-int read_to_correct(FILE* to_correct_fp, char*** to_correct);
+void cleanup_test_files(void);
 
-#endif // _TEXT_IO_H
+#endif // _TEST_TEXT_IO_H
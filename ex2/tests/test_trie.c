@@ -0,0 +1,107 @@
+/**
+ * @file test_trie.c
+ * @brief Unit tests' implementation for the trie of a dictionary.
+ *
+ * This file contains the implementation of the unit tests for the trie built over a dictionary.
+ */
+
+#include "test_trie.h"
+#include "test_utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+#define N_RANDOM_WORDS 2000
+#define N_RANDOM_QUERIES 200
+#define RANDOM_WORD_LENGTH 10
+
+/* Helper function to find the node of a word, following the labels from the root */
+static int find_node(const Trie* trie, const char* word) {
+    int node = 0;
+
+    for (const char* c = word; *c != '\0'; c++) {
+        int child = trie -> first_child[node];
+        int end = child + trie -> n_children[node];
+
+        while (child < end && trie -> label[child] != *c)
+            child++;
+
+        if (child == end)
+            return -1;
+
+        node = child;
+    }
+
+    return node;
+}
+
+/**
+ * @brief Test the construction of a trie.
+ *
+ * This test verifies that each word of the dictionary is spelled by the labels of the path to its node, which
+ * holds its first occurrence, that the children of each node are sorted by their label, that the first word
+ * below each node is recorded, and that an empty dictionary is rejected.
+ */
+void test_trie_build(void) {
+    char* dictionary[] = { "book", "books", "cake", "boo", "book", "cook", "cape", "cart" };
+    int first_occurrence[] = { 0, 1, 2, 3, 0, 5, 6, 7 };
+    int n_words = sizeof(dictionary) / sizeof(dictionary[0]);
+    Trie trie;
+
+    // root, b, bo, boo, book, books, c, ca, cak, cake, cap, cape, car, cart, co, coo, cook
+    TEST_ASSERT_EQUAL_INT(17, trie_build(&trie, dictionary, n_words));
+    TEST_ASSERT_EQUAL_INT(5, trie.max_depth);
+    TEST_ASSERT_EQUAL_INT(-1, trie.word_index[0]);
+    TEST_ASSERT_EQUAL_INT(0, trie.min_index[0]);
+
+    for (int i = 0; i < n_words; i++) {
+        int node = find_node(&trie, dictionary[i]);
+
+        TEST_ASSERT_TRUE(node > 0);
+        TEST_ASSERT_EQUAL_INT(first_occurrence[i], trie.word_index[node]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(2, trie.min_index[find_node(&trie, "ca")]);
+    TEST_ASSERT_EQUAL_INT(5, trie.min_index[find_node(&trie, "co")]);
+    TEST_ASSERT_EQUAL_INT(-1, trie.word_index[find_node(&trie, "ca")]);
+
+    for (int node = 0; node < trie.n_nodes; node++)
+        for (int child = trie.first_child[node] + 1; child < trie.first_child[node] + trie.n_children[node]; child++)
+            TEST_ASSERT_TRUE(trie.label[child - 1] < trie.label[child]);
+
+    trie_free(&trie);
+
+    TEST_ASSERT_EQUAL_INT(-1, trie_build(&trie, dictionary, 0));
+}
+
+/**
+ * @brief Test that the closest word found with a trie is the one of a linear scan.
+ *
+ * This test verifies, on a dictionary with duplicated words, an empty word and several words at the same
+ * distance, that the trie returns the first of the closest words in dictionary order.
+ */
+void test_trie_find_closest(void) {
+    char** dictionary = create_random_words(N_RANDOM_WORDS, 0, RANDOM_WORD_LENGTH, 5, 42);
+    char** queries = create_random_words(N_RANDOM_QUERIES, 0, RANDOM_WORD_LENGTH, 5, 7);
+    Trie trie;
+
+    TEST_ASSERT_TRUE(trie_build(&trie, dictionary, N_RANDOM_WORDS) > 0);
+
+    for (int q = 0; q < N_RANDOM_QUERIES; q++) {
+        int expected_distance;
+        int expected_index = linear_scan_closest(queries[q], dictionary, N_RANDOM_WORDS, &expected_distance);
+
+        const char* closest_word = NULL;
+        int min_distance = -1;
+
+        TEST_ASSERT_EQUAL_INT(expected_index, trie_find_closest(&trie, queries[q], &closest_word, &min_distance));
+        TEST_ASSERT_EQUAL_INT(expected_distance, min_distance);
+        TEST_ASSERT_EQUAL_PTR(dictionary[expected_index], closest_word);
+    }
+
+    TEST_ASSERT_EQUAL_INT(-1, trie_find_closest(&trie, NULL, NULL, NULL));
+
+    trie_free(&trie);
+    free_random_words(queries, N_RANDOM_QUERIES);
+    free_random_words(dictionary, N_RANDOM_WORDS);
+}
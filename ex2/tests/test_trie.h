@@ -0,0 +1,32 @@
+/**
+ * @file test_trie.h
+ * @brief Unit tests' interface for the trie of a dictionary.
+ * 
+ * This file contains the declarations of the unit tests for the trie built over a dictionary.
+ */
+
+#ifndef _TEST_TRIE_H
+#define _TEST_TRIE_H
+
+#include "unity.h"
+#include "trie.h"
+
+
+/**
+ * @brief Test the construction of a trie.
+ * 
+ * This test verifies that each word of the dictionary is spelled by the labels of the path to its node, which
+ * holds its first occurrence, that the children of each node are sorted by their label, that the first word
+ * below each node is recorded, and that an empty dictionary is rejected.
+ */
+void test_trie_build(void);
+
+/**
+ * @brief Test that the closest word found with a trie is the one of a linear scan.
+ * 
+ * This test verifies, on a dictionary with duplicated words, an empty word and several words at the same
+ * distance, that the trie returns the first of the closest words in dictionary order.
+ */
+void test_trie_find_closest(void);
+
+#endif  // _TEST_TRIE_H
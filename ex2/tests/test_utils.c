@@ -0,0 +1,77 @@
+/**
+ * @file test_utils.c
+ * @brief Implementation of the helpers shared by the unit tests of the search engines.
+ *
+ * This file contains the implementation of the generator of the pseudo-random words the engines are compared on.
+ */
+
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+void random_word(char* word, int min_length, int max_length, int alphabet_size, unsigned* seed) {
+    *seed = *seed * 1103515245 + 12345;
+    int length = min_length + (*seed >> 16) % (max_length - min_length + 1);
+
+    for (int j = 0; j < length; j++) {
+        *seed = *seed * 1103515245 + 12345;
+        word[j] = 'a' + (*seed >> 16) % alphabet_size;
+    }
+    word[length] = '\0';
+}
+
+char** create_random_words(int n_words, int min_length, int max_length, int alphabet_size, unsigned seed) {
+    char** words = malloc(n_words * sizeof(char*));
+    TEST_ASSERT_NOT_NULL(words);
+
+    char* buffer = malloc(max_length + 1);
+    TEST_ASSERT_NOT_NULL(buffer);
+
+    for (int i = 0; i < n_words; i++) {
+        random_word(buffer, min_length, max_length, alphabet_size, &seed);
+
+        words[i] = strdup(buffer);
+        TEST_ASSERT_NOT_NULL(words[i]);
+    }
+
+    free(buffer);
+
+    return words;
+}
+
+int linear_scan_closest(const char* query, char** words, int n_words, int* min_distance) {
+    int closest_index = -1;
+
+    for (int i = 0; i < n_words; i++) {
+        int distance = edit_distance_dyn(query, words[i]);
+
+        if (closest_index == -1 || distance < *min_distance) {
+            *min_distance = distance;
+            closest_index = i;
+        }
+    }
+
+    return closest_index;
+}
+
+void load_test_dictionary(DictionaryPtr dictionary, const char** words, int n_words) {
+    FILE* file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+
+    for (int i = 0; i < n_words; i++)
+        fprintf(file, "%s\n", words[i]);
+
+    rewind(file);
+    TEST_ASSERT_EQUAL_INT(n_words, load_dictionary(file, dictionary));
+
+    fclose(file);
+}
+
+void free_random_words(char** words, int n_words) {
+    for (int i = 0; i < n_words; i++)
+        free(words[i]);
+
+    free(words);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file test_utils.h
+ * @brief Helpers shared by the unit tests of the search engines.
+ *
+ * This file contains the declarations of the generator of the pseudo-random words the engines are compared
+ * on, of the linear scan they are checked against, and of the loading of a dictionary from a list of words. The words are drawn from a linear congruential generator, so that a seed always gives the same words.
+ */
+
+#ifndef _TEST_UTILS_H
+#define _TEST_UTILS_H
+
+#include "unity.h"
+#include "text_io.h"
+
+
+/**
+ * @brief Generates a pseudo-random word over the first letters of the alphabet.
+ *
+ * @param word Buffer receiving the word, of at least `max_length + 1` characters.
+ * @param min_length Minimum length of the word.
+ * @param max_length Maximum length of the word.
+ * @param alphabet_size Number of letters the word is made of, from 'a'.
+ * @param seed State of the generator, advanced past the word.
+ */
+void random_word(char* word, int min_length, int max_length, int alphabet_size, unsigned* seed);
+
+/**
+ * @brief Allocates an array of pseudo-random words generated by `random_word`.
+ *
+ * @param n_words Number of words.
+ * @param min_length Minimum length of the words.
+ * @param max_length Maximum length of the words.
+ * @param alphabet_size Number of letters the words are made of, from 'a'.
+ * @param seed Seed of the generator.
+ * @return The array of words, to be freed with `free_random_words`.
+ */
+char** create_random_words(int n_words, int min_length, int max_length, int alphabet_size, unsigned seed);
+
+/**
+ * @brief Finds the closest word of a list by computing its distance to every word, the oracle of the engines.
+ *
+ * @param query The word to look for.
+ * @param words Array of words, in dictionary order.
+ * @param n_words Number of words.
+ * @param min_distance Receives the edit distance between `query` and the closest word.
+ * @return The index of the first of the closest words, or -1 if there are no words.
+ */
+int linear_scan_closest(const char* query, char** words, int n_words, int* min_distance);
+
+/**
+ * @brief Loads a dictionary from a list of words, through a temporary file.
+ *
+ * @param dictionary Pointer to the dictionary to load.
+ * @param words Array of the words of the dictionary.
+ * @param n_words Number of words.
+ */
+void load_test_dictionary(DictionaryPtr dictionary, const char** words, int n_words);
+
+/**
+ * @brief Frees the words created by `create_random_words`.
+ *
+ * @param words Array of words.
+ * @param n_words Number of words.
+ */
+void free_random_words(char** words, int n_words);
+
+#endif // _TEST_UTILS_H